@@ -35,6 +35,7 @@ void bmi::Model::Update () {
 
   RunOneStorm ();
   MaskNodesBelowElevation (0);
+  FinishUpdate ();
 }
 
 void bmi::Model::UpdateUntil (double t) {
@@ -44,6 +45,7 @@ void bmi::Model::UpdateUntil (double t) {
   if (dt>0)
     Run (dt);
   MaskNodesBelowElevation (0);
+  FinishUpdate ();
 }
 
 void bmi::Model::Finalize () {
@@ -114,30 +116,49 @@ void bmi::Model::GetDouble(const char * var_name, double * const dest) {
       std::cout << "childInterface::GetValueSet() here with request '"
         << var_name << "'\n";
 
-    if (strcmp (var_name, "surface__elevation") == 0 ||
-        strcmp (var_name, "sea_floor__elevation") == 0) {
-      CopyNodeElevations (dest);
-    }
-    else if (strcmp (var_name, "surface__elevation_increment")==0) {
-      CopyNodeElevations (dest);
-    }
-    else if (strcmp (var_name, "sediment__erosion_rate")==0) {
-      CopyNodeErosion (dest);
-    }
-    else if (strcmp (var_name, "channel_water__discharge")==0) {
-      CopyNodeDischarge (dest);
-    }
-    else if (strcmp (var_name, "bed_load__mass_flow_rate")==0) {
-      CopyNodeSedimentFlux (dest);
-    }
-    else {
-      std::cerr << "Should not be reached!" << std::endl;
-      throw bmi::BAD_VAR_NAME;
-    }
+    CopyNodeBuffer (NodeBufferFor (var_name), dest);
   }
   return;
 }
 
+// Returns Child's own buffer for the variable, in order of permanent ID.
+// It is refreshed after every storm; elevations written into it are
+// used from the next Update on. The erosion buffer sums the erosion and
+// deposition of the whole Update or UpdateUntil. If the number of nodes
+// (GetVarPointCount) changes, the pointer is no longer valid and must
+// be asked for again.
+double * bmi::Model::GetDoublePtr (const char * var_name) {
+  CHECK_OR_THROW(HasOutputVar (var_name) || HasInputVar (var_name), bmi::BAD_VAR_NAME);
+
+  if (strcmp (var_name, "bedrock_surface__elevation_increment")==0)
+    throw bmi::FUNCTION_NOT_IMPLEMENTED;
+
+  return NodeBufferPtr (NodeBufferFor (var_name));
+}
+
+void bmi::Model::GetVarStride (const char * var_name, int * const stride) {
+  CHECK_OR_THROW(HasOutputVar (var_name) || HasInputVar (var_name), bmi::BAD_VAR_NAME);
+  stride[0] = 1;
+}
+
+Child::tNodeBuffer_t bmi::Model::NodeBufferFor (const char * var_name) {
+  if (strcmp (var_name, "surface__elevation") == 0 ||
+      strcmp (var_name, "sea_floor__elevation") == 0 ||
+      strcmp (var_name, "sea_floor_bedrock_surface__elevation") == 0 ||
+      strcmp (var_name, "bedrock_surface__elevation") == 0 ||
+      strcmp (var_name, "surface__elevation_increment") == 0)
+    return kElevationBuffer;
+  else if (strcmp (var_name, "sediment__erosion_rate")==0)
+    return kErosionBuffer;
+  else if (strcmp (var_name, "channel_water__discharge")==0)
+    return kDischargeBuffer;
+  else if (strcmp (var_name, "bed_load__mass_flow_rate")==0)
+    return kSedimentFluxBuffer;
+
+  std::cerr << "Should not be reached!" << std::endl;
+  throw bmi::BAD_VAR_NAME;
+}
+
 void bmi::Model::SetDouble (const char * var_name, double *vals) {
   if (VERBOSE)
     std::cout << "childInterface::set_double () here with request '"
@@ -107,18 +107,14 @@ class Model : public Child {
   // Variable getters
   void GetDouble (const char * var_name, double *);
   void GetDoubleAtIndices (const char *, double *, int *, int);
-  double * GetDoublePtr (const char * var_name) {
-    throw bmi::FUNCTION_NOT_IMPLEMENTED;
-  }
-  void GetVarStride (const char * var_name, int * const stride) {
-    throw bmi::FUNCTION_NOT_IMPLEMENTED;
-  }
+  double * GetDoublePtr (const char * var_name);
+  void GetVarStride (const char * var_name, int * const stride);
 
-  void GetValue (const char *, void *) {
-    throw bmi::FUNCTION_NOT_IMPLEMENTED;
+  void GetValue (const char * var_name, void * dest) {
+    GetDouble (var_name, static_cast<double *> (dest));
   }
   void *GetValuePtr (const char * var_name) {
-    throw bmi::FUNCTION_NOT_IMPLEMENTED;
+    return GetDoublePtr (var_name);
   }
   void GetValueAtIndices (const char *, void *, int *, int) {
     throw bmi::FUNCTION_NOT_IMPLEMENTED;
@@ -155,6 +151,7 @@ class Model : public Child {
   void GetGridOffset (const char *, int * const);
 
  private:
+  tNodeBuffer_t NodeBufferFor (const char * var_name);
   bool HasInputVar (const char * var_name);
   bool HasOutputVar (const char * var_name);
   void SetInputVarNames (const char **names);
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "child.h"
 
 #define VERBOSE (false)
@@ -193,6 +194,7 @@ void Child::Initialize (std::string argument_string) {
     output->WriteOutput( 0. );
   
   // Finish up initialization
+  ResetNodeBuffers();
   initialized = true;
   if( !option.silent_mode )
     std::cout << "******* Initialization done *******\n";
@@ -293,6 +295,7 @@ void Child::CleanUp() {
 		delete stratGrid;
 		stratGrid = NULL;
 	}
+	ResetNodeBuffers();
 	initialized = false;
 }
 
@@ -327,6 +330,12 @@ double Child::RunOneStorm() {
   if(0) //debug
     std::cout << "         " << std::endl;
   time->ReportTimeStatus();
+
+  // Take up any changes the caller made through the elevation buffer
+  ApplyElevationBuffer();
+  for( int i=0; i<kNumNodeBuffers; ++i )
+    node_buffer_fresh_[i] = false;
+  mesh->StartCheckMeshStep();
 	
   // Do storm...
   storm->GenerateStorm( time->getCurrentTime(),
@@ -563,7 +572,12 @@ double Child::RunOneStorm() {
   if( output > 0 && time->CheckOutputTime() )
     output->WriteOutput( time->getCurrentTime() );
 	
-  if( output > 0 && output->OptTSOutput() ) output->WriteTSOutput();
+  if( output > 0 && output->OptTSOutput() ) output->WriteTSOutput( time->getCurrentTime() );
+
+  // Buffers handed out to the caller are kept up to date
+  for( int i=0; i<kNumNodeBuffers; ++i )
+    if( node_buffer_exported_[i] )
+      RefreshNodeBuffer( static_cast<tNodeBuffer_t>(i) );
   
   return( time->getCurrentTime() );
 }
@@ -676,6 +690,17 @@ void Child::SetNodeElevations (const double * elevations) {
                   << std::endl;
       current_node->setZ (elevations[current_node->getPermID ()]);
    }
+
+   // The elevation buffer now holds the new values; if they were set
+   // from the buffer itself, there is nothing to copy.
+   std::vector<double> &buffer = node_buffer_[kElevationBuffer];
+   const size_t n = mesh->getNodeList ()->getSize ();
+   if (buffer.empty () || elevations != &buffer[0])
+   {
+     ResizeNodeBuffer (kElevationBuffer, n);
+     std::copy (elevations, elevations + n, buffer.begin ());
+   }
+   node_buffer_fresh_[kElevationBuffer] = true;
 }
 
 void Child::SetNodeUplift (const double * uplift) {
@@ -691,5 +716,151 @@ void Child::SetNodeUplift (const double * uplift) {
                       << std::endl;
       current_node->ChangeZ (uplift[current_node->getPermID()]);
    }
+
+   if (node_buffer_exported_[kElevationBuffer])
+     RefreshNodeBuffer (kElevationBuffer);
+   else
+     node_buffer_fresh_[kElevationBuffer] = false;
+}
+
+/**************************************************************************/
+/**
+**  Child::NodeBufferPtr
+**
+**  Returns a pointer to a buffer holding the values of a node variable
+**  in order of permanent ID, so that a coupled model can read them
+**  without a copy. The buffer belongs to Child. Once its pointer has been
+**  handed out, it is refreshed at the end of every storm; otherwise it
+**  is refreshed only when next asked for. Elevations written into the
+**  elevation buffer are given to the nodes at the start of the next
+**  storm (or straight away, by passing the buffer to SetNodeElevations).
+**
+**  The pointer stays valid for as long as the number of nodes does not
+**  change. When the mesh gains or loses nodes, the buffer is given new
+**  storage of the new size, the old pointer must no longer be used, and
+**  Child stops refreshing the buffer and reading elevations from it
+**  until NodeBufferPtr is called again.
+**
+**  The erosion buffer holds the erosion and deposition since the last
+**  call to FinishUpdate, i.e. over the current (or, between calls, the
+**  last) coupler update, however many storms it takes.
+*/
+/**************************************************************************/
+double * Child::NodeBufferPtr (tNodeBuffer_t which)
+{
+  if (!node_buffer_fresh_[which])
+    RefreshNodeBuffer (which);
+  node_buffer_exported_[which] = true;
+  return &node_buffer_[which][0];
+}
+
+/**************************************************************************/
+/**
+**  Child::CopyNodeBuffer
+**
+**  Copies the values of a node variable, in order of permanent ID, into
+**  dest, refreshing the buffer first if the nodes have changed since.
+*/
+/**************************************************************************/
+void Child::CopyNodeBuffer (tNodeBuffer_t which, double * const dest)
+{
+  if (!node_buffer_fresh_[which])
+    RefreshNodeBuffer (which);
+  std::copy (node_buffer_[which].begin (), node_buffer_[which].end (), dest);
+}
+
+/**************************************************************************/
+/**
+**  Child::FinishUpdate
+**
+**  Called when a coupler's update returns: brings the erosion buffer up
+**  to date, so that it holds the erosion and deposition of the whole
+**  update, and starts the next interval by resetting each node's
+**  cumulative erosion and deposition.
+*/
+/**************************************************************************/
+void Child::FinishUpdate ()
+{
+  RefreshNodeBuffer (kErosionBuffer);
+
+  tMesh<tLNode>::nodeListIter_t ni (mesh->getNodeList());
+  for (tLNode *current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP())
+    current_node->ResetCumulativeEroDep ();
+}
+
+void Child::RefreshNodeBuffer (tNodeBuffer_t which)
+{
+  std::vector<double> &buffer = node_buffer_[which];
+  ResizeNodeBuffer (which, mesh->getNodeList ()->getSize ());
+  if (buffer.empty ()) return;
+  switch (which)
+  {
+    case kElevationBuffer: CopyNodeElevations (&buffer[0]); break;
+    case kErosionBuffer:
+    {
+      // Nodes are reset only by FinishUpdate, so this sums the storms
+      tMesh<tLNode>::nodeListIter_t ni (mesh->getNodeList());
+      for (tLNode *cn=ni.FirstP(); !ni.AtEnd(); cn=ni.NextP())
+        buffer[cn->getPermID ()] = cn->getCumulativeEroDep ();
+      break;
+    }
+    case kDischargeBuffer: CopyNodeDischarge (&buffer[0]); break;
+    case kSedimentFluxBuffer: CopyNodeSedimentFlux (&buffer[0]); break;
+    default: break;
+  }
+  node_buffer_fresh_[which] = true;
+}
+
+/**************************************************************************/
+/**
+**  Child::ResizeNodeBuffer
+**
+**  Gives a buffer room for n nodes. A change of size moves the buffer,
+**  so a pointer handed out for it is withdrawn: the buffer is no longer
+**  refreshed after each storm nor read for elevations until the caller
+**  asks for it again (see NodeBufferPtr).
+*/
+/**************************************************************************/
+void Child::ResizeNodeBuffer (tNodeBuffer_t which, size_t n)
+{
+  if (node_buffer_[which].size () == n) return;
+  node_buffer_exported_[which] = false;
+  std::vector<double> (n).swap (node_buffer_[which]);
+}
+
+void Child::ResetNodeBuffers ()
+{
+  for (int i=0; i<kNumNodeBuffers; ++i)
+  {
+    std::vector<double>().swap (node_buffer_[i]);
+    node_buffer_fresh_[i] = false;
+    node_buffer_exported_[i] = false;
+  }
+}
+
+/**************************************************************************/
+/**
+**  Child::ApplyElevationBuffer
+**
+**  Gives the nodes any elevations the caller changed through the
+**  pointer returned by NodeBufferPtr. Nodes whose value is unchanged
+**  are left alone.
+*/
+/**************************************************************************/
+void Child::ApplyElevationBuffer ()
+{
+  std::vector<double> const &buffer = node_buffer_[kElevationBuffer];
+  if (!node_buffer_exported_[kElevationBuffer] ||
+      !node_buffer_fresh_[kElevationBuffer] ||
+      buffer.size () != static_cast<size_t>(mesh->getNodeList ()->getSize ()))
+    return;
+
+  tMesh<tLNode>::nodeListIter_t ni (mesh->getNodeList());
+  for (tLNode *current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP())
+  {
+    const double z = buffer[current_node->getPermID ()];
+    if (z != current_node->getZ ())
+      current_node->setZ (z);
+  }
 }
 
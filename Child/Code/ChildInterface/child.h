@@ -27,6 +27,18 @@ class Child {
     void CopyNodeSedimentFlux (double * const dest);
     void SetNodeElevations (const double * src);
     void SetNodeUplift (const double * src);
+
+    // Persistent node-ordered buffers, for access without a copy
+    typedef enum {
+      kElevationBuffer = 0,
+      kErosionBuffer,
+      kDischargeBuffer,
+      kSedimentFluxBuffer,
+      kNumNodeBuffers
+    } tNodeBuffer_t;
+    double * NodeBufferPtr (tNodeBuffer_t which);  // refreshed buffer
+    void CopyNodeBuffer (tNodeBuffer_t which, double * const dest);
+    void FinishUpdate ();  // closes the erosion buffer's interval
   
     bool initialized;      // Flag indicated whether model has been initialized
     bool optNoDiffusion,   // Option to turn off diffusive processes (default to false)
@@ -65,6 +77,16 @@ class Child {
          tStratGrid *stratGrid;     // -> Stratigraphy Grid object
          tEolian *loess;           // -> eolian deposition object
          tStreamMeander *strmMeander; // -> stream meander object
+
+  private:
+    void ResetNodeBuffers ();
+    void RefreshNodeBuffer (tNodeBuffer_t which);
+    void ResizeNodeBuffer (tNodeBuffer_t which, size_t n);
+    void ApplyElevationBuffer ();
+
+    std::vector<double> node_buffer_[kNumNodeBuffers];  // by permanent ID
+    bool node_buffer_fresh_[kNumNodeBuffers];     // matches the nodes
+    bool node_buffer_exported_[kNumNodeBuffers];  // pointer handed out
 };
 
 #endif
@@ -20,7 +20,10 @@
 
 int main( int argc, char **argv )
 {
-  std::srand(std::time(0));
+  // Under mpirun, the processes share out some of the work (see
+  // tBasinFarm); they must all draw the same random numbers
+  tBasinFarm::Initialize( &argc, &argv );
+  std::srand( tBasinFarm::CommonSeed( std::time(0) ) );
 	childInterface myChildInterface;
 	
 	myChildInterface.Initialize( argc, argv );
@@ -48,5 +51,6 @@ int main( int argc, char **argv )
 	// memory)
 	myChildInterface.CleanUp();
 	
+  tBasinFarm::Finalize();
 	return 0;
 }
@@ -0,0 +1,25 @@
+/**************************************************************************/
+/**
+**  childEnsembleDriver.cpp: runs an ensemble of realizations of the
+**  model described by an input file, in one process (see tEnsemble).
+**
+**  Usage: childEnsemble <input file>
+**
+**  Created 10/2026
+*/
+/**************************************************************************/
+
+#include <iostream>
+#include "../tEnsemble/tEnsemble.h"
+
+int main( int argc, char **argv )
+{
+  if( argc != 2 )
+  {
+    std::cerr << "Usage: " << argv[0] << " <input file>" << std::endl;
+    return 1;
+  }
+  tEnsemble ensemble( argv[1] );
+  ensemble.Run();
+  return 0;
+}
@@ -17,7 +17,11 @@
  */
 /**************************************************************************/
 
+#include <algorithm>
 #include "childInterface.h"
+#ifdef __GLIBC__
+# include <malloc.h>  // for malloc_trim
+#endif
 
 using namespace std;
 
@@ -31,7 +35,9 @@ Predicates predicate;
  */
 /**************************************************************************/
 childInterface::
-childInterface() : element_set_id("CHILD_node_element_set"), 
+childInterface() : nodes_by_permid_mesh_(0),
+nodes_by_permid_version_(0),
+element_set_id("CHILD_node_element_set"), 
 element_set_description( "Element set interface for CHILD's voronoi nodes" ),
 version(0)
 {
@@ -50,6 +56,7 @@ version(0)
 	stratGrid = NULL;
 	loess = NULL;
 	strmMeander = NULL;
+	stateHash = NULL;
 }
 
 
@@ -117,6 +124,11 @@ update( double dt )
  **  parameter values may then be changed, e.g., in a Monte Carlo 
  **  optimization.
  **
+ **  The layer lists of the nodes are not copied but shared with the
+ **  original until either model changes them (see tSharedList), so
+ **  copying a model with deep stratigraphy is no slower than copying one
+ **  without; the mesh itself is still copied in full.
+ **
  **  SL, 10/2010
  */
 /**************************************************************************/
@@ -142,7 +154,16 @@ void childInterface::Initialize_Copy( const childInterface& orig )
   opt3DLandslides = orig.opt3DLandslides;
   optChemicalWeathering = orig.optChemicalWeathering;
   optPhysicalWeathering = orig.optPhysicalWeathering;
+  optMeshCoarsen = orig.optMeshCoarsen;
+  optMemoryReport = orig.optMemoryReport;
+  optLayerCompaction = orig.optLayerCompaction;
+  nLayersMerged = orig.nLayersMerged;
+  silentMode = orig.silentMode;
+  nStorms = orig.nStorms;
   optStreamLineBoundary = orig.optStreamLineBoundary;
+  exchange_sets_ = orig.exchange_sets_;
+  nodes_by_permid_.clear();
+  nodes_by_permid_mesh_ = 0;
   
   if( orig.rand )
     rand = new tRand( *orig.rand );
@@ -152,6 +173,7 @@ void childInterface::Initialize_Copy( const childInterface& orig )
   output = 0;
   //   if( orig.output )
   //     output = new tLOutput<tLNode>( *orig.output );
+  stateHash = 0;  // nor is the state hash log
   if( orig.storm )
   {
     storm = new tStorm( *orig.storm );
@@ -212,6 +234,26 @@ void childInterface::Initialize_Copy( const childInterface& orig )
   
 }
 
+/**************************************************************************/
+/**
+ **  Fork
+ **
+ **  Returns a new childInterface that carries on from the present state
+ **  of this one (see Initialize_Copy), for example to try out several
+ **  parameter values or random sequences from a spun-up landscape in the
+ **  same process. The copy writes no output until setWriteOption is
+ **  called for it, and is to be deleted by the caller.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+childInterface *childInterface::Fork() const
+{
+  childInterface *copy = new childInterface;
+  copy->Initialize_Copy( *this );
+  return copy;
+}
+
 /**************************************************************************/
 /**
  **  Initialize
@@ -245,6 +287,15 @@ Initialize( std::string argument_string )
   // Check command-line arguments
   tOption option( argument_string );
   
+  // Of several MPI processes running the model, only the first writes
+  // (see tBasinFarm)
+  if( tBasinFarm::Rank() != 0 )
+  {
+    option.silent_mode = true;
+    option.no_write_mode = true;
+  }
+  silentMode = option.silent_mode;
+  
   // Say hello
   option.version();
   
@@ -271,6 +322,11 @@ Initialize( std::string argument_string )
   opt3DLandslides = inputFile.ReadBool( "OPT_3D_LANDSLIDES", false );
   optChemicalWeathering = inputFile.ReadBool( "CHEM_WEATHERING_LAW", false );
   optPhysicalWeathering = inputFile.ReadBool( "PRODUCTION_LAW", false );
+  optMeshCoarsen = inputFile.ReadBool( "OPTMESHCOARSEN", false );
+  optMemoryReport = inputFile.ReadBool( "OPT_MEMORY_REPORT", false );
+  optLayerCompaction = inputFile.ReadBool( "OPT_LAYER_COMPACTION", false );
+  nLayersMerged = 0;
+  nStorms = 0;
   optTrackWaterSedTimeSeries = 
   inputFile.ReadBool( "OPT_TRACK_WATER_SED_TIMESERIES", false );
   
@@ -288,6 +344,15 @@ Initialize( std::string argument_string )
   // Initialize the lithology manager
   lithology_manager_.InitializeFromInputFile( inputFile, mesh );
   
+  // Compact the initial layers, including any the lithology manager made
+  if( optLayerCompaction )
+  {
+    tLNode::ReadLayerCompaction( inputFile );
+    tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+    for( tLNode *cn = ni.FirstP(); !ni.AtEnd(); cn = ni.NextP() )
+      cn->ApplyLayerCompaction( true );
+  }
+  
   // Create and initialize output object
   if( !option.no_write_mode )
   {
@@ -397,11 +462,23 @@ Initialize( std::string argument_string )
     erosion->ActivateSedVolumeTracking( &water_sed_tracker_ );
   }
   
+  // If applicable, log digests of the model state (see tStateHash)
+  if( tBasinFarm::Rank() == 0 && tStateHashLog::Requested( inputFile ) )
+  {
+    stateHash = new tStateHashLog( inputFile );
+    StateHashCheckpoint( "initial" );
+  }
+  
   // Write output for time zero
   if( !option.silent_mode )
     std::cout << "Writing data for time zero...\n";
   if( output )
+  {
     output->WriteOutput( 0. );
+    if( optMemoryReport ) WriteMemoryLogLine();
+  }
+  else if( tBasinFarm::Size() > 1 )
+    mesh->RenumberIDCanonically();  // keep IDs in step with rank 0
   
   // Finish up initialization
   initialized = true;
@@ -592,6 +669,54 @@ VaryParameters( const tInputFile &optFile, const double &delta,
 }
 
 
+/**************************************************************************/
+/**
+ **  SetParameter
+ **
+ **  Sets the value of a parameter, given by its input-file keyword, in
+ **  an initialized model, e.g. in one member of an ensemble (see
+ **  tEnsemble). Returns false if the keyword is not one of those that
+ **  can be changed this way, or if the object it belongs to doesn't
+ **  exist. Parameters that are time series (ST_PMEAN, KD, UPRATE) become
+ **  constant. SEED restarts the model's random number generator.
+ **  SOILBULKDENSITY cannot be set: new layers take their density from
+ **  tLNode::new_sed_bulk_density_, which all models in the process share.
+ **
+ **  As with VaryParameters, a parameter has to be added here "by hand",
+ **  with a "set" function in the object it belongs to.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+bool childInterface::
+SetParameter( string keyword, double value )
+{
+  if( keyword == "SEED" && rand )
+    rand->init( static_cast<long>( value ) );
+  else if( keyword == "ST_PMEAN" && storm )
+    storm->setRainrate( value );
+  else if( keyword == "INFILTRATION" && strmNet )
+    strmNet->setInfilt( value );
+  else if( keyword == "KD" && erosion )
+    erosion->setKd( value );
+  else if( keyword == "DIFFDEPTHSCALE" && erosion )
+    erosion->setDiffusionH( value );
+  else if( keyword == "FRICSLOPE" && erosion )
+    erosion->setFricSlope( value );
+  else if( keyword == "UPRATE" && uplift )
+    uplift->setRate( value );
+  else if( keyword == "REGINIT" && mesh )
+  {
+    tMesh<tLNode>::nodeListIter_t nI( mesh->getNodeList() );
+    for( tLNode* cn = nI.FirstP(); nI.IsActive(); cn = nI.NextP() )
+      cn->setLayerDepth( 0, value );
+  }
+  else
+    return false;
+  return true;
+}
+
+
 /**************************************************************************/
 /**
  **  RunOneStorm
@@ -605,6 +730,7 @@ double childInterface::
 RunOneStorm()
 {
   double stormDuration, stormPlusDryDuration;
+  const bool hashDue = stateHash && stateHash->Due( ++nStorms );
 	
   /**************** Run 1 storm ****************************************\
    **  ALGORITHM
@@ -626,9 +752,14 @@ RunOneStorm()
     std::cout << "         " << std::endl;
   time->ReportTimeStatus();
 	
+  // Restore Hilbert order of mesh lists after large topology changes
+  mesh->ReorderIfNecessary();
+  mesh->StartCheckMeshStep();
+	
   // Do storm...
   storm->GenerateStorm( time->getCurrentTime(),
                     mesh,strmNet->getInfilt(), strmNet->getSoilStore() ); // add: mesh
+  if( hashDue ) StateHashCheckpoint( "storm" );
 
 						   
   stormDuration = min( storm->getStormDuration(), time->RemainingTime() );
@@ -648,6 +779,7 @@ RunOneStorm()
   // calculated:
   if( !optNoFluvial || optLandslides)
     strmNet->UpdateNet( time->getCurrentTime(), *storm );
+  if( hashDue ) StateHashCheckpoint( "hydrology" );
   if(0) //DEBUG
     std::cout << "UpdateNet::Done.." << std::endl;
 	
@@ -747,6 +879,7 @@ RunOneStorm()
                                    stormPlusDryDuration - stormDuration );
   }
 #undef NEWVEG
+  if( hashDue ) StateHashCheckpoint( "hillslope" );
   
   //-------------FLUVIAL------------------------------------------
   if(0) std::cout << "Calculating fluvial erosion and transport ...\n" << std::flush;
@@ -776,6 +909,7 @@ RunOneStorm()
                                  time->getCurrentTime() );
   }
   
+  if( hashDue ) StateHashCheckpoint( "fluvial" );
   if(0) //DEBUG
     std::cout << "Erosion::Done.." << std::flush;
 	
@@ -843,6 +977,17 @@ RunOneStorm()
   // 		       optDiffuseDepo );
 	
   erosion->UpdateExposureTime( stormPlusDryDuration );
+  if( hashDue ) StateHashCheckpoint( "channels" );
+	
+  //----------------MESH COARSENING---------------------------
+  // Remove nodes where the landscape is quiescent, then update the
+  // network for the new mesh
+  if( optMeshCoarsen )
+  {
+    erosion->CoarsenMesh( strmNet );
+    strmNet->UpdateNet( time->getCurrentTime() );
+    if( hashDue ) StateHashCheckpoint( "mesh" );
+  }
 	
   //----------------EOLIAN------------------------------------
   if( optLoessDep )
@@ -858,6 +1003,16 @@ RunOneStorm()
                        stormPlusDryDuration, 
                        time->getCurrentTime() );
   }
+  if( hashDue ) StateHashCheckpoint( "uplift" );
+  
+  //----------------LAYER COMPACTION--------------------------
+  if( optLayerCompaction )
+  {
+    tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+    for( tLNode *cn = ni.FirstP(); !ni.AtEnd(); cn = ni.NextP() )
+      nLayersMerged += cn->ApplyLayerCompaction();
+    if( hashDue ) StateHashCheckpoint( "compaction" );
+  }
   
   if( optTrackWaterSedTimeSeries && water_sed_tracker_.IsActive() )
     water_sed_tracker_.WriteAndResetWaterSedTimeseriesData( time->getCurrentTime(),
@@ -866,9 +1021,21 @@ RunOneStorm()
   time->Advance( stormPlusDryDuration );
 	
   if( output > 0 && time->CheckOutputTime() )
+  {
     output->WriteOutput( time->getCurrentTime() );
+    if( optMemoryReport ) WriteMemoryLogLine();
+    if( optLayerCompaction )
+    {
+      if( !silentMode )
+        std::cout << "Layer compaction: " << nLayersMerged
+                  << " layers merged since last output\n";
+      nLayersMerged = 0;
+    }
+  }
+  else if( output == 0 && tBasinFarm::Size() > 1 && time->CheckOutputTime() )
+    mesh->RenumberIDCanonically();  // keep IDs in step with rank 0
 	
-  if( output > 0 && output->OptTSOutput() ) output->WriteTSOutput();
+  if( output > 0 && output->OptTSOutput() ) output->WriteTSOutput( time->getCurrentTime() );
   
   return( time->getCurrentTime() );
 }
@@ -896,7 +1063,10 @@ Run( double run_duration )
   
   while( !time->IsFinished() )
 		RunOneStorm();
-  
+
+  // how often the geometric predicates needed exact arithmetic:
+  if( !silentMode )
+    predicate.ReportCounters();
 }
 
 
@@ -919,6 +1089,8 @@ CleanUp()
 	}
 	if( mesh ) {
 		delete mesh;
+		nodes_by_permid_.clear();
+		nodes_by_permid_mesh_ = 0;
 		mesh = NULL;
 	}
 	if( output ) {
@@ -974,6 +1146,10 @@ CleanUp()
 		delete stratGrid;
 		stratGrid = NULL;
 	}
+	if( stateHash ) {
+		delete stateHash;
+		stateHash = NULL;
+	}
 	initialized = false;
 }
 
@@ -1421,46 +1597,46 @@ GetRemainingRunTime()
 std::vector<double> childInterface::
 GetValueSet( string var_name )
 {
-  if(1) std::cout << "childInterface::GetValueSet() here with request '"
+  if(0) std::cout << "childInterface::GetValueSet() here with request '"
 		<< var_name << "'\n";
   if( var_name.compare( 0,4,"elev" )==0 )
   {
-    if(1) std::cout << "request for elevs\n";
+    if(0) std::cout << "request for elevs\n";
     return GetNodeElevationVector();
   }
   if( var_name.compare( 0,1,"x" )==0 || var_name.compare( 0,5,"nodex" )==0)
   {
-    if(1) std::cout << "request for node x coordinates\n";
+    if(0) std::cout << "request for node x coordinates\n";
     return GetNodeXCoords();
   }
   if( var_name.compare( 0,1,"y" )==0 || var_name.compare( 0,5,"nodey" )==0)
   {
-    if(1) std::cout << "request for node y coordinates\n";
+    if(0) std::cout << "request for node y coordinates\n";
     return GetNodeYCoords();
   }
   else if( var_name.compare( 0,2,"dz" )==0 || var_name.compare( 0,3,"ero" )==0 )
   {
-    if(1) std::cout << "request for dz\n";
+    if(0) std::cout << "request for dz\n";
     return GetNodeErosionVector();
   }
   else if( var_name.compare( 0,5,"disch" )==0 || var_name.compare( 0,5,"water" )==0 )
   {
-    if(1) std::cout << "request for Q\n";
+    if(0) std::cout << "request for Q\n";
     return GetNodeDischargeVector();
   }
   else if( var_name.compare( 0,3,"sed" )==0 )
   {
-    if(1) std::cout << "request for Qs\n";
+    if(0) std::cout << "request for Qs\n";
     return GetNodeSedimentFluxVector();
   }
   else if( var_name.compare( 0,4,"land" )==0 )
 	{
-		if(1) std::cout << "request for landslides\n";
+		if(0) std::cout << "request for landslides\n";
 		return GetLandslideAreasVector();
 	}
   else if( var_name.compare( 0,4,"load" )==0 )
 	{
-		if(1) std::cout << "request for loads\n";
+		if(0) std::cout << "request for loads\n";
 		return GetLoads();
 	}
   else
@@ -1492,7 +1668,7 @@ GetNodeElevationVector()
   
   for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
   {
-    if(1) std::cout << "node " << current_node->getPermID()
+    if(0) std::cout << "node " << current_node->getPermID()
       << " z=" << current_node->getZ() << std::endl;
     elevations[current_node->getPermID()] = current_node->getZ();
   }
@@ -1551,7 +1727,7 @@ GetNodeDischargeVector()
   
   for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
   {
-    if(1) std::cout << "NOde " << current_node->getPermID()
+    if(0) std::cout << "NOde " << current_node->getPermID()
       << " Q=" << current_node->getQ() << std::endl;
     discharge[current_node->getPermID()] = current_node->getQ();
   }
@@ -1582,7 +1758,7 @@ GetNodeSedimentFluxVector()
   
   for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
   {
-    if(1) std::cout << "noDE " << current_node->getPermID()
+    if(0) std::cout << "noDE " << current_node->getPermID()
       << " Qs=" << current_node->getQs() << std::endl;
     sedflux[current_node->getPermID()] = current_node->getQs();
   }
@@ -1633,16 +1809,16 @@ std::vector<double> childInterface::GetLandslideAreasVector()
 void childInterface::
 SetValueSet( string var_name, std::vector<double> value_set )
 {
-  if(1) std::cout << "childInterface::SetValueSet() here with request '"
+  if(0) std::cout << "childInterface::SetValueSet() here with request '"
     << var_name << "'\n";
   if( var_name.compare( 0,4,"elev" )==0 )
   {
-    if(1) std::cout << "request to set elevs\n";
+    if(0) std::cout << "request to set elevs\n";
     SetNodeElevations( value_set );
   }
   else if( var_name.compare( 0,2,"kr")==0 || var_name.compare( 0,2,"KR" )==0 )
   {
-    if(1) std::cout << "request to set KR\n";
+    if(0) std::cout << "request to set KR\n";
     lithology_manager_.SetRockErodibilityValuesAtAllDepths( value_set );
   }
   else
@@ -1652,6 +1828,174 @@ SetValueSet( string var_name, std::vector<double> value_set )
   }
 }
 
+/**************************************************************************/
+/**
+ **  childInterface::RegisterExchangeSet
+ **
+ **  Registers a set of node variables to be exchanged together with a
+ **  coupled model by GetExchangeValues and SetExchangeValues, and returns
+ **  the number by which to refer to it. The names are matched as in
+ **  GetValueSet: "elev", "dz"/"ero", "disch"/"water", "sed", "x"/"nodex"
+ **  and "y"/"nodey". This is done once, so the exchange itself involves
+ **  no string matching.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+int childInterface::
+RegisterExchangeSet( std::vector<string> const & var_names )
+{
+  std::vector<tExchangeVar_t> vars;
+  for( size_t i=0; i<var_names.size(); ++i )
+  {
+    string const & var_name = var_names[i];
+    if( var_name.compare( 0,4,"elev" )==0 )
+      vars.push_back( kExchElevation );
+    else if( var_name.compare( 0,2,"dz" )==0 || var_name.compare( 0,3,"ero" )==0 )
+      vars.push_back( kExchErosion );
+    else if( var_name.compare( 0,5,"disch" )==0 || var_name.compare( 0,5,"water" )==0 )
+      vars.push_back( kExchDischarge );
+    else if( var_name.compare( 0,3,"sed" )==0 )
+      vars.push_back( kExchSedFlux );
+    else if( var_name.compare( 0,1,"x" )==0 || var_name.compare( 0,5,"nodex" )==0 )
+      vars.push_back( kExchX );
+    else if( var_name.compare( 0,1,"y" )==0 || var_name.compare( 0,5,"nodey" )==0 )
+      vars.push_back( kExchY );
+    else
+    {
+      std::cerr << "Unrecognized exchange variable '" << var_name << "'\n";
+      ReportFatalError( "RegisterExchangeSet: unknown variable name." );
+    }
+  }
+  exchange_sets_.push_back( vars );
+  return static_cast<int>( exchange_sets_.size() ) - 1;
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::GetExchangeValues
+ **
+ **  Fills dest with the values of every variable of a registered set, in
+ **  one pass over the nodes. dest holds one block of GetNodeCount()
+ **  values per variable, in the order the variables were registered,
+ **  each in order of permanent ID. As with GetValueSet("ero"), the
+ **  cumulative erosion/deposition is reset once read.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+void childInterface::
+GetExchangeValues( int set_id, double * dest )
+{
+  if( set_id<0 || set_id>=static_cast<int>( exchange_sets_.size() ) )
+    ReportFatalError( "Exchange set was not registered with RegisterExchangeSet." );
+  std::vector<tExchangeVar_t> const & vars = exchange_sets_[set_id];
+  std::vector<tLNode *> const & nodes = NodesByPermID();
+  const size_t n = nodes.size();
+
+  for( size_t id=0; id<n; ++id )
+  {
+    tLNode * const cn = nodes[id];
+    double *p = dest + id;
+    for( size_t v=0; v<vars.size(); ++v, p+=n )
+    {
+      switch( vars[v] )
+      {
+        case kExchElevation: *p = cn->getZ(); break;
+        case kExchErosion:
+          *p = cn->getCumulativeEroDep();
+          cn->ResetCumulativeEroDep();
+          break;
+        case kExchDischarge: *p = cn->getQ(); break;
+        case kExchSedFlux: *p = cn->getQs(); break;
+        case kExchX: *p = cn->getX(); break;
+        case kExchY: *p = cn->getY(); break;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::SetExchangeValues
+ **
+ **  Gives the nodes the values in src, laid out as for GetExchangeValues,
+ **  in one pass. Elevations are set at every node, as in SetValueSet;
+ **  erosion/deposition depths are applied with EroDep at interior nodes
+ **  only, as in ExternalErosionAndDeposition. The blocks of variables
+ **  that cannot be set are skipped, so that the same set can be used in
+ **  both directions.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+void childInterface::
+SetExchangeValues( int set_id, const double * src )
+{
+  if( set_id<0 || set_id>=static_cast<int>( exchange_sets_.size() ) )
+    ReportFatalError( "Exchange set was not registered with RegisterExchangeSet." );
+  std::vector<tExchangeVar_t> const & vars = exchange_sets_[set_id];
+  std::vector<tLNode *> const & nodes = NodesByPermID();
+  const size_t n = nodes.size();
+
+  for( size_t id=0; id<n; ++id )
+  {
+    tLNode * const cn = nodes[id];
+    const double *p = src + id;
+    for( size_t v=0; v<vars.size(); ++v, p+=n )
+    {
+      switch( vars[v] )
+      {
+        case kExchElevation: cn->setZ( *p ); break;
+        case kExchErosion:
+          if( cn->getBoundaryFlag()==kNonBoundary )
+            cn->EroDep( *p );
+          break;
+        default: break;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::NodesByPermID
+ **
+ **  Returns a table of the nodes, indexed by permanent ID, for the
+ **  exchange functions. The table is kept between calls and is only made
+ **  again when nodes have been added to or deleted from the mesh, or the
+ **  mesh itself has been replaced. Like the rest of the interface, it
+ **  assumes the permanent IDs run from 0 to the number of nodes - 1, and
+ **  stops the run if they do not.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+std::vector<tLNode *> const & childInterface::NodesByPermID()
+{
+  const size_t n = mesh->getNodeList()->getSize();
+  if( nodes_by_permid_mesh_ != mesh || nodes_by_permid_.size() != n
+      || nodes_by_permid_version_ != mesh->getNodeListVersion() )
+  {
+    nodes_by_permid_.assign( n, static_cast<tLNode *>(0) );
+    tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
+    for( tLNode *cn=ni.FirstP(); !ni.AtEnd(); cn=ni.NextP() )
+    {
+      const int id = cn->getPermID();
+      if( id<0 || static_cast<size_t>( id )>=n || nodes_by_permid_[id] )
+      {
+        std::cerr << "Node permanent ID " << id << " is out of range 0 to "
+                  << n-1 << " or repeated\n";
+        ReportFatalError( "Node permanent IDs must run from 0 to the number of nodes - 1." );
+      }
+      nodes_by_permid_[id] = cn;
+    }
+    nodes_by_permid_mesh_ = mesh;
+    nodes_by_permid_version_ = mesh->getNodeListVersion();
+  }
+  return nodes_by_permid_;
+}
+
 /**************************************************************************/
 /**
  **  childInterface::setWriteOption( bool )
@@ -1771,9 +2115,150 @@ void childInterface::ChangeOption( string option, int val )
     optPhysicalWeathering = ( val > 0 );
   if( option.compare( 0,6,"stream" )==0 )
     optStreamLineBoundary = ( val > 0 );
+  if( option.compare( 0,6,"memory" )==0 )
+    optMemoryReport = ( val > 0 );
   
 }
 
+/**************************************************************************/
+/**
+ **  childInterface::MemoryFootprint
+ **
+ **  Fills in mf with the memory held by the model, by subsystem: mesh
+ **  elements, node layers and arrays, vegetation and the stratigraphy
+ **  grid (see tMemoryFootprint). Smaller objects (storm, uplift, etc.)
+ **  are left out.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+void childInterface::MemoryFootprint( tMemoryFootprint &mf ) const
+{
+  mf.Reset();
+  if( mesh )
+    mesh->AddMemoryFootprint( mf );
+  if( vegetation )
+  {
+    mf.AddBlock( tMemoryFootprint::kVegetation, sizeof( tVegetation ) );
+    if( vegetation->FirePtr() )
+      mf.AddBlock( tMemoryFootprint::kVegetation, sizeof( tFire ) );
+    if( vegetation->ForestPtr() )
+      mf.AddBlock( tMemoryFootprint::kVegetation, sizeof( tForest ) );
+  }
+  if( stratGrid )
+    stratGrid->AddMemoryFootprint( mf );
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::CompactMemory
+ **
+ **  Releases memory in the middle of a run: merges redundant layers
+ **  thinner than thinLayerDepth at each node (tLNode::CompactLayers),
+ **  then hands the heap memory freed so far back to the operating
+ **  system where the C library allows it. Returns the number of layers
+ **  merged away; compare MemoryFootprint before and after to see the
+ **  memory saved.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+long childInterface::CompactMemory( double thinLayerDepth )
+{
+  long nmerged = 0;
+  if( !initialized ) return 0;
+  tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+  for( tLNode *cn = ni.FirstP(); !ni.AtEnd(); cn = ni.NextP() )
+    nmerged += cn->CompactLayers( thinLayerDepth );
+#ifdef __GLIBC__
+  malloc_trim( 0 );
+#endif
+  return nmerged;
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::WriteMemoryLogLine
+ **
+ **  Writes the memory footprint to the run log (OPT_MEMORY_REPORT).
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+void childInterface::WriteMemoryLogLine() const
+{
+  tMemoryFootprint mf;
+  MemoryFootprint( mf );
+  mf.WriteLogLine( std::cout, time->getCurrentTime() );
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::StateHashCheckpoint
+ **
+ **  Takes the digests of the model state after the given phase of the
+ **  current storm, and passes them to the state hash log (see
+ **  tStateHash.h). The nodes are taken in order of permanent ID, so that
+ **  the digests do not depend on the order of the node list.
+ **
+ **  Created: 10/2026
+ */
+/**************************************************************************/
+namespace
+{
+  bool LessPermID( tLNode const *a, tLNode const *b )
+  {
+    return a->getPermID() < b->getPermID();
+  }
+}
+
+void childInterface::StateHashCheckpoint( const char *phase )
+{
+  std::vector< tLNode const * > nodes;
+  nodes.reserve( mesh->getNodeList()->getSize() );
+  tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+  for( tLNode *cn = ni.FirstP(); !ni.AtEnd(); cn = ni.NextP() )
+    nodes.push_back( cn );
+  std::sort( nodes.begin(), nodes.end(), LessPermID );
+
+  tStateHash digests[tStateHashLog::kNumParts];
+  std::vector< double > layer;
+  digests[tStateHashLog::kCoords].Add( static_cast< long >( nodes.size() ) );
+  for( size_t i=0; i<nodes.size(); ++i )
+  {
+    tLNode const *cn = nodes[i];
+    digests[tStateHashLog::kCoords].Add( cn->getPermID() );
+    digests[tStateHashLog::kCoords].Add( cn->getX() );
+    digests[tStateHashLog::kCoords].Add( cn->getY() );
+    digests[tStateHashLog::kCoords].Add(
+      static_cast< int >( cn->getBoundaryFlag() ) );
+    digests[tStateHashLog::kElevation].Add( cn->getZ() );
+    if( cn->getBoundaryFlag() == kNonBoundary )
+    {
+      tLNode const *dn = cn->getDownstrmNbr();
+      digests[tStateHashLog::kFlow].Add( dn != 0 ? dn->getPermID() : -1 );
+      digests[tStateHashLog::kFlow].Add( cn->getDrArea() );
+      digests[tStateHashLog::kFlow].Add( cn->getQ() );
+    }
+    tList< tLayer > const &layers = cn->getLayersRef();
+    digests[tStateHashLog::kLayers].Add( layers.getSize() );
+    for( tListNodeBasic< tLayer > const *ln = layers.getFirst();
+         ln != 0; ln = ln->getNext() )
+    {
+      layer.clear();
+      ln->getDataRef().Pack( layer );
+      digests[tStateHashLog::kLayers].Add( layer );
+    }
+  }
+
+  std::vector< long > randState;
+  rand->getState( randState );
+  for( size_t i=0; i<randState.size(); ++i )
+    digests[tStateHashLog::kRand].Add( randState[i] );
+
+  stateHash->Record( nStorms, time->getCurrentTime(), phase, digests );
+}
+
 /**************************************************************************/
 /**
  **  childInterface::SetNodeElevations
@@ -1793,7 +2278,7 @@ SetNodeElevations( std::vector<double> elevations )
   
   for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
   {
-    if(1) std::cout << "node " << current_node->getPermID()
+    if(0) std::cout << "node " << current_node->getPermID()
       << " changing z from " << current_node->getZ() 
       << " to " << elevations[current_node->getPermID()] << std::endl;
     current_node->setZ( elevations[current_node->getPermID()] );
@@ -1933,10 +2418,12 @@ GetLoads()
 		if(0) std::cout << "Getting load for node " << node_id << std::endl;
 	  double load = 0.0;
 		double varea = current_node->getVArea();
-		tListIter<tLayer> li( current_node->getLayersRefNC() );
 		//int j=0;
-		for( tLayer * layp = li.FirstP(); !li.AtEnd(); layp=li.NextP() )
+		for( tListNodeBasic< tLayer > const *ln =
+		       current_node->getLayersRef().getFirst(); ln != 0;
+		     ln = ln->getNext() )
 		{
+			tLayer const *layp = ln->getDataPtr();
 			//std::cout << " Layer bulk density=" << layp->getBulkDensity();
       //std::cout << " Thickness=" << layp->getDepth();
 			load += layp->getDepth() * layp->getBulkDensity() * varea * GRAV;
@@ -43,6 +43,9 @@
 #include "../tWaterSedTracker/tWaterSedTracker.h"
 #include "../tMeshList/tMeshList.h"
 #include "../tLithologyManager/tLithologyManager.h"
+#include "../tBasinFarm/tBasinFarm.h"
+#include "../tMemoryFootprint/tMemoryFootprint.h"
+#include "../tStateHash/tStateHash.h"
 
 using namespace std;
 
@@ -113,10 +116,12 @@ public:
   // Public methods
   childInterface();
   void Initialize_Copy( const childInterface& );
+  childInterface *Fork() const;  // new copy of the current state
   void Initialize( int argc, char **argv );
   void Initialize( string argument_string );
   vector<double> VaryParameters( const tInputFile &, const double &, tRand &, 
 				 bool yesVary = true ); 
+  bool SetParameter( string keyword, double value );
   double RunOneStorm();
   void Run( double run_duration );
   void CleanUp();
@@ -144,9 +149,16 @@ public:
   double GetZCoordinate( int element_index, int vertex_index );
   std::vector<double> GetValueSet( string var_name );
   void SetValueSet( string var_name, std::vector<double> values );
+  // Batched exchange of several node variables in one pass over the mesh
+  int RegisterExchangeSet( std::vector<string> const & var_names );
+  void GetExchangeValues( int set_id, double * dest );
+  void SetExchangeValues( int set_id, const double * src );
   void setWriteOption( bool, tInputFile& );
   void WriteChildStyleOutput();
   void ChangeOption( string option, int val );
+  // Memory held by the model, by subsystem, and its release
+  void MemoryFootprint( tMemoryFootprint & ) const;
+  long CompactMemory( double thinLayerDepth );
 
   // Additional custom functions to accompany IElement interface
   bool IsInteriorNode( int element_index );
@@ -174,6 +186,9 @@ private:
   std::vector<double> GetNodeDischargeVector();  // Creates and returns vector of Q
   std::vector<double> GetNodeSedimentFluxVector();  // Creates and returns vector of Qs
   void SetNodeElevations( std::vector<double> elevations );
+  void WriteMemoryLogLine() const;
+  void StateHashCheckpoint( const char *phase );
+  std::vector<tLNode *> const & NodesByPermID();  // cached, see below
   std::vector<double> GetLandslideAreasVector(); // Creates and returns vector of landslides
   
   // Private data
@@ -196,7 +211,13 @@ private:
     optLandslides, // Option for landsliding
     opt3DLandslides, // Option for determining which landslide function to use
     optChemicalWeathering, // Option for chemical weathering
-    optPhysicalWeathering; // Option for physical weathering
+    optPhysicalWeathering, // Option for physical weathering
+    optMeshCoarsen,    // Option to coarsen mesh where landscape is quiescent
+    optMemoryReport,   // Option to log memory footprint at output times
+    optLayerCompaction; // Option to merge similar deep layers
+  long nLayersMerged;  // layers merged by compaction since last output
+  bool silentMode;     // no progress messages (-s, or not MPI process 0)
+  long nStorms;        // storms run so far
   bool optStreamLineBoundary; // Option for converting streamlines to open boundaries
   tRand *rand;             // -> random number generator
   tMesh<tLNode> *mesh;        // -> mesh object
@@ -213,8 +234,23 @@ private:
   tStratGrid *stratGrid;     // -> Stratigraphy Grid object
   tEolian *loess;           // -> eolian deposition object
   tStreamMeander *strmMeander; // -> stream meander object
+  tStateHashLog *stateHash;    // -> state hash log (if STATE_HASH_INTERVAL)
   //Predicates predicate;   // Math-related stuff
 	
+  // Private data for the batched exchange (RegisterExchangeSet)
+  typedef enum {
+    kExchElevation,   // get: z; set: z
+    kExchErosion,     // get: cumulative erosion/deposition; set: EroDep
+    kExchDischarge,   // get only
+    kExchSedFlux,     // get only
+    kExchX,           // get only
+    kExchY            // get only
+  } tExchangeVar_t;
+  std::vector< std::vector<tExchangeVar_t> > exchange_sets_;
+  std::vector<tLNode *> nodes_by_permid_;  // node of each permanent ID
+  tMesh<tLNode> *nodes_by_permid_mesh_;    // mesh the table was made for
+  unsigned long nodes_by_permid_version_;  // its node list version then
+	
   // Private data for implementing OpenMI IElement interface
   string element_set_id;
   string element_set_description;
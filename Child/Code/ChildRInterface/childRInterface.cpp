@@ -229,7 +229,7 @@ RunOneStorm()
 	if( time->CheckOutputTime() )
 		output->WriteOutput( time->getCurrentTime() );
 	
-	if( output->OptTSOutput() ) output->WriteTSOutput();
+	if( output->OptTSOutput() ) output->WriteTSOutput( time->getCurrentTime() );
 		
 	return( time->getCurrentTime() );
 }
@@ -88,9 +88,11 @@
 # include <iomanip>
 #include <vector>  // first added for DiffuseNonlinear()
 #include <queue> // first added for Landslides()
+#include <sstream>
 using namespace std;   // also added for DiffuseNonlinear() to use vector class from STL
 //#include <string>
 #include "erosion.h"
+#include "../tBasinFarm/tBasinFarm.h"
 
 // Here follows a table for transport, detachment, and physical and chemical
 // weathering laws, which are chosen at run time via "X()" trick in 
@@ -3588,6 +3590,25 @@ debris_flow_sed_bucket(0), debris_flow_wood_bucket(0)
   if( optAdaptMesh )
     mdMeshAdaptMaxFlux = infile.ReadItem( mdMeshAdaptMaxFlux,
                                          "MESHADAPT_MAXNODEFLUX" );
+  else
+    mdMeshAdaptMaxFlux = 0.0;
+  
+  // Option for removing nodes in quiescent areas (see CoarsenMesh)
+  mbMeshCoarsen = infile.ReadBool( "OPTMESHCOARSEN", false );
+  if( mbMeshCoarsen )
+  {
+    mdMeshCoarsenFrac = infile.ReadDouble( "MESHCOARSEN_HYSTERESIS" );
+    if( mdMeshCoarsenFrac <= 0.0 || mdMeshCoarsenFrac >= 1.0 )
+      ReportFatalError( "MESHCOARSEN_HYSTERESIS must be between 0 and 1" );
+    mdMeshCoarsenMaxCurv = infile.ReadDouble( "MESHCOARSEN_MAXCURV" );
+    mdMeshCoarsenMaxVArea = infile.ReadDouble( "MESHCOARSEN_MAXVAREA" );
+    mdMeshCoarsenMaxDrArea = infile.ReadDouble( "MESHCOARSEN_MAXDRAREA" );
+    if( mdMeshCoarsenMaxDrArea <= 0.0 )
+      ReportFatalError( "MESHCOARSEN_MAXDRAREA must be greater than 0" );
+  }
+  else
+    mdMeshCoarsenFrac = mdMeshCoarsenMaxCurv = mdMeshCoarsenMaxVArea =
+      mdMeshCoarsenMaxDrArea = 0.0;
   
   // Make sure the user wants the detachment and transport options that
   // are compiled in this version
@@ -3828,6 +3849,11 @@ tErosion::tErosion( const tErosion& orig, tMesh<tLNode>* Ptr )
     kd_ts(orig.kd_ts),
     difThresh(orig.difThresh),   // Diffusion occurs only at areas < difThresh
     mdMeshAdaptMaxFlux(orig.mdMeshAdaptMaxFlux), // For dynamic point addition: max ero flux rate
+    mbMeshCoarsen(orig.mbMeshCoarsen), // Option for dynamic point removal
+    mdMeshCoarsenFrac(orig.mdMeshCoarsenFrac), // Hysteresis fraction
+    mdMeshCoarsenMaxCurv(orig.mdMeshCoarsenMaxCurv), // Max |curvature| of removed node
+    mdMeshCoarsenMaxVArea(orig.mdMeshCoarsenMaxVArea), // Max grown voronoi area
+    mdMeshCoarsenMaxDrArea(orig.mdMeshCoarsenMaxDrArea), // Kept drainage area
     mdSc(orig.mdSc),  // Threshold slope for nonlinear diffusion
     diffusionH(orig.diffusionH), // depth scale for depth-dependent diffusion
     beta(orig.beta), // proportion of sediment flux contributing to bedload
@@ -4013,6 +4039,25 @@ void tErosion::TurnOffOutput()
     }
 }
 
+/**************************************************************************\
+**
+**  tErosion::setKd
+**
+**  Replaces the hillslope diffusivity KD, which may have been given as a
+**  time series, by a constant value (e.g., for one member of an
+**  ensemble, see tEnsemble).
+**
+**  Created: 10/2026
+**
+\**************************************************************************/
+void tErosion::setKd( double val )
+{
+  std::stringstream ss;
+  ss << val;
+  kd_ts.reconfigure( ss.str().c_str() );
+  kd = val;
+}
+
 
 /*****************************************************************************\
  **
@@ -4050,16 +4095,20 @@ void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet,
 {
   if(0) //DEBUG
     std::cout<<"ErodeDetachLim...";
-  double dt,
-  dtmax; // time increment
-  const double frac = 0.9; //fraction of time to zero slope
-  tLNode *cn, *dn;
+  double dtmax; // time increment
+  tLNode *cn;
   //int nActNodes = meshPtr->getNodeList()->getActiveSize();
   tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() );
   
   strmNet->FindChanGeom();
   strmNet->FindHydrGeom();
   
+  if( strmNet->getBasinParallelOpt() )
+  {
+    ErodeDetachLimBasins( dtg, strmNet, 0 );
+    return;
+  }
+  
   tArray<double> valgrd(1);
   //TODO: make it work w/ arbitrary # grain sizes
   
@@ -4074,15 +4123,7 @@ void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet,
     //find max. time step s.t. slope does not reverse:
     dtmax = dtg;
     for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
-    {
-      dn = cn->getDownstrmNbr();
-      const double ratediff = dn->getDzDt() - cn->getDzDt();
-      if( ratediff > 0 )
-	    {
-	      dt = ( cn->getZ() - dn->getZ() ) / ratediff * frac;
-	      if( dt > 0.000005 && dt < dtmax ) dtmax = dt;
-	    }
-    }
+      dtmax = DetachLimTimeStep( cn, dtmax, 0., 0 );
     //assert( dtmax > 0 );
     
     //apply erosion:
@@ -4132,21 +4173,23 @@ void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet,
  \*****************************************************************************/
 void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet, tUplift const *UPtr )
 {
-  double dt,
-  dtmax; // time increment
-  double frac = 0.1; //fraction of time to zero slope
+  double dtmax; // time increment
   //Xint i;
-  tLNode * cn, *dn;
+  tLNode * cn;
   //int nActNodes = meshPtr->getNodeList()->getActiveSize();
   tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() );
-  double ratediff;
-  //Xdouble dslpdt;
   double dtmin = dtg * 0.0001;
   int debugCount = 0;
   
   strmNet->FindChanGeom();
   strmNet->FindHydrGeom();
   
+  if( strmNet->getBasinParallelOpt() )
+  {
+    ErodeDetachLimBasins( dtg, strmNet, UPtr );
+    return;
+  }
+  
   tArray<double> valgrd(1);
   // Iterate until total time dtg has been consumed
   do
@@ -4157,40 +4200,7 @@ void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet, tUplift const *U
     dtmax = dtg;
     //find max. time step s.t. slope does not reverse:
     for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
-    {
-      /*slp = cn->calcSlope();
-       dslpdt = cn->getDSlopeDt();
-       if( slp > 0.0 )
-       {
-       if( dslpdt < 0.0 )
-       {
-       dt = slp / (-dslpdt - UPtr->getRate() ) * frac;
-       if( dt > 0 && dt < dtmax ) dtmax = dt;
-       }
-       }*/
-      
-      dn = cn->getDownstrmNbr();
-      if( dn->getBoundaryFlag() == kNonBoundary )
-        ratediff = dn->getDzDt() - cn->getDzDt();
-      else
-        ratediff = dn->getDzDt() - cn->getDzDt() - UPtr->getRate();
-      if( ratediff > 0 && cn->getZ() > dn->getZ() )
-	    {
-	      dt = ( cn->getZ() - dn->getZ() ) / ratediff * frac;
-	      if( dt > dtmin && dt < dtmax )
-        {
-          dtmax = dt;
-        }
-	      else
-        {
-          dtmax = dtmin;
-          if(0) //DEBUG
-            std::cout << "time step too small because of node at x,y,z "
-            << cn->getX() << " " << cn->getY() << " " << cn->getZ()
-            << std::endl;
-        }
-	    }
-    }
+      dtmax = DetachLimTimeStep( cn, dtmax, dtmin, UPtr );
     //assert( dtmax > 0 );
     //apply erosion:
     for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() ){
@@ -4214,6 +4224,168 @@ void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet, tUplift const *U
 }//end tErosion::ErodeDetachLim( double dtg, tUplift *UPtr )
 
 
+/*****************************************************************************\
+ **
+ **  tErosion::ErodeDetachLimBasins
+ **
+ **  Basin-parallel version of ErodeDetachLim, used when OPT_BASIN_PARALLEL
+ **  is set. The stream network has grouped the active nodes by outlet
+ **  basin (tStreamNet::LabelBasins); since no flow edge crosses between
+ **  basins, each basin is sub-stepped through dtg independently, with a
+ **  time step limited only by its own nodes, and basins run concurrently
+ **  when built with OpenMP. Basins are handed out largest first, and a
+ **  basin's result does not depend on which thread runs it, so results
+ **  are the same for any number of threads.
+ **
+ **  With several MPI processes, each erodes the basins given to it by
+ **  tBasinFarm::AssignBasins, and the results are then exchanged, so
+ **  they are also the same for any number of processes.
+ **
+ **  Only the erosion itself runs by basin, here and in DetachErode (see
+ **  DetachErodeBasins): the network update before it (flow directions,
+ **  FillLakes, drainage area) still runs serially over the whole mesh. The time step is that of ErodeDetachLim (see
+ **  DetachLimTimeStep).
+ **
+ **    Inputs: dtg -- duration of erosion
+ **            strmNet -- stream network, with basins labelled
+ **            UPtr -- uplift object for the uplift-aware time step, or 0
+ **
+ \*****************************************************************************/
+void tErosion::ErodeDetachLimBasins( double dtg, tStreamNet const *strmNet,
+                                     tUplift const *UPtr )
+{
+  const int nbasins = strmNet->getNumBasins();
+  const bool distributed = tBasinFarm::Size() > 1;
+  const int rank = tBasinFarm::Rank();
+  std::vector< int > owner;
+  int k;
+  
+  if( distributed )
+    tBasinFarm::AssignBasins( strmNet, owner );
+  
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+  for( k=0; k<nbasins; ++k )
+  {
+    const int b = strmNet->getBasinByRank( k );
+    if( distributed && owner[b] != rank ) continue;
+    ErodeDetachLimBasin( dtg, strmNet->getBasinNodes( b ),
+                         strmNet->getBasinSize( b ), UPtr );
+  }
+  
+  if( distributed )
+    tBasinFarm::ExchangeBasins( strmNet, owner );
+}
+
+
+/*****************************************************************************\
+ **
+ **  tErosion::DetachLimTimeStep
+ **
+ **  Time-step rule of ErodeDetachLim and ErodeDetachLimBasin, kept in one
+ **  place so that the serial and basin-parallel versions stay the same.
+ **  Given the longest step dtmax allowed so far, returns the longest step
+ **  for which the slope from cn to its downstream neighbour does not
+ **  reverse (their DzDt having been set), taking a fraction of the time
+ **  to zero slope:
+ **
+ **    - without UPtr, the rule of ErodeDetachLim (1 of 2): a fraction of
+ **      0.9, and steps of 0.000005 or less are ignored;
+ **    - with UPtr, that of ErodeDetachLim (2 of 2): a fraction of 0.1,
+ **      the uplift rate is counted when the neighbour is a boundary, and
+ **      any other limit on the step sets it to dtmin.
+ **
+ \*****************************************************************************/
+double tErosion::DetachLimTimeStep( tLNode const *cn, double dtmax,
+                                    double dtmin, tUplift const *UPtr ) const
+{
+  tLNode const *dn = cn->getDownstrmNbr();
+  double ratediff = dn->getDzDt() - cn->getDzDt();
+  if( UPtr==0 )
+  {
+    if( ratediff > 0 )
+    {
+      const double dt = ( cn->getZ() - dn->getZ() ) / ratediff * 0.9;
+      if( dt > 0.000005 && dt < dtmax ) dtmax = dt;
+    }
+  }
+  else
+  {
+    if( dn->getBoundaryFlag() != kNonBoundary )
+      ratediff -= UPtr->getRate();
+    if( ratediff > 0 && cn->getZ() > dn->getZ() )
+    {
+      const double dt = ( cn->getZ() - dn->getZ() ) / ratediff * 0.1;
+      if( dt > dtmin && dt < dtmax )
+        dtmax = dt;
+      else
+      {
+        dtmax = dtmin;
+        if(0) //DEBUG
+          std::cout << "time step too small because of node at x,y,z "
+          << cn->getX() << " " << cn->getY() << " " << cn->getZ()
+          << std::endl;
+      }
+    }
+  }
+  return dtmax;
+}
+
+
+/*****************************************************************************\
+ **
+ **  tErosion::ErodeDetachLimBasin
+ **
+ **  Erodes the nnodes nodes of one outlet basin over time dtg, using the
+ **  time-step rules of ErodeDetachLim (1 of 2) if UPtr is null, and of
+ **  ErodeDetachLim (2 of 2) otherwise. A sink outlet has no downstream
+ **  neighbour in the basin, and never limits the step in ErodeDetachLim
+ **  (it is flooded and lies below its flow-edge neighbour), so it is
+ **  skipped in the time-step test.
+ **
+ **  Only nodes of the basin, and the fixed boundary node it drains to,
+ **  are touched, so it may run concurrently with other basins.
+ **
+ \*****************************************************************************/
+void tErosion::ErodeDetachLimBasin( double dtg, tLNode * const *nodes,
+                                    int nnodes, tUplift const *UPtr )
+{
+  const double dtmin = dtg * 0.0001;
+  double dtmax;
+  int k;
+  int debugCount = 0;
+  tArray<double> valgrd(1);
+  
+  do
+  {
+    //first find erosion rate:
+    for( k=0; k<nnodes; ++k )
+      nodes[k]->setDzDt( -bedErode->DetachCapacity( nodes[k] ) );
+    
+    //find max. time step s.t. slope does not reverse:
+    dtmax = dtg;
+    for( k=0; k<nnodes; ++k )
+      if( nodes[k]->getFloodStatus() != tLNode::kSink )
+        dtmax = DetachLimTimeStep( nodes[k], dtmax, dtmin, UPtr );
+    
+    //apply erosion:
+    for( k=0; k<nnodes; ++k )
+    {
+      valgrd[0] = nodes[k]->getDzDt() * dtmax;
+      nodes[k]->EroDep( 0, valgrd, 0. );
+    }
+    
+    //update time:
+    dtg -= dtmax;
+    
+    if( ++debugCount > 1e6 )
+      ReportFatalError("More than 1e6 iterations in ErodeDetachLimBasin()" );
+    
+  } while( UPtr ? dtg>0 : dtg>0.0000001 );
+}
+
+
 /*****************************************************************************\
  **
  **  tErosion::StreamErode
@@ -4751,6 +4923,33 @@ void tErosion::StreamErodeMulti( double dtg, tStreamNet *strmNet, double time )
 }
 
 
+// Sediment sent downstream by the outlet of a basin, held back while
+// basins are eroded concurrently (see DetachErodeBasins)
+struct tSedOutflow
+{
+  double qsin;             // flux sent to the total only
+  tArray< double > qsinm;  // flux by grain size, also added to the total
+};
+
+// Sends sediment flux q (of grain size i) from cn to its downstream
+// neighbour, or into out if cn's outflow is held back
+static inline void SendQsin( tLNode *cn, tSedOutflow *out, double q )
+{
+  if( out )
+    out->qsin += q;
+  else
+    cn->getDownstrmNbr()->addQsin( q );
+}
+
+static inline void SendQsin( tLNode *cn, tSedOutflow *out, size_t i,
+                             double q )
+{
+  if( out )
+    out->qsinm[i] += q;
+  else
+    cn->getDownstrmNbr()->addQsin( i, q );
+}
+
 /***********************************************************************\
  **
  **  tErosion::DetachErode
@@ -4759,6 +4958,10 @@ void tErosion::StreamErodeMulti( double dtg, tStreamNet *strmNet, double time )
  **  if the stream has the capacity to carry it. Handles multiple grain
  **  sizes. Replaces StreamErode and StreamErodeMulti.
  **
+ **  With OPT_BASIN_PARALLEL, each outlet basin is eroded on its own time
+ **  step (see DetachErodeBasins), unless sediment flux is tracked at
+ **  nodes, which needs one time step for the whole mesh.
+ **
  \************************************************************************/
 
 void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
@@ -4767,13 +4970,110 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
     //Added 4/00, if there is no runoff, this would crash, so check
   if(strmNet->getRainRate()-strmNet->getInfilt()>0){
     
+    // Sort so that we always work in upstream to downstream order
+    strmNet->SortNodesByNetOrder();
+    strmNet->FindChanGeom();
+    strmNet->FindHydrGeom();
+    
+    if( strmNet->getBasinParallelOpt() && !track_sed_flux_at_nodes_ )
+      DetachErodeBasins( dtg, strmNet, time );
+    else
+    {
+      tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() );
+      std::vector< tLNode * > nodes;
+      for( tLNode *cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
+        nodes.push_back( cn );
+      if( !nodes.empty() )
+        DetachErodeNodes( dtg, &nodes[0], static_cast<int>( nodes.size() ),
+                          strmNet, time, 0 );
+    }
+  }//end if rainrate-infilt>0
+  
+  
+  if(0) std::cout<<"ending detach erode\n"<<std::flush;
+  
+}// End erosion algorithm
+
+
+/***********************************************************************\
+ **
+ **  tErosion::DetachErodeBasins
+ **
+ **  Basin-parallel version of DetachErode, used when OPT_BASIN_PARALLEL
+ **  is set (see ErodeDetachLimBasins). Each outlet basin is eroded
+ **  through dtg by DetachErodeNodes on its own time step, and basins run
+ **  concurrently when built with OpenMP; results are the same for any
+ **  number of threads.
+ **
+ **  Several basins may drain to the same boundary node, and a sink
+ **  outlet's flow-edge neighbour lies in another basin, so the sediment
+ **  each outlet sends downstream is held back while basins run, and is
+ **  passed on afterwards, basin by basin. The inlet, if any, lies in one
+ **  basin and is handled there. The outlet fluxes are not exchanged
+ **  between MPI processes, so each process erodes all the basins.
+ **
+ **    Inputs: dtg -- duration of erosion
+ **            strmNet -- stream network, with basins labelled
+ **            time -- current time, for layering
+ **
+ \************************************************************************/
+void tErosion::DetachErodeBasins( double dtg, tStreamNet *strmNet,
+                                  double time )
+{
+  const int nbasins = strmNet->getNumBasins();
+  std::vector< tSedOutflow > outflow( nbasins );
+  int k;
+  
+  for( k=0; k<nbasins; ++k )
+  {
+    outflow[k].qsin = 0.;
+    outflow[k].qsinm.setSize( strmNet->getBasinNodes( k )[0]->getNumg() );
+  }
+  
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+  for( k=0; k<nbasins; ++k )
+  {
+    const int b = strmNet->getBasinByRank( k );
+    DetachErodeNodes( dtg, strmNet->getBasinNodes( b ),
+                      strmNet->getBasinSize( b ), strmNet, time,
+                      &outflow[b] );
+  }
+  
+  // Pass on, in basin order, what each outlet sent downstream
+  for( k=0; k<nbasins; ++k )
+  {
+    tLNode * const dn =
+      strmNet->getBasinNodes( k )[strmNet->getBasinSize( k )-1]
+      ->getDownstrmNbr();
+    dn->addQsin( outflow[k].qsin );
+    for( size_t i=0; i<outflow[k].qsinm.getSize(); i++ )
+      dn->addQsin( i, outflow[k].qsinm[i] );
+  }
+}
+
+
+/***********************************************************************\
+ **
+ **  tErosion::DetachErodeNodes
+ **
+ **  The time loop of DetachErode, over nnodes nodes in upstream-to-
+ **  downstream order: all the active nodes, or one outlet basin. For a
+ **  basin, outflow collects the sediment that its outlet (the last node)
+ **  sends downstream, instead of the node below, and a sink outlet does
+ **  not limit the time step. Otherwise outflow is null.
+ **
+ \************************************************************************/
+void tErosion::DetachErodeNodes( double dtg, tLNode * const *nodes,
+                                 int nnodes, tStreamNet *strmNet,
+                                 double time, tSedOutflow *outflow )
+{
     double dtmax;       // time increment: initialize to arbitrary large val
     double frac = 0.3;  //fraction of time to zero slope
     double timegb=time; //time gone by - for layering time purposes
     bool flag;
     tLNode * cn, *dn;
-    // int nActNodes = meshPtr->getNodeList()->getActiveSize();
-    tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() );
     double ratediff,  // Difference in ero/dep rate btwn node & its downstrm nbr
     drdt,
     dz,
@@ -4783,8 +5083,10 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
     tLNode * inletNode = strmNet->getInletNodePtrNC();
     double insedloadtotal = strmNet->getInSedLoad();
     int debugCount = 0;
+    int k;
+    tSedOutflow *out;  // where the node's sediment goes, if held back
     
-    cn = ni.FirstP();
+    cn = nodes[0];
     
     tArray <double> ret( cn->getNumg() ); //amt actually ero'd/dep'd
     tArray <double> erolist( cn->getNumg() );
@@ -4807,11 +5109,6 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
     // Modify code to set erodibility of inlet node to zero, and compute sed influx before loop using call to 
     // TransCapacity. Assign these fluxes to insed ... etc.
     
-    // Sort so that we always work in upstream to downstream order
-    strmNet->SortNodesByNetOrder();
-    strmNet->FindChanGeom();
-    strmNet->FindHydrGeom();
-    
     // Compute erosion and/or deposition until all of the elapsed time (dtg)
     // is used up
     do
@@ -4819,8 +5116,9 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
       if(0) std::cout << "DetachErode: top of do loop\n" << std::flush;
       
       // Zero out sed influx of all sizes
-      for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
+      for( k=0; k<nnodes; ++k )
       {
+        cn = nodes[k];
         if(0 && cn==inletNode ) std::cout<<"top loop ID="<<cn->getID()<<std::endl;
         cn->setQs(0.0);
         if( cn!=inletNode )
@@ -4916,8 +5214,10 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
       // totals for time-step calculations, however transport
       // rates for each size are also set within the function call.
       if(0) std::cout << "DetachErode: estimating rates\n" << std::flush;
-      for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
+      for( k=0; k<nnodes; ++k )
       {
+        cn = nodes[k];
+        out = ( k==nnodes-1 ) ? outflow : 0;
         depck=0.;
         int i=0;
         qs=0.;
@@ -4979,7 +5279,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
         if( -drdt > excap ){
           cn->setDzDt(-excap);
         }
-        cn->getDownstrmNbr()->addQsin(cn->getQsin()-cn->getDzDt()*cn->getVArea());
+        SendQsin( cn, out, cn->getQsin()-cn->getDzDt()*cn->getVArea() );
         
         //std::cout << "*** EROSION ***\n";
         if( 0 && cn==inletNode ) {
@@ -4988,13 +5288,14 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
           //cn->TellAll();
         }
         
-      }//ends for( cn = ni.FirstP...
+      }//ends for( k=0...
       
       //Find local time-step based on dzdt
       if(0) std::cout << "DetachErode: finding time step size\n" << std::flush;
       dtmax = dtg/frac;
-      for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
+      for( k=0; k<nnodes; ++k )
       {
+        cn = nodes[k];
         //Not for time step calculations, just utilizing loop
         if( cn!=inletNode )
 	      {
@@ -5012,6 +5313,9 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
           }
 	      }
         
+        // a sink outlet drains out of its basin, and does not set the step
+        if( outflow!=0 && cn->getFloodStatus()==tLNode::kSink ) continue;
+        
         dn = cn->getDownstrmNbr();
         ratediff = dn->getDzDt() - cn->getDzDt(); //Are the pts converging?
         if( ratediff > 0. && (cn->calcSlope()) > 1e-7 )  // if yes, get time
@@ -5042,7 +5346,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
             }
           }
 	      }
-      }// End for( cn = ni.FirstP()..
+      }// End for( k=0..
       dtmax *= frac;  // Take a fraction of time-to-flattening
       timegb+=dtmax;
       
@@ -5050,8 +5354,10 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
       
       // Do erosion/deposition
       if(0) std::cout << "DetachErode: eroding\n" << std::flush;
-      for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
+      for( k=0; k<nnodes; ++k )
       {
+        cn = nodes[k];
+        out = ( k==nnodes-1 ) ? outflow : 0;
         //need to recalculate cause qsin may change due to time step calc
         excap=(cn->getQs() - cn->getQsin())/cn->getVArea();
         
@@ -5074,7 +5380,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
         }
         
         for(size_t i=0; i<cn->getNumg(); i++)
-          cn->getDownstrmNbr()->addQsin(i,cn->getQsin(i));
+          SendQsin( cn, out, i, cn->getQsin(i) );
         //What goes downstream will be what comes in + what gets ero'd/dep'd
         //This should always be negative or zero since max amt
         //to deposit is what goes in.
@@ -5120,7 +5426,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
                 { 
                   ret=cn->EroDep(i,erolist,timegb); //ORIGINAL
                   for(size_t j=0;j<cn->getNumg();j++){ //ORIGINAL
-                    cn->getDownstrmNbr()->addQsin(j,-ret[j]*cn->getVArea()/dtmax); //ORIGINAL
+                    SendQsin( cn, out, j, -ret[j]*cn->getVArea()/dtmax ); //ORIGINAL
                   } //ORIGINAL
                 } //TEMP 6/06
                 dz=0.;
@@ -5148,7 +5454,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
                   ret=cn->EroDep(i,erolist,timegb);
                   for(size_t j=0;j<cn->getNumg();j++){
                     //if * operator was overloaded for arrays, no loop necessary
-                    cn->getDownstrmNbr()->addQsin(j,-ret[j]*cn->getVArea()/dtmax);
+                    SendQsin( cn, out, j, -ret[j]*cn->getVArea()/dtmax );
                   }
                 }
                 if(flag){
@@ -5177,7 +5483,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
                 //if( 1 && cn==inletNode ) std::cout<<"ret0="<<ret[0]<<" ret1="<<ret[1]<<std::endl;
                 double sum=0.;
                 for(size_t j=0;j<cn->getNumg();j++){
-                  cn->getDownstrmNbr()->addQsin(j,-ret[j]*cn->getVArea()/dtmax);
+                  SendQsin( cn, out, j, -ret[j]*cn->getVArea()/dtmax );
                   erolist[j]-=ret[j];
                   sum+=erolist[j];
                 }
@@ -5201,14 +5507,14 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
           {
             ret=cn->EroDep(0,erolist,timegb);
             for(size_t j=0;j<cn->getNumg();j++){
-              cn->getDownstrmNbr()->addQsin(j,-ret[j]*cn->getVArea()/dtmax);
+              SendQsin( cn, out, j, -ret[j]*cn->getVArea()/dtmax );
             }
           }
 	      }
         
         if( 0 && cn==inletNode ) std::cout<<"end of node FOR loop\n";
         
-      } // Ends for( cn = ni.FirstP()...
+      } // Ends for( k=0...
       
       if( track_sed_flux_at_nodes_ )
       {
@@ -5237,12 +5543,8 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
       
       //std::cout<<"Time remaining now "<<dtg<<std::endl;
     } while( dtg>1e-6 );  //Keep going until we've used up the whole time intrvl
-  }//end if rainrate-infilt>0
-  
-  
-  if(0) std::cout<<"ending detach erode\n"<<std::flush;
-  
-}// End erosion algorithm
+}
+
 
 /***********************************************************************\
  **
@@ -5646,7 +5948,7 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
   
   // Fix for "diffusion doesn't update layers" bug GT 11/12. We assume
   // that for multi-sizes, we'll call DiffuseMultiSize instead
-  static tArray<double> deposition_depth( 1 );
+  tArray<double> deposition_depth( 1 );
   
 #ifdef TRACKFNS
   std::cout << "tErosion::Diffuse()" << std::endl;
@@ -5782,8 +6084,8 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
   
   // Here we create arrays to handle flux and deposition in the 
   // various size classes
-  static tArray<double> deposition_depth( num_grain_sizes_ );
-  static tArray<double> volout_by_size( num_grain_sizes_ );
+  tArray<double> deposition_depth( num_grain_sizes_ );
+  tArray<double> volout_by_size( num_grain_sizes_ );
   
   if (0) std::cout << "tErosion::DiffuseMultiSize()" << std::endl;
 	
@@ -7620,34 +7922,199 @@ void tErosion::UpdateExposureTime( double dtg)
  ** flux exceeds this threshold at a given node, new nodes are
  ** added at each of the node's Voronoi vertices.
  **
+ ** New nodes inherit their parent's dzdt, so they are checked in turn
+ ** (with their own, smaller, Voronoi areas). The check runs in passes:
+ ** the nodes flagged in a pass are densified together in one bulk
+ ** insertion, and the next pass checks the nodes just added. As when
+ ** nodes were densified one at a time, a node is only densified if it
+ ** still exceeds the threshold once its neighbours have been: flagged
+ ** nodes within two spokes of another are left to the next pass, and
+ ** checked again there (tMesh::DeferNearbyCentres). Nodes are still
+ ** taken in a different order than before, so the new mesh is not
+ ** exactly the same.
+ **
  **   Created: 2/2000 gt for gully erosion study
  **   Assumptions: assumes node dzdt value is correct
+ **   Modifications:
+ **    - flagged nodes densified in bulk passes (tMesh::AddNodesAround)
  **
  **********************************************************************/
 void tErosion::DensifyMesh( double time )
 {
   tMesh< tLNode >::nodeListIter_t niter( meshPtr->getNodeList() );  // node list iter.
   tLNode *cn;              // Current node being checked
+  tPtrList< tLNode > checkList;  // Nodes to check in this pass
+  tPtrList< tLNode > denseList;  // Nodes to densify around
   
   double dbgnf, dbgmax=0.;
   
   std::cout << "Checking nodes...\n";
   
-  // Check all active nodes
+  // Check all active nodes, then the nodes added around them
   for( cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
+    checkList.insertAtBack( cn );
+  while( checkList.getSize() > 0 )
   {
-    dbgnf = fabs(cn->getVArea()*cn->getDzDt());
-    if( dbgnf>dbgmax ) dbgmax = dbgnf;
-    
-    // If local flux (ero rate * varea) exceeds threshold, add new nodes
-    if( fabs(cn->getVArea()*cn->getDzDt()) > mdMeshAdaptMaxFlux )
+    tPtrListIter< tLNode > checkIter( checkList );
+    for( cn=checkIter.FirstP(); !(checkIter.AtEnd()); cn=checkIter.NextP() )
     {
-      meshPtr->AddNodesAround( cn, time );
-      //std::cout << "*** Adding points here:\n";
-      //cn->TellAll();
+      dbgnf = fabs(cn->getVArea()*cn->getDzDt());
+      if( dbgnf>dbgmax ) dbgmax = dbgnf;
+      
+      // If local flux (ero rate * varea) exceeds threshold, add new nodes
+      if( fabs(cn->getVArea()*cn->getDzDt()) > mdMeshAdaptMaxFlux )
+        denseList.insertAtBack( cn );
+    }
+    checkList.Flush();
+    if( denseList.getSize() > 0 )
+    {
+      // Nodes near another one being densified are checked again, with
+      // the area they are left with, along with the nodes just added
+      meshPtr->DeferNearbyCentres( denseList, checkList );
+      meshPtr->AddNodesAround( denseList, time, &checkList );
+      denseList.Flush();
     }
   }
   
   std::cout << "Max node flux: " << dbgmax << std::endl;
   
 }
+
+
+// A node chosen by CoarsenMesh, and what is needed to merge it into the
+// neighbours that take in its cell
+struct tCoarsenRemoval
+{
+  tMesh< tLNode >::nodeListNode_t *listNode;
+  double z;
+  tList< tLayer > layers;
+  std::vector< tLNode * > nbrs;
+  std::vector< double > oldArea;
+};
+
+/***********************************************************************\
+ **
+ ** tErosion::CoarsenMesh
+ **
+ ** Called only when the option for adaptive coarsening is invoked,
+ ** this is the converse of DensifyMesh and DensifyMeshDrArea: it removes
+ ** interior nodes where the landscape is quiescent, so that the node
+ ** count of a long adaptive run levels off rather than only growing.
+ ** A node is removed if (1) it is an interior node that does not meander,
+ ** is not the inlet, has no boundary neighbours and drains less than
+ ** mdMeshCoarsenMaxDrArea, so that channels keep their resolution
+ ** whether or not drainage-area densification is on; (2) the magnitude of
+ ** its curvature (a finite-volume Laplacian of z) is below
+ ** mdMeshCoarsenMaxCurv; (3) no neighbour's Voronoi area would exceed
+ ** mdMeshCoarsenMaxVArea if it took in the whole of the node's cell; and
+ ** (4) removal could not make a node eligible for densification. For the
+ ** last test the densification thresholds are scaled by the hysteresis
+ ** factor mdMeshCoarsenFrac (0<f<1), so a node removed here cannot be put
+ ** straight back: the node and its neighbours must have a flux, on the
+ ** enlarged cell, below f times mdMeshAdaptMaxFlux, and the node's
+ ** drainage area must be below f times the drainage-area threshold (any
+ ** neighbour above that area must also stay below f times its Voronoi
+ ** area limit). A densification test that is switched off is skipped.
+ **
+ ** Nodes are removed in one batch, chosen so that no two share a
+ ** neighbour; each removed node's cell is thus split among its own
+ ** neighbours only. Each neighbour j gains area dA_j, and its column
+ ** becomes the mixture of a fraction dA_j / A_j' of the removed node's
+ ** column with its own (see tLNode::MergeColumn): its elevation moves
+ ** to the area-weighted mean, and the removed node's layers are merged,
+ ** depth for depth, into its own, so that the volume of each kind of
+ ** material is conserved.
+ **
+ **   Inputs: strmNet -- stream network, for drainage area and inlet
+ **   Returns: the number of nodes removed
+ **   Created: 10/2026
+ **   Assumptions: assumes node dzdt and drainage area values are current
+ **
+ **********************************************************************/
+int tErosion::CoarsenMesh( tStreamNet const *strmNet )
+{
+  tMesh< tLNode >::nodeListIter_t niter( meshPtr->getNodeList() );
+  tLNode *cn, *nbr;
+  tEdge *ce;
+  const double maxFlux = mdMeshCoarsenFrac * mdMeshAdaptMaxFlux;
+  const double minArea = mdMeshCoarsenFrac * strmNet->getMeshAdaptMinArea();
+  const double maxVArea = mdMeshCoarsenFrac * strmNet->getMeshAdaptMaxVArea();
+  tLNode const *inlet = strmNet->getInletNodePtr();
+  std::vector< tCoarsenRemoval > removals;
+  
+  // Flags for nodes in the closed neighbourhood of a node already chosen
+  int maxID = 0;
+  for( cn=niter.FirstP(); !(niter.AtEnd()); cn=niter.NextP() )
+    if( cn->getID() > maxID ) maxID = cn->getID();
+  tArray< int > locked( maxID+1 );
+  
+  // Choose the nodes to remove
+  for( cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
+  {
+    if( locked[cn->getID()] || cn->isMobile() || cn==inlet ) continue;
+    if( cn->getDrArea() >= mdMeshCoarsenMaxDrArea ) continue;
+    if( minArea > 0.0 && cn->getDrArea() >= minArea ) continue;
+    const double area = cn->getVArea();
+    if( maxFlux > 0.0 && fabs(cn->getDzDt())*area >= maxFlux ) continue;
+    
+    bool ok = true;
+    double curv = 0.0;
+    tSpkIter sI( cn );
+    for( ce=sI.FirstP(); ok && !(sI.AtEnd()); ce=sI.NextP() )
+    {
+      nbr = static_cast< tLNode * >( ce->getDestinationPtrNC() );
+      const double newArea = nbr->getVArea() + area;
+      if( nbr->getBoundaryFlag()!=kNonBoundary || locked[nbr->getID()]
+          || newArea > mdMeshCoarsenMaxVArea
+          || ( maxFlux > 0.0 && fabs(nbr->getDzDt())*newArea >= maxFlux )
+          || ( minArea > 0.0 && nbr->getDrArea() > minArea
+               && maxVArea > 0.0 && newArea >= maxVArea ) )
+        ok = false;
+      else
+        curv += (nbr->getZ()-cn->getZ()) * ce->getVEdgLen() / ce->getLength();
+    }
+    if( !ok || fabs(curv/area) >= mdMeshCoarsenMaxCurv ) continue;
+    
+    // Record the node and lock its closed neighbourhood
+    removals.push_back( tCoarsenRemoval() );
+    tCoarsenRemoval &r = removals.back();
+    r.listNode = niter.NodePtr();
+    r.z = cn->getZ();
+    r.layers = cn->getLayersRef();
+    locked[cn->getID()] = 1;
+    for( ce=sI.FirstP(); !(sI.AtEnd()); ce=sI.NextP() )
+    {
+      nbr = static_cast< tLNode * >( ce->getDestinationPtrNC() );
+      locked[nbr->getID()] = 1;
+      r.nbrs.push_back( nbr );
+      r.oldArea.push_back( nbr->getVArea() );
+    }
+  }
+  
+  if( removals.empty() ) return 0;
+  
+  // Remove them, then update the mesh once
+  std::vector< tCoarsenRemoval >::iterator ri;
+  for( ri=removals.begin(); ri!=removals.end(); ++ri )
+    if( !meshPtr->DeleteNode( ri->listNode, kRepairMesh, kNoUpdateMesh ) )
+      ReportFatalError( "CoarsenMesh: failed to delete a node" );
+  meshPtr->UpdateMesh();
+  
+  // Share each removed cell's column among the neighbours that took it in
+  for( ri=removals.begin(); ri!=removals.end(); ++ri )
+    for( size_t k=0; k<ri->nbrs.size(); ++k )
+    {
+      nbr = ri->nbrs[k];
+      const double dA = nbr->getVArea() - ri->oldArea[k];
+      if( dA <= 0.0 ) continue;
+      const double w = dA / nbr->getVArea();
+      if( nbr->getNumLayer() > 0 && ri->layers.getSize() > 0 )
+        nbr->MergeColumn( ri->z, ri->layers, w );
+      else
+        nbr->ChangeZ( (ri->z-nbr->getZ()) * w );
+    }
+  
+  if(0) //DEBUG
+    std::cout << "Removed " << removals.size() << " nodes\n";
+  return static_cast< int >( removals.size() );
+}
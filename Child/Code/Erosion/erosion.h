@@ -47,6 +47,9 @@
  **     - added an erosion-rate-based adaptive mesh capability, with
  **       a new DensifyMesh function and supporting data member
  **       mdMeshAdaptMaxFlux (gt 2/2000)
+ **     - added CoarsenMesh, the converse of DensifyMesh, which removes
+ **       interior nodes in quiescent areas, with thresholds set back from
+ **       the densification ones by a hysteresis factor (10/2026)
  **     - 2/02 new class tSedTransPwrLawMulti to handle multi-size
  **       transport in power-law (excess-shear stress) formulation
  **       (GT)
@@ -78,6 +81,8 @@
 #include "../tVegetation/tVegetation.h"
 #include "../tWaterSedTracker/tWaterSedTracker.h"
 
+struct tSedOutflow;
+
 /***************************************************************************/
 /*
  **  @class tEquilibCheck
@@ -1252,6 +1257,7 @@ public:
   void LandslideClusters3D( double rainrate, double time );
    void UpdateExposureTime( double dtg);
    void DensifyMesh( double time );
+   int CoarsenMesh( tStreamNet const * );
    void ActivateSedVolumeTracking( tWaterSedTracker *water_sed_tracker_ptr )
      { track_sed_flux_at_nodes_ =true;  water_sed_tracker_ptr_ = water_sed_tracker_ptr; }
   void DeactivateSedVolumeTracking() 
@@ -1262,6 +1268,8 @@ public:
   tDF_RunOut* getDF_RunOutPtr() {return runout;}
   tDF_Scour* getDF_ScourPtr() {return scour;}
   tDF_Deposit* getDF_DepositPtr() {return deposit;}
+  double getKd() const {return kd;}
+  void setKd( double );
   double getDiffusionH() {return diffusionH;}
   void setDiffusionH( double val ) {diffusionH = val;}
   double getSoilBulkDensity() {return soilBulkDensity;}
@@ -1289,6 +1297,11 @@ private:
   tTimeSeries kd_ts;         // Hillslope transport coef as time series
   double difThresh;          // Diffusion occurs only at areas < difThresh
   double mdMeshAdaptMaxFlux; // For dynamic point addition: max ero flux rate
+  bool mbMeshCoarsen;        // Option for dynamic point removal
+  double mdMeshCoarsenFrac;  // Hysteresis: fraction of densification thresholds
+  double mdMeshCoarsenMaxCurv;  // Max |curvature| at a node to be removed
+  double mdMeshCoarsenMaxVArea; // Max voronoi area a neighbour may grow to
+  double mdMeshCoarsenMaxDrArea; // Drainage area at which nodes are kept
   double mdSc;				  // Threshold slope for nonlinear diffusion
   double diffusionH; // depth scale for depth-dependent diffusion
   double beta; // proportion of sediment flux contributing to bedload
@@ -1300,6 +1313,14 @@ private:
   double woodDensity; // density of wood (kg/m3)
   double fricSlope; // tangent of angle of repose for soil (unitless)
   unsigned num_grain_sizes_;  // number of grain-size classes used
+
+  void ErodeDetachLimBasins( double dtg, tStreamNet const *, tUplift const * );
+  void ErodeDetachLimBasin( double dtg, tLNode * const *, int, tUplift const * );
+  double DetachLimTimeStep( tLNode const *, double dtmax, double dtmin,
+                            tUplift const * ) const;
+  void DetachErodeBasins( double dtg, tStreamNet *, double time );
+  void DetachErodeNodes( double dtg, tLNode * const *, int, tStreamNet *,
+                         double time, tSedOutflow * );
 public:
   double debris_flow_sed_bucket; // tally of debris flow sed. volume
   double debris_flow_wood_bucket;// tally of debris flow wood volume
@@ -71,6 +71,12 @@ void tRand::readFromFile( std::ifstream& inFile ){
   inFile >> inextp;
 }
 
+void tRand::getState( std::vector< long > &state ) const {
+  state.assign( ma+1, ma+sizeof(ma)/sizeof(ma[0]) );
+  state.push_back( inext );
+  state.push_back( inextp );
+}
+
 int tRand::numberRecords() const {
   return sizeof(ma)/sizeof(ma[0])-1+2;
 }
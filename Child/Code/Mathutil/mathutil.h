@@ -32,6 +32,7 @@ double genrand_res53(void);
 // forward declaration
 class tInputFile;
 #include <iosfwd>
+#include <vector>
 #include <math.h>
 
 /** @class tRand
@@ -55,6 +56,7 @@ public:
   void dumpToFile( std::ofstream&  );
   void readFromFile( std::ifstream& );
   int numberRecords() const;
+  void getState( std::vector< long > & ) const;  // as dumpToFile
 private:
   void initFromFile(tInputFile const &);
   // state of ran3()
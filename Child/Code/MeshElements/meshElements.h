@@ -490,7 +490,7 @@ inline tNode::tNode() :
 //copy constructor
 inline tNode::tNode( const tNode &original ) :
   listObj(original.listObj),
-  id(original.id), permid(original.id),
+  id(original.id), permid(original.permid),
   x(original.x), y(original.y), z(original.z),
   varea(original.varea), varea_rcp(original.varea_rcp),
   boundary(original.boundary), edg(original.edg),
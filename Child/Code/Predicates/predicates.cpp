@@ -132,6 +132,7 @@
 /*****************************************************************************/ 
 
 #include "predicates.h"
+#include <iostream>
 
 // The algorithms below fail on processors using extended precision.
 // Consequently, on Intel x86, we set the control word of the x87 device
@@ -208,11 +209,115 @@ public:
 # define SET_DOUBLE_PRECISION_MODE
 #endif
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Counters of filter failures.                                             */
+/*                                                                           */
+/*  Each thread increments a block of counters of its own, so the counters  */
+/*  cost next to nothing when the triangulator runs in parallel.  A thread   */
+/*  finds its block through a threadprivate pointer (the C++98 stand-in for  */
+/*  thread_local): the first time it makes a test on a Predicates object it  */
+/*  allocates a block and registers it with the object, under a critical     */
+/*  section; the getters sum the registered blocks.  Unlike a row chosen by  */
+/*  omp_get_thread_num(), a block is never shared by threads of different    */
+/*  teams (nested regions, or ensemble members run in parallel).  In each    */
+/*  block, entry 2*which holds the number of tests made and entry 2*which+1  */
+/*  the number of them that went through the adaptive/exact path.            */
+/*                                                                           */
+/*****************************************************************************/
+
+namespace
+{
+  // the calling thread's counter block, and the serial number of the
+  // Predicates object it belongs to (0 for none)
+  unsigned long *threadCounters = 0;
+  unsigned long threadCountersOwner = 0;
+#ifdef _OPENMP
+# pragma omp threadprivate( threadCounters, threadCountersOwner )
+#endif
+  unsigned long lastCounterSerial = 0;
+}
+
 // constructor; just calls exactinit() (SL, 10/98):
 Predicates::Predicates() 
 {
    SET_DOUBLE_PRECISION_MODE;
    exactinit();
+#ifdef _OPENMP
+# pragma omp critical( predicate_counters )
+#endif
+   counterSerial = ++lastCounterSerial;
+}
+
+Predicates::~Predicates()
+{
+  for( size_t i=0; i<counterStorage.size(); ++i )
+    delete [] counterStorage[i];
+}
+
+unsigned long *Predicates::counterSlot()
+{
+  if( threadCountersOwner != counterSerial )
+  {
+    // over-allocate, and start the block at the next cache line
+    char * const storage =
+      new char[kCounterSlotSize*sizeof(unsigned long) + kCacheLineSize];
+    unsigned long * const block = reinterpret_cast< unsigned long * >(
+      storage + kCacheLineSize
+      - reinterpret_cast< size_t >( storage ) % kCacheLineSize );
+    for( int j=0; j<kCounterSlotSize; ++j ) block[j] = 0;
+#ifdef _OPENMP
+# pragma omp critical( predicate_counters )
+#endif
+    {
+      counterBlocks.push_back( block );
+      counterStorage.push_back( storage );
+    }
+    threadCounters = block;
+    threadCountersOwner = counterSerial;
+  }
+  return threadCounters;
+}
+
+// Reset and the getters are meant to be called between triangulations,
+// not while other threads are making tests.
+void Predicates::ResetCounters()
+{
+  for( size_t i=0; i<counterBlocks.size(); ++i )
+    for( int j=0; j<kCounterSlotSize; ++j )
+      counterBlocks[i][j] = 0;
+}
+
+unsigned long Predicates::getCallCount( int which ) const
+{
+  unsigned long n = 0;
+  for( size_t i=0; i<counterBlocks.size(); ++i )
+    n += counterBlocks[i][2*which];
+  return n;
+}
+
+unsigned long Predicates::getExactCount( int which ) const
+{
+  unsigned long n = 0;
+  for( size_t i=0; i<counterBlocks.size(); ++i )
+    n += counterBlocks[i][2*which+1];
+  return n;
+}
+
+void Predicates::ReportCounters() const
+{
+  static const char * const names[kNumCountedPredicates] =
+    { "orient2d", "incircle" };
+  for( int k=0; k<kNumCountedPredicates; ++k )
+  {
+    const unsigned long ncalls = getCallCount( k );
+    const unsigned long nexact = getExactCount( k );
+    std::cout << "Predicates: " << names[k] << " " << ncalls << " tests, "
+	      << nexact << " to exact arithmetic";
+    if( ncalls > 0 )
+      std::cout << " (" << 100.0 * nexact / ncalls << "%)";
+    std::cout << std::endl;
+  }
 }
  
 /*****************************************************************************/ 
@@ -1192,36 +1297,79 @@ REAL Predicates::orient2dadapt(const REAL *pa, const REAL *pb, const REAL *pc, R
   return(D[Dlength - 1]); 
 } 
  
+// The filter is written without the sign tests on detleft and detright
+// of the original: when the two products differ in sign (or one is
+// zero), |det| is their absolute sum and always exceeds the bound, so a
+// single comparison decides the same cases. When it fails, the absolute
+// sum is the `detsum' the original passed to orient2dadapt().
 REAL Predicates::orient2d(const REAL *pa, const REAL *pb, const REAL *pc)
 { 
   SET_DOUBLE_PRECISION_MODE;
   REAL detleft, detright, det; 
-  REAL detsum, errbound; 
+  REAL detsum; 
+  unsigned long * const slot = counterSlot();
  
+  ++slot[2*kOrient2d];
   detleft = (pa[0] - pc[0]) * (pb[1] - pc[1]); 
   detright = (pa[1] - pc[1]) * (pb[0] - pc[0]); 
   det = detleft - detright; 
+  detsum = fabs(detleft) + fabs(detright);
  
-  if (detleft > 0.0)
-  { 
-    if (detright <= 0.0) return det; 
-    else detsum = detleft + detright;
-  }
-  else if (detleft < 0.0)
-  { 
-    if (detright >= 0.0) return det; 
-    else detsum = -detleft - detright; 
-  }
-  else return det;
-  
-  errbound = ccwerrboundA * detsum; 
-  if ((det >= errbound) || (-det >= errbound))
-  { 
-    return det; 
-  } 
- 
+  if (fabs(det) >= ccwerrboundA * detsum) return det;
+
+  ++slot[2*kOrient2d+1];
   return orient2dadapt(pa, pb, pc, detsum); 
 } 
+
+/*****************************************************************************/ 
+/*                                                                           */ 
+/*  orient2dBatch()   n orientation tests at once.                           */ 
+/*                                                                           */ 
+/*  pa, pb and pc hold n points each, packed as x0,y0,x1,y1,...; det[i] is   */ 
+/*  set to orient2d(pa+2i, pb+2i, pc+2i).  The points are taken a chunk at   */ 
+/*  a time: the first loop over a chunk is the filter alone, straight-line   */ 
+/*  arithmetic the compiler can vectorize; the second sends the tests it    */ 
+/*  could not decide to orient2dadapt().  det must not overlap the inputs.   */ 
+/*                                                                           */ 
+/*****************************************************************************/ 
+
+void Predicates::orient2dBatch( int n, const REAL *pa, const REAL *pb,
+                                const REAL *pc, REAL *det )
+{
+  SET_DOUBLE_PRECISION_MODE;
+  enum { kChunk = 256 };
+  REAL detsum[kChunk];
+  bool decided[kChunk];
+  const REAL errboundA = ccwerrboundA;
+  unsigned long * const slot = counterSlot();
+
+  slot[2*kOrient2d] += n;
+  for( int i0=0; i0<n; i0+=kChunk )
+  {
+    const int m = ( n-i0 < kChunk ) ? n-i0 : kChunk;
+    const REAL * const a = pa + 2*i0;
+    const REAL * const b = pb + 2*i0;
+    const REAL * const c = pc + 2*i0;
+    REAL * const d = det + i0;
+#if defined(_OPENMP) && _OPENMP >= 201307
+#pragma omp simd
+#endif
+    for( int j=0; j<m; ++j )
+    {
+      const REAL detleft = (a[2*j] - c[2*j]) * (b[2*j+1] - c[2*j+1]);
+      const REAL detright = (a[2*j+1] - c[2*j+1]) * (b[2*j] - c[2*j]);
+      d[j] = detleft - detright;
+      detsum[j] = fabs(detleft) + fabs(detright);
+      decided[j] = fabs(d[j]) >= errboundA * detsum[j];
+    }
+    for( int j=0; j<m; ++j )
+      if( !decided[j] )
+      {
+        ++slot[2*kOrient2d+1];
+        d[j] = orient2dadapt( a+2*j, b+2*j, c+2*j, detsum[j] );
+      }
+  }
+}
  
  
 /*****************************************************************************/ 
@@ -1848,6 +1996,8 @@ REAL Predicates::incircleadapt(const REAL *pa, const REAL *pb, const REAL *pc, c
 REAL Predicates::incircle(const REAL *pa, const REAL *pb, const REAL *pc, const REAL *pd)
 { 
   SET_DOUBLE_PRECISION_MODE;
+  unsigned long * const slot = counterSlot();
+  ++slot[2*kIncircle];
   REAL adx, bdx, cdx, ady, bdy, cdy; 
   REAL bdxcdy, cdxbdy, cdxady, adxcdy, adxbdy, bdxady; 
   REAL alift, blift, clift; 
@@ -1885,6 +2035,8 @@ REAL Predicates::incircle(const REAL *pa, const REAL *pb, const REAL *pc, const
     return det; 
   } 
  
+  ++slot[2*kIncircle+1];
   return incircleadapt(pa, pb, pc, pd, permanent); 
 } 
+
  
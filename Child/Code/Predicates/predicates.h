@@ -140,6 +140,7 @@
 #include <math.h> 
 
 #include <float.h>
+#include <vector>
 
 // temp
 //#define PC_53 2
@@ -234,7 +235,7 @@ class Predicates
 {
 public:
    Predicates(); // just calls exactinit()
-   ~Predicates() {} // doesn't do anything
+   ~Predicates(); // frees the counter blocks
    
 private:
    // basically the constructor:
@@ -289,8 +290,36 @@ public:
    REAL incircleadapt(const REAL *pa, const REAL *pb, const REAL *pc, const REAL *pd,
                       REAL permanent);
    REAL incircle(const REAL *pa, const REAL *pb, const REAL *pc, const REAL *pd);
-   
+
+   // batched version of orient2d(): evaluates n
+   // independent tests on points packed as x0,y0,x1,y1,...; the
+   // floating-point filter is applied to the whole batch in one
+   // vectorizable loop and only the tests it cannot decide go to the
+   // adaptive (exact) path. Results are identical to n single calls.
+   void orient2dBatch( int n, const REAL *pa, const REAL *pb, const REAL *pc,
+                       REAL *det );
+
+   // counts of tests made, and of tests the filter could not decide
+   // (i.e., that went to the exact arithmetic), for each predicate:
+   enum { kOrient2d, kIncircle, kNumCountedPredicates };
+   void ResetCounters();
+   unsigned long getCallCount( int which ) const;
+   unsigned long getExactCount( int which ) const;
+   void ReportCounters() const;
+
 private:
+   Predicates( const Predicates & );
+   Predicates &operator=( const Predicates & );
+
+   // one block of counters for each thread that has made a test, as
+   // long as two cache lines and aligned to one, so that the counters
+   // of two threads do not share a cache line:
+   enum { kCounterSlotSize = 16, kCacheLineSize = 64 };
+   std::vector< unsigned long * > counterBlocks;
+   std::vector< char * > counterStorage;  // blocks as allocated
+   unsigned long counterSerial;  // tells the blocks of this object apart
+   unsigned long *counterSlot();
+
    REAL splitter;     /* = 2^ceiling(p / 2) + 1.  Used to split floats in half. */ 
    REAL epsilon;                /* = 2^(-p).  Used to estimate roundoff errors. */ 
 /* A set of coefficients used to calculate maximum roundoff errors.          */ 
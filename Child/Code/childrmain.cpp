@@ -156,7 +156,7 @@ int main( int argc, char **argv )
       if( time.CheckOutputTime() )
           output.WriteOutput( time.getCurrentTime() );
 
-      if( output.OptTSOutput() ) output.WriteTSOutput();
+      if( output.OptTSOutput() ) output.WriteTSOutput( time.getCurrentTime() );
 
    } // end of main loop
 
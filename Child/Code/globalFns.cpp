@@ -770,6 +770,116 @@ double DistanceBW2Points(double x1, double y1, double x2, double y2)
    return sqrt((x1-x2)*(x1-x2)+(y1-y2)*(y1-y2));
 }
 
+/*****************************************************************************\
+**
+**      HilbertIndex: returns the position of cell (ix,iy) along a Hilbert
+**              curve filling a 2^order by 2^order grid (order <= 16).
+**              Points sorted on this index are close together in the
+**              plane when they are close together in the sort, which
+**              is what mesh walks and cache lines both want.
+**
+**      Called by: tMesh::AddNodes
+**
+\*****************************************************************************/
+unsigned long HilbertIndex( unsigned ix, unsigned iy, int order )
+{
+   assert( order > 0 && order <= 16 );
+   const unsigned n = 1u << order;
+   unsigned long d = 0;
+   for( unsigned s = n/2; s > 0; s /= 2 )
+   {
+      const unsigned rx = ( ix & s ) ? 1 : 0;
+      const unsigned ry = ( iy & s ) ? 1 : 0;
+      d += static_cast<unsigned long>(s) * s * ( ( 3 * rx ) ^ ry );
+      // rotate the quadrant so the sub-curve enters and leaves correctly
+      if( ry == 0 )
+      {
+         if( rx == 1 )
+         {
+            ix = n - 1 - ix;
+            iy = n - 1 - iy;
+         }
+         const unsigned t = ix;
+         ix = iy;
+         iy = t;
+      }
+   }
+   return d;
+}
+
+/*****************************************************************************\
+**
+**      PolynomialRoots: finds the real roots that lie in [lo,hi] of the
+**              polynomial c[0] + c[1] t + ... + c[degree] t^degree
+**              (degree <= 4), puts them in roots in increasing order,
+**              and returns how many there are. The roots of the
+**              derivative (found the same way) split [lo,hi] into
+**              pieces on which the polynomial is monotonic, so a piece
+**              holds a root if and only if the polynomial changes sign
+**              across it; the root is then narrowed down by bisection
+**              to within 2^-64 of the interval. Roots are not missed however close
+**              together they are; a double root, where the sign does
+**              not change, may be.
+**
+**      Called by: tMesh::KineticFlipTime
+**
+\*****************************************************************************/
+static double PolynomialValue( double const *c, int degree, double t )
+{
+   double v = c[degree];
+   for( int k = degree-1; k >= 0; --k ) v = v*t + c[k];
+   return v;
+}
+
+int PolynomialRoots( double const *c, int degree, double lo, double hi,
+                     double *roots )
+{
+   assert( degree <= 4 );
+   while( degree > 0 && c[degree] == 0. ) --degree;
+   if( degree == 0 || !( lo <= hi ) ) return 0;
+   if( degree == 1 )
+   {
+      const double r = -c[0] / c[1];
+      if( r < lo || r > hi ) return 0;
+      roots[0] = r;
+      return 1;
+   }
+
+   // ends of the monotonic pieces
+   double dc[4], ends[5];
+   for( int k = 1; k <= degree; ++k ) dc[k-1] = k * c[k];
+   int nends = 1;
+   ends[0] = lo;
+   nends += PolynomialRoots( dc, degree-1, lo, hi, ends+1 );
+   ends[nends++] = hi;
+
+   int nroots = 0;
+   for( int i = 0; i+1 < nends && nroots < degree; ++i )
+   {
+      double a = ends[i], b = ends[i+1];
+      const double fa = PolynomialValue( c, degree, a );
+      const double fb = PolynomialValue( c, degree, b );
+      if( fa == 0. )
+      {
+         if( nroots == 0 || roots[nroots-1] != a ) roots[nroots++] = a;
+         continue;
+      }
+      if( fb == 0. || ( fa < 0. ) == ( fb < 0. ) ) continue;
+      for( int j = 0; j < 64; ++j )
+      {
+         const double m = 0.5 * ( a + b );
+         if( m <= a || m >= b ) break;
+         if( ( PolynomialValue( c, degree, m ) < 0. ) == ( fa < 0. ) ) a = m;
+         else b = m;
+      }
+      roots[nroots++] = a;
+   }
+   if( nroots < degree && PolynomialValue( c, degree, hi ) == 0. &&
+       ( nroots == 0 || roots[nroots-1] != hi ) )
+      roots[nroots++] = hi;
+   return nroots;
+}
+
 /*****************************************************************************\
 **
 **      DistanceToLine: given x,y coords, finds distance to the line
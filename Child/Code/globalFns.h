@@ -102,6 +102,12 @@ double PlaneFit(double tx, double ty, tTriangle* tri );
 double LineFit(double x1, double y1, double x2, double y2, double nx);
 
 double DistanceBW2Points(double x1, double y1, double x2, double y2 );
+// position of grid cell (ix,iy) along a Hilbert curve of the given order
+unsigned long HilbertIndex( unsigned ix, unsigned iy, int order );
+
+// real roots in [lo,hi] of the polynomial c[0] + c[1] t + ... (degree <= 4)
+int PolynomialRoots( double const *c, int degree, double lo, double hi,
+                     double *roots );
 
 double DistanceToLine( double x2, double y2, double a, double b, double c );
 
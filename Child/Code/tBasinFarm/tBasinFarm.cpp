@@ -0,0 +1,158 @@
+/***************************************************************************/
+/**
+**  @file tBasinFarm.cpp
+**  @brief Functions for tBasinFarm (see tBasinFarm.h).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#include <assert.h>
+#ifdef CHILD_USE_MPI
+# include <mpi.h>
+#endif
+
+#include "tBasinFarm.h"
+#include "../tStreamNet/tStreamNet.h"
+
+void tBasinFarm::Initialize( int *argc, char ***argv )
+{
+#ifdef CHILD_USE_MPI
+  MPI_Init( argc, argv );
+#else
+  (void) argc;
+  (void) argv;
+#endif
+}
+
+void tBasinFarm::Finalize()
+{
+#ifdef CHILD_USE_MPI
+  int initialized;
+  MPI_Initialized( &initialized );
+  if( initialized ) MPI_Finalize();
+#endif
+}
+
+int tBasinFarm::Rank()
+{
+  int rank = 0;
+#ifdef CHILD_USE_MPI
+  int initialized;
+  MPI_Initialized( &initialized );
+  if( initialized ) MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+#endif
+  return rank;
+}
+
+int tBasinFarm::Size()
+{
+  int size = 1;
+#ifdef CHILD_USE_MPI
+  int initialized;
+  MPI_Initialized( &initialized );
+  if( initialized ) MPI_Comm_size( MPI_COMM_WORLD, &size );
+#endif
+  return size;
+}
+
+// Seeds drawn from the clock differ between processes, whose copies of
+// the model would then drift apart; they all take process 0's.
+unsigned tBasinFarm::CommonSeed( unsigned seed )
+{
+#ifdef CHILD_USE_MPI
+  if( Size() > 1 )
+    MPI_Bcast( &seed, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD );
+#endif
+  return seed;
+}
+
+/***************************************************************************\
+ **
+ **  tBasinFarm::AssignBasins
+ **
+ **  Gives each outlet basin to a process: going from the largest basin
+ **  to the smallest, each goes to the process with the fewest nodes so
+ **  far (the lowest-numbered in a tie). owner[b] is the process of basin
+ **  number b. Every process computes the same assignment.
+ **
+ \***************************************************************************/
+void tBasinFarm::AssignBasins( tStreamNet const *strmNet,
+                                  std::vector< int > &owner )
+{
+  const int nbasins = strmNet->getNumBasins();
+  const int nprocs = Size();
+  std::vector< long > load( nprocs, 0 );
+
+  owner.assign( nbasins, 0 );
+  for( int k=0; k<nbasins; ++k )
+  {
+    const int b = strmNet->getBasinByRank( k );
+    int r = 0;
+    for( int q=1; q<nprocs; ++q )
+      if( load[q] < load[r] ) r = q;
+    owner[b] = r;
+    load[r] += strmNet->getBasinSize( b );
+  }
+}
+
+/***************************************************************************\
+ **
+ **  tBasinFarm::ExchangeBasins
+ **
+ **  After each process has eroded its own basins (see AssignBasins),
+ **  gathers the state of their nodes (tLNode::PackErosionState) from every
+ **  process to every process. The basins, and the nodes in each, are taken
+ **  in the same order when packing and unpacking, so no node IDs need to
+ **  be sent.
+ **
+ \***************************************************************************/
+void tBasinFarm::ExchangeBasins( tStreamNet const *strmNet,
+                                    std::vector< int > const &owner )
+{
+#ifdef CHILD_USE_MPI
+  const int nprocs = Size();
+  if( nprocs < 2 ) return;
+  const int rank = Rank();
+  const int nbasins = strmNet->getNumBasins();
+  int k, i, r;
+
+  std::vector< double > mine;
+  for( k=0; k<nbasins; ++k )
+  {
+    const int b = strmNet->getBasinByRank( k );
+    if( owner[b] != rank ) continue;
+    tLNode * const *nodes = strmNet->getBasinNodes( b );
+    for( i=0; i<strmNet->getBasinSize( b ); ++i )
+      nodes[i]->PackErosionState( mine );
+  }
+
+  int count = static_cast< int >( mine.size() );
+  std::vector< int > counts( nprocs ), displs( nprocs+1, 0 );
+  MPI_Allgather( &count, 1, MPI_INT, &counts[0], 1, MPI_INT,
+                 MPI_COMM_WORLD );
+  for( r=0; r<nprocs; ++r ) displs[r+1] = displs[r] + counts[r];
+  std::vector< double > all( displs[nprocs] > 0 ? displs[nprocs] : 1 );
+  MPI_Allgatherv( mine.empty() ? 0 : &mine[0], count, MPI_DOUBLE,
+                  &all[0], &counts[0], &displs[0], MPI_DOUBLE,
+                  MPI_COMM_WORLD );
+
+  for( r=0; r<nprocs; ++r )
+  {
+    if( r == rank ) continue;
+    double const *p = &all[0] + displs[r];
+    for( k=0; k<nbasins; ++k )
+    {
+      const int b = strmNet->getBasinByRank( k );
+      if( owner[b] != r ) continue;
+      tLNode * const *nodes = strmNet->getBasinNodes( b );
+      for( i=0; i<strmNet->getBasinSize( b ); ++i )
+        p = nodes[i]->UnpackErosionState( p );
+    }
+    assert( p == &all[0] + displs[r+1] );
+  }
+#else
+  (void) strmNet;
+  (void) owner;
+#endif
+}
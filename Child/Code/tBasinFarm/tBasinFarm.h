@@ -0,0 +1,51 @@
+//-*-c++-*-
+
+/***************************************************************************/
+/**
+**  @file tBasinFarm.h
+**  @brief Header for tBasinFarm, which farms out the outlet basins of
+**         basin-parallel erosion to MPI processes.
+**
+**  When CHILD is built with CHILD_USE_MPI and started with mpirun, each
+**  process runs the whole model on its own copy of the mesh. The copies
+**  stay identical because the model is deterministic, given the same
+**  input and random seed. The outlet basins of basin-parallel
+**  detachment-limited erosion (OPT_BASIN_PARALLEL) are shared out: each
+**  basin is eroded by one process, which then sends the new state of its
+**  nodes to the others. Results are the same as with a single process.
+**  Only process 0 writes output.
+**
+**  The mesh is replicated, not partitioned, and there are no halo (ghost
+**  node) exchanges: every process needs the memory of a serial run, and
+**  mesh updates, flow routing, diffusion and output are repeated on
+**  every process. Only the basin erosion gets faster, so this does not
+**  let a mesh too large for one machine be run on several.
+**
+**  Without MPI, or if MPI has not been initialized (e.g., when CHILD is
+**  used as a library), there is a single process and nothing is done.
+*/
+/***************************************************************************/
+
+#ifndef TBASINFARM_H
+#define TBASINFARM_H
+
+#include <vector>
+
+class tStreamNet;
+
+class tBasinFarm
+{
+public:
+  static void Initialize( int *argc, char ***argv ); // starts MPI
+  static void Finalize();                            // stops MPI
+  static int Rank();  // number of this process, from 0 to Size()-1
+  static int Size();  // number of processes
+  static unsigned CommonSeed( unsigned ); // process 0's seed, on all
+  // process that erodes each outlet basin of the stream network
+  static void AssignBasins( tStreamNet const *, std::vector< int > &owner );
+  // copy the nodes of each basin from its process to all the others
+  static void ExchangeBasins( tStreamNet const *,
+                              std::vector< int > const &owner );
+};
+
+#endif
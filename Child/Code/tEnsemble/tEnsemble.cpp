@@ -0,0 +1,247 @@
+/***************************************************************************/
+/**
+**  @file tEnsemble.cpp
+**  @brief Functions for tEnsemble (see tEnsemble.h).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+#include "tEnsemble.h"
+#include "../errors/errors.h"
+
+/**************************************************************************\
+**
+**  tEnsemble constructor
+**
+**  Reads the ensemble parameters from the input file and initializes
+**  the base model, without output:
+**    ENSEMBLE_SIZE - number of members (if zero or absent, one per row
+**                    of the ENSEMBLE_PARAMETERS table)
+**    ENSEMBLE_THREADS - number of members run at once (zero or absent:
+**                    as many as OpenMP would use by default)
+**    ENSEMBLE_PARAMETERS - name of a table of parameter values, optional
+**
+\**************************************************************************/
+tEnsemble::tEnsemble( const char *inputFileName ) :
+  infile( inputFileName ),
+  base(),
+  outName(),
+  nMembers( 0 ),
+  nThreads( 1 ),
+  seed( 0 ),
+  keys(),
+  values()
+{
+  outName = infile.ReadString( "OUTFILENAME" );
+  seed = infile.ReadLong( "SEED" );
+  if( infile.Contain( "ENSEMBLE_PARAMETERS" ) )
+    ReadParameterTable( infile.ReadString( "ENSEMBLE_PARAMETERS" ) );
+  nMembers = infile.ReadInt( "ENSEMBLE_SIZE", false );
+  if( nMembers <= 0 )
+    nMembers = static_cast<int>( values.size() );
+  if( nMembers <= 0 )
+    ReportFatalError( "ENSEMBLE_SIZE must be greater than zero." );
+  if( !keys.empty() && static_cast<int>( values.size() ) < nMembers )
+    ReportFatalError( "ENSEMBLE_PARAMETERS has fewer rows than "
+                      "ENSEMBLE_SIZE." );
+#ifdef _OPENMP
+  nThreads = infile.ReadInt( "ENSEMBLE_THREADS", false );
+  if( nThreads <= 0 )
+    nThreads = omp_get_max_threads();
+#endif
+
+  std::string arguments( "--silent-mode --no-write-mode " );
+  arguments.append( inputFileName );
+  base.Initialize( arguments );
+}
+
+/**************************************************************************\
+**
+**  tEnsemble::ReadParameterTable
+**
+**  Reads the table of parameter values. The first line gives the
+**  input-file keywords of the parameters, and each line after it the
+**  values for one member, in order. A SEED column replaces the default
+**  seed, SEED + member number. Blank lines and lines starting with '#'
+**  are skipped.
+**
+\**************************************************************************/
+void tEnsemble::ReadParameterTable( std::string const &fileName )
+{
+  std::ifstream table( fileName.c_str() );
+  if( !table.good() )
+  {
+    std::cerr << "tEnsemble: unable to open '" << fileName << "'.\n";
+    ReportFatalError( "Check ENSEMBLE_PARAMETERS." );
+  }
+  std::string line;
+  while( std::getline( table, line ) )
+  {
+    std::istringstream words( line );
+    std::string word;
+    if( !( words >> word ) || word[0] == '#' ) continue;
+    if( keys.empty() )
+    {
+      do keys.push_back( word ); while( words >> word );
+      continue;
+    }
+    std::vector< double > row;
+    do row.push_back( atof( word.c_str() ) ); while( words >> word );
+    if( row.size() != keys.size() )
+    {
+      std::cerr << "tEnsemble: row " << values.size()+1 << " of '"
+                << fileName << "' has " << row.size() << " values for "
+                << keys.size() << " parameters.\n";
+      ReportFatalError( "Check ENSEMBLE_PARAMETERS." );
+    }
+    values.push_back( row );
+  }
+}
+
+/**************************************************************************\
+**
+**  tEnsemble::MemberName
+**
+**  Returns the output name of member k (1 to nMembers): OUTFILENAME,
+**  an underscore and k, padded with zeros to the same width for all
+**  members (at least three digits).
+**
+\**************************************************************************/
+std::string tEnsemble::MemberName( int k ) const
+{
+  int width = 3;
+  for( int n = nMembers; n >= 1000; n /= 10 )
+    ++width;
+  std::ostringstream name;
+  name << outName << '_' << std::setw( width ) << std::setfill( '0' ) << k;
+  return name.str();
+}
+
+/**************************************************************************\
+**
+**  tEnsemble::WriteMemberTable
+**
+**  Writes OUTFILENAME.ensemble: a line for each member with its output
+**  name, seed and parameter values.
+**
+\**************************************************************************/
+void tEnsemble::WriteMemberTable() const
+{
+  const std::string fileName = outName + ".ensemble";
+  std::ofstream table( fileName.c_str() );
+  if( !table.good() )
+  {
+    std::cerr << "Warning: unable to create ensemble table '"
+              << fileName << "'\n";
+    return;
+  }
+  table << "# member seed";
+  for( size_t j = 0; j < keys.size(); ++j )
+    if( keys[j] != "SEED" )
+      table << ' ' << keys[j];
+  table << '\n' << std::setprecision( 10 );
+  for( int k = 1; k <= nMembers; ++k )
+  {
+    long memberSeed = seed + k;
+    for( size_t j = 0; j < keys.size(); ++j )
+      if( keys[j] == "SEED" )
+        memberSeed = static_cast<long>( values[k-1][j] );
+    table << MemberName( k ) << ' ' << memberSeed;
+    for( size_t j = 0; j < keys.size(); ++j )
+      if( keys[j] != "SEED" )
+        table << ' ' << values[k-1][j];
+    table << '\n';
+  }
+}
+
+/**************************************************************************\
+**
+**  tEnsemble::SetOutputName
+**
+**  Sets OUTFILENAME in the input file, which the output objects read
+**  when they are created.
+**
+\**************************************************************************/
+void tEnsemble::SetOutputName( std::string const &name )
+{
+  tArray< tKeyPair > &table = infile.GetKeyWordTableRef();
+  for( size_t i = 0; i < table.getSize(); ++i )
+    if( strcmp( table[i].key(), "OUTFILENAME" ) == 0 )
+      table[i].setValue( name.c_str() );
+}
+
+/**************************************************************************\
+**
+**  tEnsemble::RunMember
+**
+**  Copies the base model, gives the copy the seed and parameter values
+**  of member k and its own output, writes its initial state and runs it
+**  to the end of the run.
+**
+\**************************************************************************/
+void tEnsemble::RunMember( int k )
+{
+  childInterface *member = new childInterface;
+  const std::string name = MemberName( k );
+#ifdef _OPENMP
+#pragma omp critical(tEnsemble)
+#endif
+  {
+    member->Initialize_Copy( base );
+    member->SetParameter( "SEED", static_cast<double>( seed + k ) );
+    for( size_t j = 0; j < keys.size(); ++j )
+      if( !member->SetParameter( keys[j], values[k-1][j] ) )
+      {
+        std::cerr << "tEnsemble: parameter '" << keys[j]
+                  << "' cannot be set in an ensemble member.\n";
+        ReportFatalError( "Check ENSEMBLE_PARAMETERS." );
+      }
+    SetOutputName( name );
+    member->setWriteOption( true, infile );
+    SetOutputName( outName );
+    member->WriteChildStyleOutput();
+    std::cout << "Ensemble member " << name << " started" << std::endl;
+  }
+  member->Run( 0 );
+  delete member;
+#ifdef _OPENMP
+#pragma omp critical(tEnsemble)
+#endif
+  std::cout << "Ensemble member " << name << " done" << std::endl;
+}
+
+/**************************************************************************\
+**
+**  tEnsemble::Run
+**
+**  Writes the member table and runs every member, nThreads at a time.
+**  Members are handed out one by one, so that threads that finish a
+**  short member take up the next.
+**
+\**************************************************************************/
+void tEnsemble::Run()
+{
+  WriteMemberTable();
+  const time_t start = time( 0 );
+  std::cout << "Running " << nMembers << " ensemble members on "
+            << nThreads << " thread(s)" << std::endl;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) num_threads(nThreads)
+#endif
+  for( int k = 1; k <= nMembers; ++k )
+    RunMember( k );
+  std::cout << "Ensemble done in " << difftime( time( 0 ), start )
+            << " s" << std::endl;
+}
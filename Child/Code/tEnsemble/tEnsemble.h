@@ -0,0 +1,65 @@
+//-*-c++-*-
+
+/***************************************************************************/
+/**
+**  @file tEnsemble.h
+**  @brief Header for tEnsemble, which runs an ensemble of realizations of
+**         one model in a single process.
+**
+**  The members of a Monte Carlo ensemble usually differ only in their
+**  random seed and a few parameters. Rather than have each of them read
+**  the input file and build the same initial mesh again, tEnsemble
+**  initializes the model once (the "base", which writes nothing) and
+**  makes each member a copy of it with childInterface::Initialize_Copy.
+**  Each member then gets its own seed, its parameter values (see
+**  childInterface::SetParameter) and its own output files, named
+**  OUTFILENAME_<member>, and is run to the end of the run.
+**
+**  Members are run by a pool of ENSEMBLE_THREADS OpenMP threads (when
+**  built with CHILD_USE_OPENMP; one after the other otherwise). A member
+**  is copied when a thread takes it up and deleted when it is done, so
+**  memory grows with the number of threads rather than the number of
+**  members. Copying and setting up output are done one member at a
+**  time, as Initialize_Copy briefly renumbers the base mesh (see
+**  tMesh::RelinkCopiedElements) and the output names are set in the
+**  shared input file.
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#ifndef TENSEMBLE_H
+#define TENSEMBLE_H
+
+#include <string>
+#include <vector>
+#include "../ChildInterface/childInterface.h"
+
+class tEnsemble
+{
+  tEnsemble( const tEnsemble & );
+  tEnsemble &operator=( const tEnsemble & );
+public:
+  explicit tEnsemble( const char *inputFileName );
+
+  int getSize() const { return nMembers; }
+  void Run();              // runs every member to the end of the run
+
+private:
+  void ReadParameterTable( std::string const &fileName );
+  void WriteMemberTable() const;
+  std::string MemberName( int ) const;
+  void RunMember( int );
+  void SetOutputName( std::string const & );
+
+  tInputFile infile;
+  childInterface base;     // initial state, copied by every member
+  std::string outName;     // OUTFILENAME
+  int nMembers;            // ENSEMBLE_SIZE
+  int nThreads;            // ENSEMBLE_THREADS
+  long seed;               // SEED; member k uses SEED+k unless given
+  std::vector< std::string > keys;            // ENSEMBLE_PARAMETERS columns
+  std::vector< std::vector< double > > values; // one row per member
+};
+
+#endif
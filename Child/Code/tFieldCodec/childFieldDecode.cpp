@@ -0,0 +1,46 @@
+/**************************************************************************/
+/**
+**  childFieldDecode.cpp: writes the text output file held in a file
+**  written with OPT_COMPRESS_OUTPUT (see tFieldCodec), exactly as CHILD
+**  would have written it without the option.
+**
+**  Usage: childFieldDecode <name><ext>.fz [<text file>]
+**
+**  The text file defaults to <name><ext> (e.g. bench.z.fz gives bench.z).
+**
+**  Created 10/2026
+*/
+/**************************************************************************/
+
+#include <iostream>
+#include <string>
+#include "tFieldCodec.h"
+
+int main( int argc, char **argv )
+{
+  if( argc != 2 && argc != 3 )
+  {
+    std::cerr << "Usage: " << argv[0]
+              << " <name><ext>.fz [<text file>]" << std::endl;
+    return 1;
+  }
+  const std::string fileName( argv[1] );
+  std::string textFileName;
+  if( argc == 3 )
+    textFileName = argv[2];
+  else
+  {
+    const std::string::size_type n = fileName.size();
+    if( n < 4 || fileName.compare( n-3, 3, ".fz" ) != 0 )
+    {
+      std::cerr << argv[0] << ": '" << fileName
+                << "' does not end in .fz; give the text file name"
+                << std::endl;
+      return 1;
+    }
+    textFileName = fileName.substr( 0, n-3 );
+  }
+  if( !tFieldCodec::DecodeFile( fileName.c_str(), textFileName.c_str() ) )
+    return 1;
+  return 0;
+}
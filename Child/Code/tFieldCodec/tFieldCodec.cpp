@@ -0,0 +1,592 @@
+/***************************************************************************/
+/**
+**  @file tFieldCodec.cpp
+**  @brief Functions for tFieldCodec and tFieldOStream (see tFieldCodec.h).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+
+#include "tFieldCodec.h"
+
+namespace
+{
+  const char kMagic[8] = { 'C','H','F','I','E','L','D','Z' };
+  const int kVersion = 1;
+  const int kVersionSwapped = 0x01000000;  // kVersion read in the other order
+  const int kPlanes = sizeof( double );
+
+  template< class T >
+  void WriteValue( std::ofstream &ofs, T const &value )
+  {
+    ofs.write( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+  }
+
+  template< class T >
+  void ReadValue( std::ifstream &ifs, T &value )
+  {
+    ifs.read( reinterpret_cast< char * >( &value ), sizeof( T ) );
+  }
+
+  // Adaptive binary range coder, with 11-bit probabilities (of a 0) as
+  // in LZMA. The encoder propagates carries into the bytes it has
+  // already written, so that low fits in 32 bits.
+  enum { kProbBits = 11, kProbOne = 1 << kProbBits, kMoveBits = 5,
+	 kTop = 1 << 24 };
+
+  class tRangeEncoder
+  {
+  public:
+    explicit tRangeEncoder( std::vector< unsigned char > &out_ ) :
+      out( out_ ), low( 0 ), range( 0xFFFFFFFFu )
+    { out.clear(); }
+
+    void EncodeBit( unsigned short &prob, int bit )
+    {
+      const unsigned bound = ( range >> kProbBits ) * prob;
+      if( bit == 0 )
+	{
+	  range = bound;
+	  prob += ( kProbOne - prob ) >> kMoveBits;
+	}
+      else
+	{
+	  const unsigned newLow = low + bound;
+	  if( newLow < low )
+	    Carry();
+	  low = newLow;
+	  range -= bound;
+	  prob -= prob >> kMoveBits;
+	}
+      while( range < kTop )
+	{
+	  out.push_back( static_cast< unsigned char >( low >> 24 ) );
+	  low <<= 8;
+	  range <<= 8;
+	}
+    }
+
+    void Finish()
+    {
+      for( int i = 0; i < 4; ++i )
+	{
+	  out.push_back( static_cast< unsigned char >( low >> 24 ) );
+	  low <<= 8;
+	}
+    }
+
+  private:
+    void Carry()
+    {
+      size_t i = out.size();
+      while( i > 0 && out[i-1] == 0xFF )
+	out[--i] = 0;
+      if( i > 0 )
+	++out[i-1];
+    }
+
+    std::vector< unsigned char > &out;
+    unsigned low, range;
+  };
+
+  class tRangeDecoder
+  {
+  public:
+    tRangeDecoder( const unsigned char *in_, const unsigned char *end_ ) :
+      in( in_ ), end( end_ ), code( 0 ), range( 0xFFFFFFFFu )
+    {
+      for( int i = 0; i < 4; ++i )
+	code = ( code << 8 ) | Next();
+    }
+
+    int DecodeBit( unsigned short &prob )
+    {
+      const unsigned bound = ( range >> kProbBits ) * prob;
+      int bit;
+      if( code < bound )
+	{
+	  range = bound;
+	  prob += ( kProbOne - prob ) >> kMoveBits;
+	  bit = 0;
+	}
+      else
+	{
+	  code -= bound;
+	  range -= bound;
+	  prob -= prob >> kMoveBits;
+	  bit = 1;
+	}
+      while( range < kTop )
+	{
+	  code = ( code << 8 ) | Next();
+	  range <<= 8;
+	}
+      return bit;
+    }
+
+  private:
+    unsigned Next() { return in < end ? *in++ : 0; }
+
+    const unsigned char *in, *end;
+    unsigned code, range;
+  };
+
+  // A byte is coded as 8 bits down a binary tree of 255 probabilities,
+  // one tree for each value of the byte before it in the plane.
+  void ResetModel( std::vector< unsigned short > &model )
+  {
+    model.assign( 256*256, kProbOne/2 );
+  }
+
+  void EncodePlane( const unsigned char *plane, size_t n,
+		    std::vector< unsigned short > &model,
+		    std::vector< unsigned char > &out )
+  {
+    ResetModel( model );
+    tRangeEncoder rc( out );
+    unsigned context = 0;
+    for( size_t i = 0; i < n; ++i )
+      {
+	unsigned short *tree = &model[context << 8];
+	const unsigned byte = plane[i];
+	unsigned node = 1;
+	for( int b = 7; b >= 0; --b )
+	  {
+	    const int bit = ( byte >> b ) & 1;
+	    rc.EncodeBit( tree[node], bit );
+	    node = ( node << 1 ) | bit;
+	  }
+	context = byte;
+      }
+    rc.Finish();
+  }
+
+  void DecodePlane( const unsigned char *in, size_t nIn,
+		    std::vector< unsigned short > &model,
+		    unsigned char *plane, size_t n )
+  {
+    ResetModel( model );
+    tRangeDecoder rc( in, in + nIn );
+    unsigned context = 0;
+    for( size_t i = 0; i < n; ++i )
+      {
+	unsigned short *tree = &model[context << 8];
+	unsigned node = 1;
+	while( node < 256 )
+	  node = ( node << 1 ) | rc.DecodeBit( tree[node] );
+	plane[i] = static_cast< unsigned char >( node );
+	context = plane[i];
+      }
+  }
+}
+
+tFieldCodec::tFieldCodec() :
+  previous(), current(), planes(), coded(), model()
+{}
+
+/**************************************************************************\
+**
+**  tFieldCodec::WriteHeader
+**
+**  Writes the magic string and version that begin a compressed file.
+**
+\**************************************************************************/
+void tFieldCodec::WriteHeader( std::ofstream &ofs )
+{
+  ofs.write( kMagic, sizeof( kMagic ) );
+  WriteValue( ofs, kVersion );
+}
+
+/**************************************************************************\
+**
+**  tFieldCodec::WriteSlice
+**
+**  Codes one slice (the layout of its text and its numbers) and writes
+**  it to ofs. The numbers are kept for coding the next slice.
+**
+\**************************************************************************/
+void tFieldCodec::WriteSlice( std::ofstream &ofs, int precision,
+			      std::vector< tLineRun > const &layout,
+			      std::vector< double > const &values )
+{
+  WriteValue( ofs, precision );
+  const int nRuns = static_cast< int >( layout.size() );
+  WriteValue( ofs, nRuns );
+  for( int r = 0; r < nRuns; ++r )
+    {
+      const int length = static_cast< int >( layout[r].pattern.size() );
+      WriteValue( ofs, layout[r].count );
+      WriteValue( ofs, length );
+      ofs.write( layout[r].pattern.data(), length );
+    }
+
+  const size_t n = values.size();
+  WriteValue( ofs, static_cast< int >( n ) );
+  current.resize( kPlanes*n );
+  if( n > 0 )
+    memcpy( &current[0], &values[0], kPlanes*n );
+  const char mode = ( n > 0 && previous.size() == current.size() ) ?
+    char( kDelta ) : char( kKeyframe );
+  WriteValue( ofs, mode );
+
+  // XOR with the reference, and split into planes
+  planes.resize( kPlanes*n );
+  for( size_t i = 0; i < n; ++i )
+    for( int p = 0; p < kPlanes; ++p )
+      {
+	const unsigned char reference =
+	  mode == kDelta ? previous[kPlanes*i+p] :
+	  i > 0 ? current[kPlanes*(i-1)+p] : 0;
+	planes[p*n+i] = current[kPlanes*i+p] ^ reference;
+      }
+  previous.swap( current );
+
+  for( int p = 0; p < kPlanes; ++p )
+    {
+      const unsigned char *plane = n > 0 ? &planes[p*n] : 0;
+      size_t i = 0;
+      while( i < n && plane[i] == 0 )
+	++i;
+      if( i == n )
+	{
+	  WriteValue( ofs, 0 );
+	  continue;
+	}
+      EncodePlane( plane, n, model, coded );
+      WriteValue( ofs, static_cast< int >( coded.size() ) );
+      ofs.write( reinterpret_cast< const char * >( &coded[0] ),
+		 coded.size() );
+    }
+}
+
+/**************************************************************************\
+**
+**  tFieldCodec::ReadSlice
+**
+**  Reads and decodes the next slice written by WriteSlice. Returns
+**  false if the slice is cut short or makes no sense.
+**
+\**************************************************************************/
+bool tFieldCodec::ReadSlice( std::ifstream &ifs, int &precision,
+			     std::vector< tLineRun > &layout,
+			     std::vector< double > &values )
+{
+  int nRuns = 0, nValues = 0, nTokens = 0;
+  ReadValue( ifs, precision );
+  ReadValue( ifs, nRuns );
+  if( !ifs.good() || nRuns < 0 )
+    return false;
+  layout.resize( nRuns );
+  for( int r = 0; r < nRuns; ++r )
+    {
+      int length = 0;
+      ReadValue( ifs, layout[r].count );
+      ReadValue( ifs, length );
+      if( !ifs.good() || length < 0 || layout[r].count < 0 )
+	return false;
+      layout[r].pattern.resize( length );
+      if( length > 0 )
+	ifs.read( &layout[r].pattern[0], length );
+      int perLine = 0;
+      for( int c = 0; c < length; ++c )
+	if( layout[r].pattern[c] == kDouble || layout[r].pattern[c] == kInteger )
+	  ++perLine;
+      nTokens += perLine * layout[r].count;
+    }
+  char mode = 0;
+  ReadValue( ifs, nValues );
+  ReadValue( ifs, mode );
+  if( !ifs.good() || nValues != nTokens ||
+      ( mode != kDelta && mode != kKeyframe ) )
+    return false;
+  const size_t n = nValues;
+  if( mode == kDelta && previous.size() != kPlanes*n )
+    return false;
+
+  planes.resize( kPlanes*n );
+  for( int p = 0; p < kPlanes; ++p )
+    {
+      int nBytes = 0;
+      ReadValue( ifs, nBytes );
+      if( !ifs.good() || nBytes < 0 )
+	return false;
+      if( nBytes == 0 )
+	{
+	  if( n > 0 )
+	    memset( &planes[p*n], 0, n );
+	  continue;
+	}
+      coded.resize( nBytes );
+      ifs.read( reinterpret_cast< char * >( &coded[0] ), nBytes );
+      if( !ifs.good() )
+	return false;
+      DecodePlane( &coded[0], nBytes, model, &planes[p*n], n );
+    }
+
+  // Join the planes and undo the XOR
+  current.resize( kPlanes*n );
+  for( size_t i = 0; i < n; ++i )
+    for( int p = 0; p < kPlanes; ++p )
+      {
+	const unsigned char reference =
+	  mode == kDelta ? previous[kPlanes*i+p] :
+	  i > 0 ? current[kPlanes*(i-1)+p] : 0;
+	current[kPlanes*i+p] = planes[p*n+i] ^ reference;
+      }
+  values.resize( n );
+  if( n > 0 )
+    memcpy( &values[0], &current[0], kPlanes*n );
+  previous.swap( current );
+  return true;
+}
+
+/**************************************************************************\
+**
+**  tFieldCodec::DecodeFile
+**
+**  Writes the text file held in the compressed file fileName to
+**  textFileName. Returns false, with a message, if either file cannot
+**  be opened or the compressed file is not valid.
+**
+\**************************************************************************/
+bool tFieldCodec::DecodeFile( const char *fileName, const char *textFileName )
+{
+  std::ifstream ifs( fileName, std::ios::in | std::ios::binary );
+  if( !ifs.good() )
+    {
+      std::cerr << "tFieldCodec: unable to open '" << fileName << "'.\n";
+      return false;
+    }
+  char magic[sizeof( kMagic )];
+  int version = 0;
+  ifs.read( magic, sizeof( magic ) );
+  ReadValue( ifs, version );
+  if( !ifs.good() || memcmp( magic, kMagic, sizeof( kMagic ) ) != 0 )
+    {
+      std::cerr << "tFieldCodec: '" << fileName
+		<< "' is not a compressed output file.\n";
+      return false;
+    }
+  if( version != kVersion )
+    {
+      if( version == kVersionSwapped )
+	std::cerr << "tFieldCodec: '" << fileName << "' was written on a "
+		  << "machine of the other byte order.\n";
+      else
+	std::cerr << "tFieldCodec: '" << fileName << "' has version "
+		  << version << "; this reader knows version " << kVersion
+		  << ".\n";
+      return false;
+    }
+
+  std::ofstream ofs( textFileName );
+  if( !ofs.good() )
+    {
+      std::cerr << "tFieldCodec: unable to create '" << textFileName
+		<< "'.\n";
+      return false;
+    }
+  tFieldCodec codec;
+  int precision = 0;
+  std::vector< tLineRun > layout;
+  std::vector< double > values;
+  while( ifs.peek() != EOF )
+    {
+      if( !codec.ReadSlice( ifs, precision, layout, values ) )
+	{
+	  std::cerr << "tFieldCodec: '" << fileName
+		    << "' is cut short or damaged.\n";
+	  return false;
+	}
+      ofs.precision( precision );
+      size_t k = 0;
+      for( size_t r = 0; r < layout.size(); ++r )
+	{
+	  const std::string &pattern = layout[r].pattern;
+	  for( int l = 0; l < layout[r].count; ++l )
+	    for( size_t c = 0; c < pattern.size(); ++c )
+	      {
+		if( pattern[c] == kDouble )
+		  ofs << values[k++];
+		else if( pattern[c] == kInteger )
+		  ofs << static_cast< long >( values[k++] );
+		else
+		  ofs << pattern[c];
+	      }
+	}
+    }
+  return ofs.good();
+}
+
+/**************************************************************************\
+**
+**  tFieldOStream functions
+**
+\**************************************************************************/
+tFieldOStream::tFieldOStream() :
+  ofs(), compressed( false ), interval( 1 ), outputCount( 0 ), due( true ),
+  textPrecision( 6 ),
+  line(), layout(), values(), codec()
+{}
+
+tFieldOStream::~tFieldOStream()
+{
+  if( ofs.is_open() )
+    close();
+}
+
+// Opens fileName, or fileName.fz if compress is true.
+void tFieldOStream::open( const char *fileName, bool compress )
+{
+  compressed = compress;
+  if( !compressed )
+    {
+      ofs.open( fileName );
+      return;
+    }
+  std::string name( fileName );
+  name += ".fz";
+  ofs.open( name.c_str(), std::ios::out | std::ios::binary );
+  if( ofs.good() )
+    tFieldCodec::WriteHeader( ofs );
+}
+
+void tFieldOStream::close()
+{
+  if( compressed )
+    WriteSlice();
+  ofs.close();
+}
+
+void tFieldOStream::precision( int p )
+{
+  textPrecision = p;
+  ofs.precision( p );
+}
+
+tFieldOStream &tFieldOStream::operator<<( double value )
+{
+  if( !due ) return *this;
+  if( !compressed )
+    ofs << value;
+  else
+    {
+      values.push_back( value );
+      line += char( tFieldCodec::kDouble );
+    }
+  return *this;
+}
+
+tFieldOStream &tFieldOStream::operator<<( int value )
+{
+  if( !due ) return *this;
+  if( !compressed ) ofs << value; else AddInteger( value );
+  return *this;
+}
+
+tFieldOStream &tFieldOStream::operator<<( long value )
+{
+  if( !due ) return *this;
+  if( !compressed ) ofs << value; else AddInteger( value );
+  return *this;
+}
+
+tFieldOStream &tFieldOStream::operator<<( unsigned value )
+{
+  if( !due ) return *this;
+  if( !compressed ) ofs << value; else AddInteger( value );
+  return *this;
+}
+
+tFieldOStream &tFieldOStream::operator<<( unsigned long value )
+{
+  if( !due ) return *this;
+  if( !compressed ) ofs << value; else AddInteger( value );
+  return *this;
+}
+
+tFieldOStream &tFieldOStream::operator<<( char c )
+{
+  if( !due ) return *this;
+  if( !compressed ) ofs << c; else AddChar( c );
+  return *this;
+}
+
+tFieldOStream &tFieldOStream::operator<<( const char *s )
+{
+  if( !due ) return *this;
+  if( !compressed )
+    ofs << s;
+  else
+    while( *s != '\0' )
+      AddChar( *s++ );
+  return *this;
+}
+
+// std::flush (and std::endl) end the output, and the slice when
+// compressing.
+tFieldOStream &tFieldOStream::operator<<( std::ostream &(*manip)( std::ostream & ) )
+{
+  if( !due )
+    ;                           // nothing was written
+  else if( !compressed )
+    ofs << manip;
+  else
+    {
+      typedef std::ostream &(*manip_t)( std::ostream & );
+      if( manip == static_cast< manip_t >( std::endl ) )
+	AddChar( '\n' );
+      WriteSlice();
+    }
+  ++outputCount;
+  due = interval > 0 && outputCount % interval == 0;
+  return *this;
+}
+
+void tFieldOStream::AddInteger( double value )
+{
+  values.push_back( value );
+  line += char( tFieldCodec::kInteger );
+}
+
+// Adds a character to the current line; at the end of a line, adds the
+// line to the layout, or counts it if it repeats the line before.
+void tFieldOStream::AddChar( char c )
+{
+  line += c;
+  if( c != '\n' )
+    return;
+  if( !layout.empty() && layout.back().pattern == line )
+    ++layout.back().count;
+  else
+    {
+      tFieldCodec::tLineRun run;
+      run.pattern = line;
+      run.count = 1;
+      layout.push_back( run );
+    }
+  line.clear();
+}
+
+// Codes and writes what has been written since the last slice.
+void tFieldOStream::WriteSlice()
+{
+  if( !line.empty() )
+    {
+      tFieldCodec::tLineRun run;
+      run.pattern = line;
+      run.count = 1;
+      layout.push_back( run );
+      line.clear();
+    }
+  if( layout.empty() )
+    return;
+  codec.WriteSlice( ofs, textPrecision, layout, values );
+  layout.clear();
+  values.clear();
+  ofs.flush();
+}
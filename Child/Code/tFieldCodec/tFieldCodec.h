@@ -0,0 +1,155 @@
+//-*-c++-*-
+
+/***************************************************************************/
+/**
+**  @file tFieldCodec.h
+**  @brief Header for tFieldCodec and tFieldOStream, the optional lossless
+**         compression of the mesh and node-field output files.
+**
+**  Most node fields change little from one output to the next, and the
+**  mesh files not at all unless the mesh moves, yet each output writes
+**  them in full as text. With OPT_COMPRESS_OUTPUT, tOutput and tLOutput
+**  write each of these files as <name><ext>.fz instead (e.g. bench.z.fz),
+**  holding the numbers of each output ("slice") in binary form:
+**
+**    - each number is kept as a double (integers exactly, up to 2^53);
+**    - when a slice has as many numbers as the slice before it, each is
+**      XORed with the same number in the previous slice, so that the
+**      numbers which have not changed become zero, and those which
+**      changed a little keep only their low bytes; otherwise (first
+**      output, or the mesh has changed) each is XORed with the number
+**      before it;
+**    - the eight bytes of the numbers are split into eight planes, so
+**      that the sign and exponent bytes of all the numbers come
+**      together, and so on;
+**    - each plane is coded with an adaptive binary range coder, in the
+**      context of the byte before it in the plane; a plane of zeros
+**      takes no space.
+**
+**  The layout of the text (which numbers are integers, the spaces and
+**  new lines) is kept with each slice as runs of identical lines, so
+**  that tFieldCodec::DecodeFile writes back exactly the text file that
+**  would have been written without the option (see the childFieldDecode
+**  program). Nothing outside the standard library is needed.
+**
+**  File layout (native byte order; unsigned int assumed to be 32 bits):
+**    char[8]   "CHFIELDZ"
+**    int       version (1)
+**    then, for each slice:
+**      int     precision of the text
+**      int     nRuns, then for each run: int count, int length,
+**              char pattern[length] (kDouble and kInteger stand for a
+**              number, any other character for itself)
+**      int     nValues
+**      char    kKeyframe or kDelta
+**      for each of the 8 planes: int nBytes, char coded[nBytes]
+**              (nBytes == 0: every byte of the plane is zero)
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#ifndef TFIELDCODEC_H
+#define TFIELDCODEC_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**************************************************************************/
+/**
+** @class tFieldCodec
+**
+** Codes the slices of one file. The encoder and the decoder each keep
+** the numbers of the last slice, against which the next one is coded.
+*/
+/**************************************************************************/
+class tFieldCodec
+{
+public:
+  enum { kDouble = 1, kInteger = 2 };   // number tokens in a line pattern
+  enum { kKeyframe = 0, kDelta = 1 };
+
+  struct tLineRun
+  {
+    std::string pattern;
+    int count;
+  };
+
+  tFieldCodec();
+
+  void WriteSlice( std::ofstream &, int precision,
+                   std::vector< tLineRun > const &layout,
+                   std::vector< double > const &values );
+  bool ReadSlice( std::ifstream &, int &precision,
+                  std::vector< tLineRun > &layout,
+                  std::vector< double > &values );
+
+  static void WriteHeader( std::ofstream & );
+  static bool DecodeFile( const char *fileName, const char *textFileName );
+
+private:
+  std::vector< unsigned char > previous;  // bytes of the last slice
+  std::vector< unsigned char > current;   // bytes of this slice
+  std::vector< unsigned char > planes;    // current, transformed, by plane
+  std::vector< unsigned char > coded;     // one plane, range coded
+  std::vector< unsigned short > model;    // bit probabilities
+};
+
+/**************************************************************************/
+/**
+** @class tFieldOStream
+**
+** Output file stream for the mesh and node-field files. Written to as a
+** std::ofstream (numbers, characters, strings and std::flush); it writes
+** text as before unless opened with compress true, in which case it
+** gathers the numbers and the layout of the text and writes them as a
+** compressed slice each time it is flushed, and when closed.
+**
+** Each flush ends an output. With setInterval( n ), what is written is
+** kept at every n-th output only, starting with the first, and dropped
+** before it is formatted at the others (see tOutputSelection).
+*/
+/**************************************************************************/
+class tFieldOStream
+{
+  tFieldOStream( const tFieldOStream & );
+  tFieldOStream &operator=( const tFieldOStream & );
+public:
+  tFieldOStream();
+  ~tFieldOStream();
+
+  void open( const char *fileName, bool compress );
+  void close();
+  bool good() const { return ofs.good(); }
+  void precision( int );
+  void setInterval( int n ) { interval = n; due = n > 0; }
+
+  tFieldOStream &operator<<( double );
+  tFieldOStream &operator<<( float value ) { return *this << double( value ); }
+  tFieldOStream &operator<<( int );
+  tFieldOStream &operator<<( long );
+  tFieldOStream &operator<<( unsigned );
+  tFieldOStream &operator<<( unsigned long );
+  tFieldOStream &operator<<( char );
+  tFieldOStream &operator<<( const char * );
+  tFieldOStream &operator<<( std::ostream &(*)( std::ostream & ) );
+
+private:
+  void AddInteger( double );
+  void AddChar( char );
+  void WriteSlice();
+
+  std::ofstream ofs;
+  bool compressed;
+  int interval;                                // see setInterval
+  int outputCount;                             // flushes so far
+  bool due;                                    // this output is kept
+  int textPrecision;
+  std::string line;                            // pattern of current line
+  std::vector< tFieldCodec::tLineRun > layout;
+  std::vector< double > values;
+  tFieldCodec codec;
+};
+
+#endif
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/**
+**  tFieldCodec_test.cpp: writes the same outputs with tFieldOStream as
+**  text and compressed, decodes the compressed file with
+**  tFieldCodec::DecodeFile, and checks that it gives back the text file
+**  byte for byte.
+**
+**  Created 10/2026
+*/
+/**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../tFieldCodec.h"
+
+#define CHECK(name, cond) { \
+  fprintf (stdout, "\033[32m%s... \033[39m", name); \
+  if (cond) \
+    fprintf (stdout, "\033[32mPASS\033[39m\n"); \
+  else { \
+    fprintf (stdout, "\033[31mFAIL\033[39m\n"); \
+    exit (EXIT_FAILURE); \
+  } \
+}
+
+/* One output as tOutput writes it: the time, the number of values, then
+   one value per line. The values drift a little from one output to the
+   next, as node fields do, and some stay the same. */
+static void
+WriteOutput (tFieldOStream &ofs, double time, int n, int output)
+{
+  int i;
+
+  ofs << ' ' << time << '\n' << n << '\n';
+  for (i=0; i<n; ++i) {
+    if (i%5 == 0)
+      ofs << i << ' ' << -i << '\n';           /* integers */
+    else if (i%5 == 1)
+      ofs << 1000.0 * sin (0.1 * i) << '\n';   /* unchanged */
+    else if (i%5 == 2)
+      ofs << 1e-9 * i * (output + 1) << '\n';  /* tiny */
+    else
+      ofs << 0.5 * i + 0.001 * output * i << ' ' << -1e12 / (i+output) << '\n';
+  }
+  ofs << std::flush;
+}
+
+static bool
+WriteRun (const char *fileName, bool compress)
+{
+  tFieldOStream ofs;
+
+  ofs.open (fileName, compress);
+  if (!ofs.good ())
+    return false;
+  ofs.precision (12);
+  WriteOutput (ofs, 0., 200, 0);
+  WriteOutput (ofs, 10., 200, 1);     /* delta against the first */
+  WriteOutput (ofs, 20., 200, 1);     /* nothing changed */
+  WriteOutput (ofs, 30., 173, 3);     /* mesh changed: keyframe */
+  ofs << "last line without a new line";
+  ofs.close ();
+  return ofs.good ();
+}
+
+static std::string
+ReadFile (const char *fileName)
+{
+  std::ifstream ifs (fileName, std::ios::in | std::ios::binary);
+  std::ostringstream contents;
+
+  contents << ifs.rdbuf ();
+  return contents.str ();
+}
+
+int
+main (void)
+{
+  std::string text;
+
+  CHECK ("Write text", WriteRun ("codec_test.z", false));
+  text = ReadFile ("codec_test.z");
+  CHECK ("Write compressed", WriteRun ("codec_test_c.z", true));
+  CHECK ("Decode", tFieldCodec::DecodeFile ("codec_test_c.z.fz",
+                                            "codec_test_d.z"));
+  CHECK ("Decoded matches text", ReadFile ("codec_test_d.z") == text);
+  CHECK ("Reject a text file",
+         !tFieldCodec::DecodeFile ("codec_test.z", "codec_test_e.z"));
+
+  return EXIT_SUCCESS;
+}
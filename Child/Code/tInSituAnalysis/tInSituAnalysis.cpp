@@ -0,0 +1,418 @@
+/***************************************************************************/
+/**
+**  @file tInSituAnalysis.cpp
+**  @brief Functions for tInSituAnalysis and the reducers it provides
+**         (see tInSituAnalysis.h).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <limits>
+
+#include "tInSituAnalysis.h"
+#include "../errors/errors.h"
+
+namespace {
+
+const double kNoValue = std::numeric_limits< double >::quiet_NaN();
+
+/***************************************************************************\
+**
+**  tHypsometryReducer ("hypsometry")
+**
+**  Lowest, highest and area-weighted mean elevation, and the hypsometric
+**  integral (mean - lowest)/(highest - lowest).
+**
+\***************************************************************************/
+class tHypsometryReducer : public tInSituReducer
+{
+  double zmin, zmax, zarea, area;
+public:
+  void ColumnNames( std::vector< std::string > &names ) const
+  {
+    names.push_back( "hyps_zmin" );
+    names.push_back( "hyps_zmax" );
+    names.push_back( "hyps_zmean" );
+    names.push_back( "hyps_integral" );
+  }
+  void Begin()
+  {
+    zmin = std::numeric_limits< double >::max();
+    zmax = -zmin;
+    zarea = area = 0.;
+  }
+  void Add( tInSituSample const &s )
+  {
+    if( s.z < zmin ) zmin = s.z;
+    if( s.z > zmax ) zmax = s.z;
+    zarea += s.z * s.varea;
+    area += s.varea;
+  }
+  void End( std::vector< double > &v ) const
+  {
+    if( area <= 0. )
+    {
+      v.insert( v.end(), 4, kNoValue );
+      return;
+    }
+    const double zmean = zarea / area;
+    v.push_back( zmin );
+    v.push_back( zmax );
+    v.push_back( zmean );
+    v.push_back( zmax > zmin ? (zmean - zmin) / (zmax - zmin) : kNoValue );
+  }
+};
+
+/***************************************************************************\
+**
+**  tSlopeAreaReducer ("slope_area")
+**
+**  Least-squares fit of S = ks A^-theta through channel nodes, in log
+**  space: concavity theta, steepness index ks, coefficient of
+**  determination and number of nodes used.
+**
+\***************************************************************************/
+class tSlopeAreaReducer : public tInSituReducer
+{
+  double sx, sy, sxx, syy, sxy;
+  long n;
+public:
+  void ColumnNames( std::vector< std::string > &names ) const
+  {
+    names.push_back( "sa_concavity" );
+    names.push_back( "sa_ks" );
+    names.push_back( "sa_r2" );
+    names.push_back( "sa_n" );
+  }
+  void Begin()
+  {
+    sx = sy = sxx = syy = sxy = 0.;
+    n = 0;
+  }
+  void Add( tInSituSample const &s )
+  {
+    if( !s.channel || s.slope <= 0. || s.drarea <= 0. ) return;
+    const double x = log( s.drarea ), y = log( s.slope );
+    sx += x; sy += y;
+    sxx += x*x; syy += y*y; sxy += x*y;
+    ++n;
+  }
+  void End( std::vector< double > &v ) const
+  {
+    const double vxx = n>0 ? sxx - sx*sx/n : 0.;
+    if( n < 2 || vxx <= 0. )
+    {
+      v.insert( v.end(), 3, kNoValue );
+      v.push_back( n );
+      return;
+    }
+    const double vyy = syy - sy*sy/n, vxy = sxy - sx*sy/n;
+    const double b = vxy / vxx;
+    v.push_back( -b );
+    v.push_back( exp( (sy - b*sx) / n ) );
+    v.push_back( vyy > 0. ? vxy*vxy / (vxx*vyy) : kNoValue );
+    v.push_back( n );
+  }
+};
+
+/***************************************************************************\
+**
+**  tSteepnessReducer ("ksn")
+**
+**  Mean and highest normalized channel steepness S A^theta_ref over
+**  channel nodes, with theta_ref = INSITU_THETA_REF (default 0.45),
+**  and the number of nodes used.
+**
+\***************************************************************************/
+class tSteepnessReducer : public tInSituReducer
+{
+  double thetaRef, sum, maxKsn;
+  long n;
+public:
+  explicit tSteepnessReducer( double thetaRef_ ) : thetaRef( thetaRef_ ) {}
+  void ColumnNames( std::vector< std::string > &names ) const
+  {
+    names.push_back( "ksn_mean" );
+    names.push_back( "ksn_max" );
+    names.push_back( "ksn_n" );
+  }
+  void Begin()
+  {
+    sum = maxKsn = 0.;
+    n = 0;
+  }
+  void Add( tInSituSample const &s )
+  {
+    if( !s.channel || s.slope <= 0. || s.drarea <= 0. ) return;
+    const double ksn = s.slope * pow( s.drarea, thetaRef );
+    sum += ksn;
+    if( ksn > maxKsn ) maxKsn = ksn;
+    ++n;
+  }
+  void End( std::vector< double > &v ) const
+  {
+    v.push_back( n>0 ? sum/n : kNoValue );
+    v.push_back( n>0 ? maxKsn : kNoValue );
+    v.push_back( n );
+  }
+};
+
+/***************************************************************************\
+**
+**  tErosionHistogramReducer ("erosion_hist")
+**
+**  Share of the area eroding at rates in INSITU_HIST_BINS equal bins
+**  from 0 to INSITU_HIST_MAX_RATE, preceded by the share with net
+**  deposition and followed by the share above the highest bin.
+**
+\***************************************************************************/
+class tErosionHistogramReducer : public tInSituReducer
+{
+  std::vector< double > binArea;
+  double maxRate, area;
+public:
+  tErosionHistogramReducer( int nBins, double maxRate_ ) :
+    binArea( nBins+2 ), maxRate( maxRate_ ), area( 0. ) {}
+  void ColumnNames( std::vector< std::string > &names ) const
+  {
+    names.push_back( "erohist_dep" );
+    for( size_t i=1; i+1<binArea.size(); ++i )
+    {
+      std::ostringstream name;
+      name << "erohist_" << i;
+      names.push_back( name.str() );
+    }
+    names.push_back( "erohist_over" );
+  }
+  void Begin()
+  {
+    binArea.assign( binArea.size(), 0. );
+    area = 0.;
+  }
+  void Add( tInSituSample const &s )
+  {
+    if( !s.hasRate ) return;
+    const size_t nBins = binArea.size() - 2;
+    size_t bin;
+    if( s.rate < 0. )
+      bin = 0;
+    else if( s.rate >= maxRate )
+      bin = nBins + 1;
+    else
+      bin = 1 + static_cast< size_t >( nBins * s.rate / maxRate );
+    binArea[bin] += s.varea;
+    area += s.varea;
+  }
+  void End( std::vector< double > &v ) const
+  {
+    for( size_t i=0; i<binArea.size(); ++i )
+      v.push_back( area>0. ? binArea[i]/area : kNoValue );
+  }
+};
+
+/***************************************************************************\
+**
+**  tDenudationReducer ("denudation")
+**
+**  Area-weighted mean erosion rate (basin-averaged denudation), the
+**  corresponding volume rate, and the area it was taken over.
+**
+\***************************************************************************/
+class tDenudationReducer : public tInSituReducer
+{
+  double volRate, area;
+public:
+  void ColumnNames( std::vector< std::string > &names ) const
+  {
+    names.push_back( "denud_rate" );
+    names.push_back( "denud_volume_rate" );
+    names.push_back( "denud_area" );
+  }
+  void Begin()
+  {
+    volRate = area = 0.;
+  }
+  void Add( tInSituSample const &s )
+  {
+    if( !s.hasRate ) return;
+    volRate += s.rate * s.varea;
+    area += s.varea;
+  }
+  void End( std::vector< double > &v ) const
+  {
+    v.push_back( area>0. ? volRate/area : kNoValue );
+    v.push_back( area>0. ? volRate : kNoValue );
+    v.push_back( area );
+  }
+};
+
+} // namespace
+
+/**************************************************************************\
+**
+**  tInSituAnalysis constructor
+**
+**  Creates the reducers named in INSITU_REDUCERS (separated by spaces or
+**  commas) and reads how often to run them (INSITU_INTERVAL, in storms)
+**  and the drainage area above which a node is counted as a channel
+**  (INSITU_CHANNEL_AREA; 0 counts all nodes). Nothing is read when
+**  INSITU_REDUCERS is absent, and the analysis is then inactive.
+**
+\**************************************************************************/
+tInSituAnalysis::tInSituAnalysis( const tInputFile &infile ) :
+  timeLast( 0. ), timeNow( 0. ), channelArea( 0. ), interval( 1 ),
+  stormCount( 0 )
+{
+  if( !infile.Contain( "INSITU_REDUCERS" ) ) return;
+
+  std::string list = infile.ReadString( "INSITU_REDUCERS" );
+  for( size_t i=0; i<list.size(); ++i )
+    if( list[i] == ',' ) list[i] = ' ';
+  std::istringstream names( list );
+  std::string name;
+  while( names >> name )
+    reducers.push_back( CreateReducer( name, infile ) );
+  if( reducers.empty() ) return;
+
+  interval = infile.ReadInt( "INSITU_INTERVAL", false );
+  if( interval < 1 ) interval = 1;
+  channelArea = infile.ReadDouble( "INSITU_CHANNEL_AREA", false );
+}
+
+tInSituAnalysis::~tInSituAnalysis()
+{
+  for( size_t i=0; i<reducers.size(); ++i )
+    delete reducers[i];
+}
+
+/**************************************************************************\
+**
+**  tInSituAnalysis::CreateReducer
+**
+**  Returns a new reducer of the given name, reading any parameters it
+**  takes from the input file. New reducers are registered here.
+**
+\**************************************************************************/
+tInSituReducer *tInSituAnalysis::CreateReducer( std::string const &name,
+                                                const tInputFile &infile )
+{
+  if( name == "hypsometry" )
+    return new tHypsometryReducer;
+  if( name == "slope_area" )
+    return new tSlopeAreaReducer;
+  if( name == "ksn" )
+  {
+    double thetaRef = infile.ReadDouble( "INSITU_THETA_REF", false );
+    if( thetaRef <= 0. ) thetaRef = 0.45;
+    return new tSteepnessReducer( thetaRef );
+  }
+  if( name == "erosion_hist" )
+  {
+    int nBins = infile.ReadInt( "INSITU_HIST_BINS", false );
+    if( nBins < 1 ) nBins = 10;
+    const double maxRate = infile.ReadDouble( "INSITU_HIST_MAX_RATE" );
+    if( maxRate <= 0. )
+      ReportFatalError( "INSITU_HIST_MAX_RATE must be positive." );
+    return new tErosionHistogramReducer( nBins, maxRate );
+  }
+  if( name == "denudation" )
+    return new tDenudationReducer;
+
+  std::cerr << "Unknown reducer '" << name << "' in INSITU_REDUCERS.\n"
+            << "Known reducers are: hypsometry slope_area ksn erosion_hist"
+            << " denudation\n";
+  ReportFatalError( "Unknown reducer in INSITU_REDUCERS." );
+  return 0;
+}
+
+bool tInSituAnalysis::IsDue()
+{
+  if( ++stormCount < interval ) return false;
+  stormCount = 0;
+  return true;
+}
+
+void tInSituAnalysis::WriteHeader( std::ostream &os ) const
+{
+  std::vector< std::string > names;
+  for( size_t i=0; i<reducers.size(); ++i )
+    reducers[i]->ColumnNames( names );
+  os << "# time";
+  for( size_t i=0; i<names.size(); ++i )
+    os << ' ' << names[i];
+  os << std::endl;
+}
+
+void tInSituAnalysis::Begin( double time )
+{
+  timeNow = time;
+  for( size_t i=0; i<reducers.size(); ++i )
+    reducers[i]->Begin();
+}
+
+/**************************************************************************\
+**
+**  tInSituAnalysis::AddNode
+**
+**  Passes one interior node to every reducer. The erosion rate is the
+**  lowering of the node since the last evaluation, divided by the time
+**  elapsed, plus its uplift rate; it is known only for nodes that were
+**  already there at the last evaluation.
+**
+\**************************************************************************/
+void tInSituAnalysis::AddNode( int permID, double z, double varea,
+                               double slope, double drarea, double uplift )
+{
+  const size_t id = static_cast< size_t >( permID );
+  if( id >= zLast.size() )
+  {
+    zLast.resize( id+1, 0. );
+    seenLast.resize( id+1, 0 );
+    seenNow.resize( id+1, 0 );
+  }
+
+  tInSituSample s;
+  s.z = z;
+  s.varea = varea;
+  s.slope = slope;
+  s.drarea = drarea;
+  s.channel = drarea >= channelArea;
+  s.hasRate = seenLast[id] && timeNow > timeLast;
+  s.rate = s.hasRate ? (zLast[id] - z) / (timeNow - timeLast) + uplift : 0.;
+  zLast[id] = z;
+  seenNow[id] = 1;
+
+  for( size_t i=0; i<reducers.size(); ++i )
+    reducers[i]->Add( s );
+}
+
+/**************************************************************************\
+**
+**  tInSituAnalysis::End
+**
+**  Writes the time and the results of every reducer as one line, and
+**  remembers which nodes were seen, for the next erosion rates.
+**
+\**************************************************************************/
+void tInSituAnalysis::End( std::ostream &os )
+{
+  values.clear();
+  for( size_t i=0; i<reducers.size(); ++i )
+    reducers[i]->End( values );
+
+  const std::streamsize prec = os.precision();
+  os << std::setprecision( 10 ) << timeNow;
+  for( size_t i=0; i<values.size(); ++i )
+    os << ' ' << values[i];
+  os << std::endl;
+  os.precision( prec );
+
+  seenLast.swap( seenNow );
+  seenNow.assign( seenNow.size(), 0 );
+  timeLast = timeNow;
+}
@@ -0,0 +1,114 @@
+//-*-c++-*-
+
+/***************************************************************************/
+/**
+**  @file tInSituAnalysis.h
+**  @brief Header for tInSituAnalysis, which reduces node data to a few
+**         numbers per time while the model runs, and for the reducers
+**         it uses.
+**
+**  Statistics that used to be computed afterwards from the full node
+**  output (hypsometry, slope-area relations, channel steepness, erosion
+**  rates) are computed instead in a single pass over the nodes, every
+**  INSITU_INTERVAL storms, and written as one line of a time-series
+**  file. Each reducer sees every interior node once, as a tInSituSample,
+**  and keeps only running sums, so memory does not grow with the mesh.
+**
+**  The reducers to use are listed by name in INSITU_REDUCERS. To add a
+**  reducer, derive it from tInSituReducer and give it a name in
+**  tInSituAnalysis::CreateReducer.
+**
+**  The engine knows nothing of the mesh: the caller (tTSOutputImp) feeds
+**  it the nodes, so that it can be used with any node type.
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#ifndef TINSITUANALYSIS_H
+#define TINSITUANALYSIS_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "../tInputFile/tInputFile.h"
+
+/***************************************************************************/
+/**
+**  @struct tInSituSample
+**
+**  What a reducer is told about one interior node.
+*/
+/***************************************************************************/
+struct tInSituSample
+{
+  double z;         // elevation
+  double varea;     // Voronoi area
+  double slope;     // slope in the direction of flow
+  double drarea;    // drainage area
+  double rate;      // erosion rate since the last evaluation (if hasRate)
+  bool channel;     // drainage area at least INSITU_CHANNEL_AREA
+  bool hasRate;     // node was present at the last evaluation
+};
+
+/***************************************************************************/
+/**
+**  @class tInSituReducer
+**
+**  Base class for online reducers. Begin() is called before each pass
+**  over the nodes, Add() once per node and End() once after, to append
+**  one value per column to the output line.
+*/
+/***************************************************************************/
+class tInSituReducer
+{
+public:
+  virtual ~tInSituReducer() {}
+  virtual void ColumnNames( std::vector< std::string > & ) const = 0;
+  virtual void Begin() = 0;
+  virtual void Add( tInSituSample const & ) = 0;
+  virtual void End( std::vector< double > & ) const = 0;
+};
+
+/***************************************************************************/
+/**
+**  @class tInSituAnalysis
+**
+**  Holds the reducers selected in the input file, decides when they are
+**  due, works out erosion rates from the elevation of each node at the
+**  previous evaluation, and writes the results.
+*/
+/***************************************************************************/
+class tInSituAnalysis
+{
+  tInSituAnalysis( const tInSituAnalysis & );
+  tInSituAnalysis &operator=( const tInSituAnalysis & );
+public:
+  explicit tInSituAnalysis( const tInputFile & );
+  ~tInSituAnalysis();
+
+  bool IsActive() const { return !reducers.empty(); }
+  bool IsDue();  // counts storms; true every interval-th call
+
+  void WriteHeader( std::ostream & ) const;
+  void Begin( double time );
+  void AddNode( int permID, double z, double varea, double slope,
+                double drarea, double uplift );
+  void End( std::ostream & );
+
+  static tInSituReducer *CreateReducer( std::string const &,
+                                        const tInputFile & );
+
+private:
+  std::vector< tInSituReducer * > reducers;
+  std::vector< double > zLast;    // elevation at last evaluation, by permID
+  std::vector< char > seenLast;   // node present at last evaluation
+  std::vector< char > seenNow;    // node present at this evaluation
+  double timeLast, timeNow;
+  double channelArea;             // INSITU_CHANNEL_AREA
+  int interval;                   // INSITU_INTERVAL
+  int stormCount;
+  std::vector< double > values;   // buffer for End()
+};
+
+#endif
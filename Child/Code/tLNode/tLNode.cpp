@@ -19,11 +19,13 @@
 
 #include <assert.h>
 #include <math.h>
+#include <algorithm>
 #include "../errors/errors.h"
 #include "tLNode.h"
 //#define kBugTime 5000000
 
 #include "../tStratGrid/tStratGrid.h"
+#include "../tMemoryFootprint/tMemoryFootprint.h"
 
 //Sets the total layer depth.  While updating depth, dgrade info is
 //automatically updated to keep the same texture.
@@ -291,6 +293,9 @@ const tChannel &tChannel::operator=( const tChannel &right )     //tChannel
  **       one. Once the problem was discovered, the fix was simple:
  **       use the assignment operator instead. This was probably the
  **       source of the problem noted by nmg below. (gt, 2/2000)
+ **     - The layer list is now a tSharedList: the copy shares the
+ **       layers of the original until either of them changes them, so
+ **       it is initialized from orig.layerlist again. (10/2026)
  **     - Changed tLNode(infile) to call new tNode(infile), which reads
  **       static bool tNode::freezeElevations, which is referenced within
  **       tNode::ChangeZ(dz); if freezeElevations = true, ChangeZ will do
@@ -304,6 +309,10 @@ tArray<double> tLNode::grade = 1;
 double tLNode::maxregdep = 1;
 double tLNode::KRnew = 1.0;
 double tLNode::new_sed_bulk_density_ = kDefaultSoilBulkDensity;
+double tLNode::compactDepth_ = 0.;
+double tLNode::compactTolerance_ = 0.;
+double tLNode::compactThickness_ = 0.;
+int tLNode::maxLayers_ = 0;
 
 tLNode::tLNode()                                                   //tLNode
   :
@@ -322,6 +331,7 @@ qsubsurf(0.),
 is_masked_(false),
 netDownslopeForce(0.),
 is_moving_(false),
+compacted_layers_(0),
 public1(-1)
 {
   if (0) //DEBUG
@@ -345,6 +355,7 @@ qsubsurf(0.),
 is_masked_(false),
 netDownslopeForce(0.),
 is_moving_(false),
+compacted_layers_(0),
 public1(-1)
 {
   char add[2], name[20];
@@ -460,7 +471,7 @@ public1(-1)
         i++;
       }
       
-      layerlist.insertAtBack( layhelp );
+      layerlist.getNC().insertAtBack( layhelp );
       
       if(0) //DEBUG
       {
@@ -492,7 +503,7 @@ public1(-1)
         }
         if(extra>10000) //TODO, bettter criteria for setting deep sed. flag
           layhelp.setRtime(-1.);
-        layerlist.insertAtFront( layhelp );
+        layerlist.getNC().insertAtFront( layhelp );
         
         if(0) //DEBUG
         {
@@ -509,7 +520,7 @@ public1(-1)
           layhelp.setDgrade(i, maxregdep*dgradehelp[i]);
           i++;
         }
-        layerlist.insertAtFront( layhelp );
+        layerlist.getNC().insertAtFront( layhelp );
         
         if(0) //DEBUG
         {
@@ -528,7 +539,7 @@ public1(-1)
           i++;
         }
         
-        layerlist.insertAtFront( layhelp );
+        layerlist.getNC().insertAtFront( layhelp );
         
         if(0) //DEBUG
         {
@@ -559,11 +570,11 @@ public1(-1)
         layhelp.setDgrade(i, help*dgradebrhelp[i]);
         i++;
       }
-      layerlist.insertAtBack( layhelp );
+      layerlist.getNC().insertAtBack( layhelp );
     }
     
     if (0) //DEBUG
-      std::cout << layerlist.getSize() << " layers created " << std::endl;
+      std::cout << layerlist.get().getSize() << " layers created " << std::endl;
   }
   
 }
@@ -589,7 +600,7 @@ tLNode::tLNode( const tLNode &orig )                               //tLNode
     qsdin(orig.qsdin),
     qsdinm(orig.qsdinm ),
     uplift(orig.uplift),
-    layerlist(),
+    layerlist( orig.layerlist ),
     stratNode(0),
     accumdh(orig.accumdh),
     qsubsurf(orig.qsubsurf),
@@ -598,18 +609,10 @@ tLNode::tLNode( const tLNode &orig )                               //tLNode
     cumulative_ero_dep_(orig.cumulative_ero_dep_),
     cumulative_sed_xport_volume_(orig.cumulative_sed_xport_volume_),
     is_moving_(orig.is_moving_),
+    compacted_layers_(orig.compacted_layers_),
     public1(orig.public1)
 {
 
-  //Be aware that the copy constructor should be called using the
-  //following syntax
-  //tLNode *newnode = new tLNode( *oldtLNode );
-  //NOT
-  //tLNode newnode(*oldtLNode)
-  //The latter seems to call a default constructor which does not
-  //properly copy the layerlist
-
-  layerlist = orig.layerlist;
   if (0) //DEBUG
     std::cout << "=>tLNode( orig )" << std::endl;
 }
@@ -657,6 +660,7 @@ const tLNode &tLNode::operator=( const tLNode &right )                  //tNode
       cumulative_ero_dep_ = right.cumulative_ero_dep_;
       cumulative_sed_xport_volume_ = right.cumulative_sed_xport_volume_;
 	  is_moving_ = right.is_moving_;
+      compacted_layers_ = right.compacted_layers_;
       public1 = right.public1;
     }
   return *this;
@@ -1109,7 +1113,7 @@ void tLNode::TellAll() const
   else std::cout << "  edg is undefined!\n";
 
   std::cout << "layerlist addresses are:\n";
-  layerlist.DebugTellPtrs();
+  layerlist.get().DebugTellPtrs();
 }
 #endif
 
@@ -1146,7 +1150,7 @@ void tLNode::EroDep( double dz )
 
 void tLNode::InsertLayerBack( tLayer const & lyr )
 {
-  layerlist.insertAtBack( lyr );
+  layerlist.getNC().insertAtBack( lyr );
 }
 
 
@@ -1764,7 +1768,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 
   }
 
-  layerlist=helplist;
+  layerlist.getNC() = helplist;
   //     if(getNumLayer()<=2)
   //         std::cout<<"layerinterp made 2 layers at "<<x<<", "<<y<<std::endl;
 
@@ -1774,7 +1778,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
      */
     i=0;
     std::cout<<"x "<<tx<<" y "<<ty;
-    while(i<layerlist.getSize()){
+    while(i<layerlist.get().getSize()){
       std::cout << "layer " << i+1 <<std::endl;
       std::cout << getLayerCtime(i);
       std::cout << " " << getLayerRtime(i);
@@ -2460,7 +2464,7 @@ return valgrd;
 void tLNode::addtoLayer(int i, int g, double val, double tt)
 {
   // For adding material to a layer, grain size by grain size
-  tLayer *hlp = layerlist.getIthDataPtrNC( i );
+  tLayer *hlp = layerlist.getNC().getIthDataPtrNC( i );
 
   if(tt>0)
     hlp->setRtime( tt );
@@ -2495,7 +2499,7 @@ tArray<double> tLNode::addtoLayer(int i, double val)
 
   tArray<double> ret(numg);
 
-  tLayer *hlp = layerlist.getIthDataPtrNC( i );
+  tLayer *hlp = layerlist.getNC().getIthDataPtrNC( i );
 
   if(hlp->getDepth()+val>1e-7)
     {
@@ -2546,16 +2550,16 @@ void tLNode::removeLayer(int i)
   tLayer lay;
 
   if( i==0 )
-    layerlist.removeFromFront( lay );
-  else if( (i+1)==layerlist.getSize() )
-    layerlist.removeFromBack( lay );
+    layerlist.getNC().removeFromFront( lay );
+  else if( (i+1)==layerlist.get().getSize() )
+    layerlist.getNC().removeFromBack( lay );
   else
     {
-      tListIter<tLayer> ly ( layerlist );
+      tListIter<tLayer> ly ( layerlist.getNC() );
       int n;
       for( n=1; n<i; n++ )
 	ly.Next();
-      n = layerlist.removeNext( lay, ly.NodePtr() );
+      n = layerlist.getNC().removeNext( lay, ly.NodePtr() );
       assert( n>0 );
     }
 
@@ -2568,11 +2572,11 @@ void tLNode::removeLayer(int i)
   hlp=ly.NextP();
   }
 
-  if(i+1==layerlist.getSize()){
-  layerlist.removeFromBack(*hlp );
+  if(i+1==layerlist.get().getSize()){
+  layerlist.getNC().removeFromBack(*hlp );
   }
   else{
-  n=layerlist.removeNext((*hlp), layerlist.getListNode(hlp) );
+  n=layerlist.getNC().removeNext((*hlp), layerlist.getNC().getListNode(hlp) );
   }
   if(n==0){
   //       n=0;
@@ -2629,7 +2633,7 @@ void tLNode::makeNewLayerBelow(int i, tLayer::tSed_t sd, double erd,
 
   if(i>=0){
 
-    tListIter<tLayer> ly ( layerlist );
+    tListIter<tLayer> ly ( layerlist.getNC() );
     tLayer  * pt;
     pt=ly.FirstP();
 
@@ -2640,17 +2644,17 @@ void tLNode::makeNewLayerBelow(int i, tLayer::tSed_t sd, double erd,
       pt=ly.NextP();
     }
 
-    layerlist.insertAtNext(hlp, layerlist.getListNode(pt));
+    layerlist.getNC().insertAtNext(hlp, layerlist.getNC().getListNode(pt));
   }
   else{
-    layerlist.insertAtFront(hlp);
+    layerlist.getNC().insertAtFront(hlp);
   }
 }
 
 //Returns depth of all the layers - pretty useless for the current model
 double tLNode::getTotalLayerDepth() const
 {
-  const double sz = layerlist.getSize();
+  const double sz = layerlist.get().getSize();
   int i=0;
   double elev = 0;
   while(i<sz)
@@ -2692,15 +2696,426 @@ void tLNode::CopyLayerList( tLNode const * fromNode )
   layerlist = fromNode->layerlist;
 }
 
+/********************************************************************
+ **
+ **  tLNode::PackErosionState / UnpackErosionState
+ **
+ **  Append to buf, and read back, what fluvial erosion changes at a
+ **  node: elevation, erosion rates, shear stress, cumulative ero/dep
+ **  and the layer stack (tLayer::Pack / Unpack). A node eroded by one
+ **  MPI process is copied this way to the others, which hold the same
+ **  mesh (see tBasinFarm::ExchangeBasins). Unpack returns the
+ **  position just past what it read.
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+void tLNode::PackErosionState( std::vector< double > &buf ) const
+{
+  buf.push_back( z );
+  buf.push_back( chan.migration.xyzd[2] );
+  buf.push_back( dzdt );
+  buf.push_back( drdt );
+  buf.push_back( tau );
+  buf.push_back( cumulative_ero_dep_ );
+  buf.push_back( layerlist.get().getSize() );
+  for( tListNodeBasic< tLayer > const *ln = layerlist.get().getFirst();
+       ln != 0; ln = ln->getNext() )
+    ln->getDataRef().Pack( buf );
+}
+
+double const *tLNode::UnpackErosionState( double const *p )
+{
+  z = *p++;
+  chan.migration.xyzd[2] = *p++;
+  dzdt = *p++;
+  drdt = *p++;
+  tau = *p++;
+  cumulative_ero_dep_ = *p++;
+  const int nlayers = static_cast< int >( *p++ );
+  layerlist.getNC().Flush();
+  tLayer layer;
+  for( int i=0; i<nlayers; ++i )
+  {
+    p = layer.Unpack( p );
+    layerlist.getNC().insertAtBack( layer );
+  }
+  return p;
+}
+
+void tLayer::Pack( std::vector< double > &buf ) const
+{
+  buf.push_back( layerID );
+  buf.push_back( ctime );
+  buf.push_back( rtime );
+  buf.push_back( etime );
+  buf.push_back( depth );
+  buf.push_back( erody );
+  buf.push_back( sed );
+  buf.push_back( paleocurrent );
+  buf.push_back( bulkDensity );
+  buf.push_back( dgrade.getSize() );
+  for( size_t i=0; i<dgrade.getSize(); ++i )
+    buf.push_back( dgrade[i] );
+}
+
+double const *tLayer::Unpack( double const *p )
+{
+  layerID = static_cast< int >( *p++ );
+  ctime = *p++;
+  rtime = *p++;
+  etime = *p++;
+  depth = *p++;
+  erody = *p++;
+  sed = static_cast< tSed_t >( static_cast< int >( *p++ ) );
+  paleocurrent = *p++;
+  bulkDensity = *p++;
+  const size_t ngrades = static_cast< size_t >( *p++ );
+  if( dgrade.getSize() != ngrades ) dgrade.setSize( ngrades );
+  for( size_t i=0; i<ngrades; ++i )
+    dgrade[i] = *p++;
+  return p;
+}
+
+/********************************************************************
+ **
+ **  tLNode::AddMemoryFootprint
+ **
+ **  Adds to mf the heap memory the node owns: the cells of its layer
+ **  list with their grain-size arrays, its other per-size arrays, and
+ **  its tTrees object if it has one. The node itself is counted by
+ **  tMesh, as part of its list cell. A layer list shared with a copy of
+ **  the model (see tSharedList) is counted in full by each of them.
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+void tLNode::AddMemoryFootprint( tMemoryFootprint &mf ) const
+{
+  for( tListNodeBasic< tLayer > const *ln = layerlist.get().getFirst();
+       ln != 0; ln = ln->getNext() )
+  {
+    mf.AddBlock( tMemoryFootprint::kLayers,
+                 sizeof( tListNodeBasic< tLayer > ) );
+    mf.AddArray( tMemoryFootprint::kLayers, ln->getDataRef().getDgrade() );
+  }
+  mf.nLayers += layerlist.get().getSize();
+  mf.AddArray( tMemoryFootprint::kNodeArrays, reg.dgrade );
+  mf.AddArray( tMemoryFootprint::kNodeArrays, chan.migration.xyzd );
+  mf.AddArray( tMemoryFootprint::kNodeArrays, qsm );
+  mf.AddArray( tMemoryFootprint::kNodeArrays, qsinm );
+  mf.AddArray( tMemoryFootprint::kNodeArrays, qsdinm );
+  mf.AddArray( tMemoryFootprint::kNodeArrays, accumdh );
+  if( vegCover.getTrees() != 0 )
+    mf.AddBlock( tMemoryFootprint::kVegetation, sizeof( tTrees ) );
+}
+
+/********************************************************************
+ **
+ **  tLNode::CompactLayers( thinDepth )
+ **
+ **  Merges redundant layers: two adjacent layers below the surface
+ **  (active) layer are merged when they are of the same material,
+ **  erodibility and bulk density, at least one of them is thinner than
+ **  thinDepth, and together they are no thicker than the maximum layer
+ **  depth that EroDep works with. Returns the number of layers removed.
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+int tLNode::CompactLayers( double thinDepth )
+{
+  int nremoved = 0;
+  tListNodeBasic< tLayer > *ln = layerlist.getNC().getFirstNC();
+  if( ln == 0 ) return 0;
+  ln = ln->getNextNC();  // leave the surface layer alone
+  while( ln != 0 && ln->getNextNC() != 0 )
+  {
+    tLayer const &upper = ln->getDataRef();
+    tLayer const &lower = ln->getNextNC()->getDataRef();
+    const double d1 = upper.getDepth();
+    const double d2 = lower.getDepth();
+    if( upper.getSed() != lower.getSed()
+        || upper.getErody() != lower.getErody()
+        || upper.getBulkDensity() != lower.getBulkDensity()
+        || ( d1 >= thinDepth && d2 >= thinDepth )
+        || d1 + d2 > maxregdep )
+    {
+      ln = ln->getNextNC();
+      continue;
+    }
+    MergeLayerBelow( ln );
+    ++nremoved;
+  }
+  return nremoved;
+}
+
+/********************************************************************
+ **
+ **  tLNode::ApplyLayerCompaction
+ **
+ **  Applies the layer compaction policy (OPT_LAYER_COMPACTION) to the
+ **  layer stack. Two adjacent layers whose top lies at least
+ **  compactDepth_ below the surface are merged when they are similar
+ **  (see LayersSimilar) and the merged layer would be no thicker than
+ **  compactThickness_ (if set). Then, while the node has more than
+ **  maxLayers_ layers (if set), the deepest two adjacent layers of the
+ **  same material are merged, so that the stack keeps its resolution
+ **  near the surface, where EroDep works. The surface layer is never
+ **  merged. Returns the number of layers removed.
+ **
+ **  Layers below compactDepth_ do not change once they have been
+ **  compacted, and layers are pushed down across it only as new ones
+ **  are made above. So unless wholeStack is set, nothing is done
+ **  unless the node has gained layers since the last call, and then
+ **  only the layers that have come to cross compactDepth_ are merged;
+ **  the rest of the stack is not visited.
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+int tLNode::ApplyLayerCompaction( bool wholeStack )
+{
+  if( !wholeStack && layerlist.get().getSize() <= compacted_layers_ )
+  {
+    compacted_layers_ = layerlist.get().getSize();
+    return 0;
+  }
+  int nremoved = 0;
+  tListNodeBasic< tLayer > *ln = layerlist.getNC().getFirstNC();
+  if( ln == 0 ) return 0;
+  double top = ln->getDataRef().getDepth();  // depth to top of layer ln
+  ln = ln->getNextNC();
+  while( ln != 0 && ln->getNextNC() != 0 )
+  {
+    tLayer const &upper = ln->getDataRef();
+    tLayer const &lower = ln->getNextNC()->getDataRef();
+    if( top >= compactDepth_ )
+    {
+      if( LayersSimilar( upper, lower )
+          && ( compactThickness_ <= 0.
+               || upper.getDepth() + lower.getDepth() <= compactThickness_ ) )
+      {
+        MergeLayerBelow( ln );
+        ++nremoved;
+        continue;
+      }
+      if( !wholeStack ) break;
+    }
+    top += upper.getDepth();
+    ln = ln->getNextNC();
+  }
+  
+  while( maxLayers_ > 0 && layerlist.get().getSize() > maxLayers_ )
+  {
+    tListNodeBasic< tLayer > *deepest = 0;
+    ln = layerlist.getNC().getFirstNC()->getNextNC();
+    for( ; ln != 0 && ln->getNextNC() != 0; ln = ln->getNextNC() )
+      if( ln->getDataRef().getSed() == ln->getNextNC()->getDataRef().getSed() )
+        deepest = ln;
+    if( deepest == 0 ) break;
+    MergeLayerBelow( deepest );
+    ++nremoved;
+  }
+  compacted_layers_ = layerlist.get().getSize();
+  return nremoved;
+}
+
+/********************************************************************
+ **
+ **  tLNode::LayersSimilar
+ **
+ **  Tells whether two layers may be merged by the compaction policy:
+ **  they must be of the same material, their erodibilities and bulk
+ **  densities must differ by no more than compactTolerance_ relative to
+ **  the larger, and the fraction of each grain size by no more than
+ **  compactTolerance_.
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+bool tLNode::LayersSimilar( tLayer const &a, tLayer const &b )
+{
+  if( a.getSed() != b.getSed() ) return false;
+  const double tol = compactTolerance_;
+  if( fabs( a.getErody() - b.getErody() )
+      > tol * std::max( fabs( a.getErody() ), fabs( b.getErody() ) ) )
+    return false;
+  if( fabs( a.getBulkDensity() - b.getBulkDensity() )
+      > tol * std::max( a.getBulkDensity(), b.getBulkDensity() ) )
+    return false;
+  for( size_t g=0; g<a.getDgradesize(); ++g )
+    if( fabs( a.getDgrade( g ) / a.getDepth()
+              - b.getDgrade( g ) / b.getDepth() ) > tol )
+      return false;
+  return true;
+}
+
+/********************************************************************
+ **
+ **  tLNode::MergeLayerBelow
+ **
+ **  Merges the layer after ln into the layer at ln (see tLayer::Merge).
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+void tLNode::MergeLayerBelow( tListNodeBasic< tLayer > *ln )
+{
+  ln->getDataRefNC().Merge( ln->getNextNC()->getDataRef() );
+  tLayer removed;
+  layerlist.getNC().removeNext( removed, ln );
+}
+
+/********************************************************************
+ **
+ **  tLNode::MergeColumn
+ **
+ **  Replaces the node's column by a mixture of a fraction w of another
+ **  column, whose surface is at elevation oz and whose layers are
+ **  olayers, with a fraction 1-w of its own, as when the node takes in
+ **  part of the Voronoi cell of a deleted node. The two columns are
+ **  matched by depth below their surfaces, and each of the node's
+ **  layers takes in, with tLayer::Merge, the other column's material
+ **  over the same range of depths (the bottom layer takes in all of it
+ **  below), so that each layer but the bottom one keeps its thickness
+ **  and its sediment flag. The surface moves to the weighted mean of the
+ **  two elevations, so that the volume of each layer of either column is
+ **  conserved. This is a change of the mesh, not erosion or deposition,
+ **  so it is not counted in the cumulative erosion/deposition.
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+void tLNode::MergeColumn( double oz, tList< tLayer > const &olayers,
+                          double w )
+{
+  // layer of the other column at the current depth, and how much of it
+  // is not yet taken
+  tListNodeBasic< tLayer > const *on = olayers.getFirst();
+  double oleft = ( on!=0 ) ? on->getDataRef().getDepth() : 0.0;
+
+  tList< tLayer > merged;
+  for( tListNodeBasic< tLayer > const *ln = layerlist.get().getFirst();
+       ln!=0; ln=ln->getNext() )
+  {
+    tLayer layer = ln->getDataRef();
+    if( layer.getDepth() <= 0.0 ) continue;
+    layer.setDepth( (1.0-w) * layer.getDepth() );
+
+    // depth of the other column to take in; all of it for the bottom layer
+    double need = ( ln->getNext()!=0 ) ? ln->getDataRef().getDepth() : -1.0;
+    while( on!=0 && need!=0.0 )
+    {
+      const double dz = ( need<0.0 || oleft<need ) ? oleft : need;
+      if( dz > 0.0 )
+      {
+        tLayer part = on->getDataRef();
+        part.setDepth( w*dz );   // keeps the texture
+        layer.Merge( part );
+      }
+      if( need > 0.0 ) need -= dz;
+      if( ( oleft -= dz ) <= 0.0 )
+      {
+        on = on->getNext();
+        oleft = ( on!=0 ) ? on->getDataRef().getDepth() : 0.0;
+      }
+    }
+    merged.insertAtBack( layer );
+  }
+
+  layerlist.getNC() = merged;
+  ChangeZ( w * ( oz - getZ() ) );
+}
+
+/********************************************************************
+ **
+ **  tLayer::Merge
+ **
+ **  Adds the material of layer other to this one. The merged layer has
+ **  the sum of their grain-size depths; its creation time, exposure
+ **  time, erodibility and bulk density are their thickness-weighted
+ **  means, and its recent time is the later of the two, so that the
+ **  age statistics of the stack are kept as weighted summaries.
+ **
+ **  Paleocurrents are compass directions (in degrees, or negative if
+ **  there is none), so they are averaged as unit vectors: the merged
+ **  direction is that of the thickness-weighted sum of the two vectors,
+ **  so that 350 and 10 give 0, not 180.
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+void tLayer::Merge( tLayer const &other )
+{
+  const double d1 = depth;
+  const double d2 = other.depth;
+  const double w1 = d1 / (d1+d2), w2 = d2 / (d1+d2);
+  ctime = w1*ctime + w2*other.ctime;
+  etime = w1*etime + w2*other.etime;
+  if( other.rtime > rtime )
+    rtime = other.rtime;
+  if( erody != other.erody )
+    erody = w1*erody + w2*other.erody;
+  if( bulkDensity != other.bulkDensity )
+    bulkDensity = w1*bulkDensity + w2*other.bulkDensity;
+  if( paleocurrent >= 0. && other.paleocurrent >= 0.
+      && paleocurrent != other.paleocurrent )
+  {
+    const double a1 = paleocurrent * PI / 180.;
+    const double a2 = other.paleocurrent * PI / 180.;
+    double mean = atan2( w1*sin( a1 ) + w2*sin( a2 ),
+                         w1*cos( a1 ) + w2*cos( a2 ) ) * 180. / PI;
+    if( mean < 0. ) mean += 360.;
+    paleocurrent = mean;
+  }
+  else if( paleocurrent < 0. )
+    paleocurrent = other.paleocurrent;
+  for( size_t g=0; g<dgrade.getSize(); ++g )
+    addDgrade( g, other.dgrade[g] );
+}
+
+/********************************************************************
+ **
+ **  tLNode::ReadLayerCompaction
+ **
+ **  Reads the layer compaction policy (see ApplyLayerCompaction): the depth
+ **  below which layers may merge (LAYER_COMPACT_DEPTH, by default the
+ **  maximum layer depth, MAXREGDEPTH), the tolerance for merging
+ **  (LAYER_COMPACT_TOLERANCE, by default 0.05; 0 merges only identical
+ **  layers), the thickest layer
+ **  merging may make (LAYER_COMPACT_MAX_THICKNESS, by default no
+ **  limit) and the most layers a node may have (LAYER_MAX_NUMBER, by
+ **  default no limit).
+ **
+ **  Created: 10/2026
+ **
+ ********************************************************************/
+void tLNode::ReadLayerCompaction( const tInputFile &infile )
+{
+  compactDepth_ = infile.ReadDouble( "LAYER_COMPACT_DEPTH", false );
+  if( compactDepth_ <= 0. ) compactDepth_ = maxregdep;
+  compactTolerance_ = 0.05;
+  if( infile.Contain( "LAYER_COMPACT_TOLERANCE" ) )
+  {
+    compactTolerance_ = infile.ReadDouble( "LAYER_COMPACT_TOLERANCE" );
+    if( compactTolerance_ < 0. )
+      ReportFatalError( "LAYER_COMPACT_TOLERANCE must not be negative." );
+  }
+  compactThickness_ = infile.ReadDouble( "LAYER_COMPACT_MAX_THICKNESS", false );
+  maxLayers_ = infile.ReadInt( "LAYER_MAX_NUMBER", false );
+  if( maxLayers_ < 0 ) maxLayers_ = 0;
+}
+
 // SL, 8/2010: New function to find total depth of regolith/sediment
 // above bedrock with layers (so no need to separately keep track of 
 // alluvial thickness).
 double tLNode::getRegolithDepth()
 {
-  tListIter< tLayer > lI( layerlist );
   double soilThickness(0.0);
-  for( tLayer *lP=lI.FirstP(); lP->getSed() == tLayer::kSed; lP=lI.NextP() )
-    soilThickness += lP->getDepth();
+  for( tListNodeBasic< tLayer > const *ln = layerlist.get().getFirst();
+       ln->getDataRef().getSed() == tLayer::kSed; ln = ln->getNext() )
+    soilThickness += ln->getDataRef().getDepth();
   return soilThickness;
 }
 
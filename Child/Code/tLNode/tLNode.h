@@ -40,12 +40,14 @@
 #include "../tArray/tArray.h"
 #include "../MeshElements/meshElements.h"
 #include "../tList/tList.h"
+#include "../tList/tSharedList.h"
 #include "../tInputFile/tInputFile.h"
 #include "../globalFns.h"
 #include "../tVegetation/tVegetation.h"
 
 class tStratNode;
 class tStratGrid;
+class tMemoryFootprint;
 
 #include "../compiler.h"
 
@@ -108,6 +110,13 @@ public:
   inline void setBulkDensity( double val ) {bulkDensity = val;}
   inline void addBulkDensity( double val ) {bulkDensity += val;}
 
+  // adds a layer's material to this one (see tLNode::MergeLayerBelow)
+  void Merge( tLayer const & );
+
+  // flattened copy, for exchange between processes (see tBasinFarm)
+  void Pack( std::vector< double > & ) const;
+  double const *Unpack( double const * );
+
 protected:
   int layerID;
   double ctime; // time of creation of layer
@@ -642,7 +651,8 @@ public:
   inline double getLayerDgrade(int, size_t) const;  // first int is layer index
   // second int is grade index - see note above for indexing directions
   inline int getNumLayer() const;
-  inline tList< tLayer > &getLayersRefNC(); // returns pointer to layerlist
+  inline tList< tLayer > const &getLayersRef() const; // to read layerlist
+  inline tList< tLayer > &getLayersRefNC(); // to change it (unshares it)
   inline void setLayerCtime(int, double);
   inline void setLayerRtime(int, double);
   inline void setLayerEtime(int, double);
@@ -712,6 +722,18 @@ public:
   virtual void PrepForMovement( tTriangle const *, double );
 
   void CopyLayerList( tLNode const * ); // Copy layerlist from another node (gt 12/99)
+  // mix in a fraction of another column (see tErosion::CoarsenMesh)
+  void MergeColumn( double z, tList< tLayer > const &, double fraction );
+  // state changed by fluvial erosion, flattened for tBasinFarm
+  void PackErosionState( std::vector< double > & ) const;
+  double const *UnpackErosionState( double const * );
+  // memory held by the node (see tMemoryFootprint)
+  void AddMemoryFootprint( tMemoryFootprint & ) const;
+  // merge thin layers into identical neighbours; returns layers removed
+  int CompactLayers( double thinDepth );
+  // merge layers by the OPT_LAYER_COMPACTION policy; returns removed
+  int ApplyLayerCompaction( bool wholeStack = false );
+  static void ReadLayerCompaction( const tInputFile & );
 
    virtual void ChangeZ( double ); // overrides tNode::ChangeZ
   // add new function to find regolith/sediment depth from layers (sl, 8/10)
@@ -727,6 +749,8 @@ public:
 
 protected:
   double CalcSlopeMeander(); // specialisation of CalcSlope()
+  void MergeLayerBelow( tListNodeBasic< tLayer > * );
+  static bool LayersSimilar( tLayer const &, tLayer const & );
   tLNode *getDSlopeDtMeander( double &curlen );  // specialisation of getDSlopeDt()
 protected:
   tVegCover vegCover;  // Vegetation cover properties (see tVegetation.h/.cpp)
@@ -750,7 +774,7 @@ protected:
   double qsdin;                      /* Sediment influx rate from diffusion*/
   tArray< double > qsdinm;           /* multi size; influx rate of each size fraction*/
   double uplift;                    /* uplift rate*/
-  tList< tLayer > layerlist;        /* list of the different layers */
+  tSharedList< tLayer > layerlist;  /* list of the different layers */
   tStratNode *stratNode;            /* Pointer to rectangular grid node. */
   tArray< double > accumdh;         /* temp inremental record of dh-fine and dh-coarse, used for projection on the tStratGrid */
   static size_t numg;
@@ -762,6 +786,11 @@ protected:
   static double maxregdep;
   static double KRnew;
   static double new_sed_bulk_density_;
+  // layer compaction policy (see ApplyLayerCompaction)
+  static double compactDepth_;     // layers below this depth may merge
+  static double compactTolerance_; // allowed difference in texture, erody
+  static double compactThickness_; // thickest layer made by merging
+  static int maxLayers_;           // most layers per node (0 = no cap)
   double qsubsurf;   // Subsurface discharge
   double netDownslopeForce; // force from landslide calculation
   double cumulative_ero_dep_;    // Keeps track of ero/dep since last update (for external reporting)
@@ -769,6 +798,7 @@ protected:
   //double safetyFactor; // Factor of safety for node (landsliding)
   bool is_masked_;    // Indicates a "masked out" node
   bool is_moving_;       // Flag indicating whether the node is moving
+  int compacted_layers_; // Number of layers after the last compaction
   
   ////////////////////for orographic precipitation///////////////////////
   double preci;   // precipitation of node 
@@ -1258,106 +1288,112 @@ inline double tLNode::getMaxregdep() const
 
 inline double tLNode::getLayerCtime( int i ) const
 {
-  return layerlist.getIthDataRef(i).getCtime();
+  return layerlist.get().getIthDataRef(i).getCtime();
 }
 
 inline double tLNode::getLayerRtime( int i ) const
 {
-  return layerlist.getIthDataRef(i).getRtime();
+  return layerlist.get().getIthDataRef(i).getRtime();
 }
 
 inline double tLNode::getLayerEtime( int i ) const
 {
-  return layerlist.getIthDataRef(i).getEtime();
+  return layerlist.get().getIthDataRef(i).getEtime();
 }
 
 inline double tLNode::getLayerDepth( int i ) const
 {
-  if( unlikely(layerlist.isEmpty()) )
+  if( unlikely(layerlist.get().isEmpty()) )
     {
       std::cout << "** WARNING lyr list empty\n"
 	   << " NODE " << id << ":\n"
 	   << "  x=" << x << " y=" << y << " z=" << z;
     }
-  return layerlist.getIthDataRef(i).getDepth();
+  return layerlist.get().getIthDataRef(i).getDepth();
 }
 
 inline double tLNode::getLayerErody( int i ) const
 {
-  return layerlist.getIthDataRef(i).getErody();
+  return layerlist.get().getIthDataRef(i).getErody();
 }
 
 inline double tLNode::getLayerBulkDensity( int i ) const
 {
-  return layerlist.getIthDataRef(i).getBulkDensity();
+  return layerlist.get().getIthDataRef(i).getBulkDensity();
 }
 
 inline tLayer::tSed_t tLNode::getLayerSed( int i ) const
 {
-  return layerlist.getIthDataRef(i).getSed();
+  return layerlist.get().getIthDataRef(i).getSed();
 }
 
 inline double tLNode::getLayerDgrade( int i, size_t num ) const
 {
-   return layerlist.getIthDataRef(i).getDgrade(num);
+   return layerlist.get().getIthDataRef(i).getDgrade(num);
 }
 
 inline int tLNode::getNumLayer() const
 {
-  return layerlist.getSize();
+  return layerlist.get().getSize();
+}
+
+inline tList< tLayer > const &tLNode::getLayersRef() const
+{
+  return layerlist.get();
 }
 
 inline tList< tLayer > &tLNode::getLayersRefNC()
 {
-  return layerlist;
+  return layerlist.getNC();
 }
 
 inline void tLNode::setLayerCtime( int i, double tt)
 {
-  layerlist.getIthDataPtrNC( i )->setCtime( tt );
+  layerlist.getNC().getIthDataPtrNC( i )->setCtime( tt );
 }
 
 inline void tLNode::setLayerRtime( int i, double tt)
 {
-  layerlist.getIthDataPtrNC( i )->setRtime( tt );
+  layerlist.getNC().getIthDataPtrNC( i )->setRtime( tt );
 }
 
 inline void tLNode::setLayerEtime( int i, double tt)
 {
-  layerlist.getIthDataPtrNC( i )->setEtime( tt );
+  layerlist.getNC().getIthDataPtrNC( i )->setEtime( tt );
 }
 
 inline void tLNode::addLayerEtime( int i, double tt)
 {
-  layerlist.getIthDataPtrNC( i )->addEtime( tt );
+  layerlist.getNC().getIthDataPtrNC( i )->addEtime( tt );
 }
 
 inline void tLNode::setLayerDepth( int i, double dep)
 {
   assert( dep > 0.0 );
-  layerlist.getIthDataPtrNC( i )->setDepth( dep );
+  layerlist.getNC().getIthDataPtrNC( i )->setDepth( dep );
 }
 
 inline void tLNode::setLayerErody( int i, double ero)
 {
-  layerlist.getIthDataPtrNC( i )->setErody( ero );
+  layerlist.getNC().getIthDataPtrNC( i )->setErody( ero );
 }
 
 inline void tLNode::setLayerSed( int i, tLayer::tSed_t s)
 {
-  layerlist.getIthDataPtrNC( i )->setSed( s );
+  layerlist.getNC().getIthDataPtrNC( i )->setSed( s );
 }
 
 inline void tLNode::setLayerDgrade( int i, size_t g, double val)
 {
   assert( val>=0.0 );
-  layerlist.getIthDataPtrNC( i )->setDgrade(g, val );
+  layerlist.getNC().getIthDataPtrNC( i )->setDgrade(g, val );
 }
 
 inline void tLNode::ThickenBottomLayer( double added_thickness )
 {
   assert( added_thickness>=0.0 );
-  tLayer * bottom_layer = layerlist.getIthDataPtrNC( layerlist.getSize()-1 );
+  tList< tLayer > &layers = layerlist.getNC();
+  tLayer * bottom_layer = layers.getIthDataPtrNC( layers.getSize()-1 );
   bottom_layer->setDepth( bottom_layer->getDepth() + added_thickness );
 }
 
@@ -1529,7 +1565,7 @@ inline void tLNode::ChangeZ( double val )
 
 /*******************************************************************\
   tNode::getEdgePtrIndices() virtual function; here, returns 
-  one-member array with edg ID
+  one-member array with edg ID; here, also flowedge ID (-1 if none)
 
   10/10 SL
 \*******************************************************************/
@@ -1537,7 +1573,7 @@ inline tArray< int > tLNode::getEdgePtrIndices()
 {
   tArray<int> ar(2);
   ar[0] = getEdg()->getID();
-  ar[1] = flowedge->getID();
+  ar[1] = ( flowedge != 0 ) ? flowedge->getID() : -1;
   return ar;
 }
 
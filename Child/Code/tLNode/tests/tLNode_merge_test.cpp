@@ -0,0 +1,113 @@
+/**************************************************************************/
+/**
+**  tLNode_merge_test.cpp: checks tLayer::Merge and tLNode::MergeColumn,
+**  which mesh coarsening uses to give a deleted node's column to its
+**  neighbours: the volume of each grain size is conserved, the layers
+**  but the bottom one keep their thickness, and nothing is counted as
+**  erosion or deposition.
+**
+**  Created 10/2026
+*/
+/**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../tLNode.h"
+
+#define CHECK(name, cond) { \
+  fprintf (stdout, "\033[32m%s... \033[39m", name); \
+  if (cond) \
+    fprintf (stdout, "\033[32mPASS\033[39m\n"); \
+  else { \
+    fprintf (stdout, "\033[31mFAIL\033[39m\n"); \
+    exit (EXIT_FAILURE); \
+  } \
+}
+
+static bool
+Near (double a, double b)
+{
+  return fabs (a - b) <= 1e-12 * (1. + fabs (b));
+}
+
+/* A layer of two grain sizes. */
+static tLayer
+MakeLayer (double fine, double coarse, double ctime, double rtime,
+           double paleocurrent)
+{
+  tLayer layer (2);
+
+  layer.setDgrade (0, fine);
+  layer.setDgrade (1, coarse);
+  layer.setCtime (ctime);
+  layer.setRtime (rtime);
+  layer.setEtime (0.);
+  layer.setErody (1e-4);
+  layer.setSed (tLayer::kSed);
+  layer.setPaleoCurrent (paleocurrent);
+  layer.setBulkDensity (1700.);
+  return layer;
+}
+
+/* Depth of grain size g summed over the layers. */
+static double
+Volume (tList< tLayer > const &layers, size_t g)
+{
+  double sum = 0.;
+
+  for (tListNodeBasic< tLayer > const *ln = layers.getFirst ();
+       ln != 0; ln = ln->getNext ())
+    sum += ln->getDataRef ().getDgrade (g);
+  return sum;
+}
+
+int
+main (void)
+{
+  {
+    tLayer a = MakeLayer (0.5, 0.5, 100., 5., 350.);
+
+    a.Merge (MakeLayer (0.25, 0.75, 200., 9., 10.));
+    CHECK ("Merge depth", Near (a.getDepth (), 2.)
+           && Near (a.getDgrade (0), 0.75) && Near (a.getDgrade (1), 1.25));
+    CHECK ("Merge times", Near (a.getCtime (), 150.) && a.getRtime () == 9.);
+    CHECK ("Merge paleocurrent", fabs (a.getPaleoCurrent ()) < 1e-9
+           || fabs (a.getPaleoCurrent () - 360.) < 1e-9);
+  }
+
+  {
+    const double w = 0.25;
+    tLNode node;
+    tList< tLayer > other;
+    size_t g;
+
+    node.setZ (10.);
+    node.InsertLayerBack (MakeLayer (0.75, 0.25, 10., 10., -1.));
+    node.InsertLayerBack (MakeLayer (1., 1., 20., 20., -1.));
+    node.InsertLayerBack (MakeLayer (2., 3., 30., 30., -1.));
+    other.insertAtBack (MakeLayer (0.5, 0., 15., 15., -1.));
+    other.insertAtBack (MakeLayer (1., 3., 25., 25., -1.));
+    other.insertAtBack (MakeLayer (4., 6., 35., 35., -1.));
+
+    double before[2];
+    for (g=0; g<2; ++g)
+      before[g] = (1.-w) * Volume (node.getLayersRef (), g)
+        + w * Volume (other, g);
+
+    node.ResetCumulativeEroDep ();
+    node.MergeColumn (8., other, w);
+
+    CHECK ("Column elevation", Near (node.getZ (), 9.5));
+    CHECK ("Column layers", node.getNumLayer () == 3
+           && Near (node.getLayerDepth (0), 1.)
+           && Near (node.getLayerDepth (1), 2.));
+    for (g=0; g<2; ++g)
+      CHECK ("Column volume", Near (Volume (node.getLayersRef (), g),
+                                    before[g]));
+    CHECK ("Not erosion", node.getCumulativeEroDep () == 0.);
+  }
+
+  return EXIT_SUCCESS;
+}
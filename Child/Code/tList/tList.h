@@ -543,6 +543,8 @@ public:
   inline void moveToBefore( ListNodeType *, ListNodeType * );
   inline void moveToAfter( ListNodeType *, ListNodeType * );
   inline void makeCircular();   // makes list circular (last points to first)
+  void relinkInOrder( ListNodeType * const * ); // puts all nodes in given order
+  void relocateInOrder( ListNodeType * const *, ListNodeType ** ); // ditto, copied
   inline const NodeType getIthData( int ) const;     // rtns copy of given item #
   inline const NodeType *getIthDataPtr( int ) const; // rtns ptr to given item #
   inline const NodeType &getIthDataRef( int ) const; // rtns ref to given item #
@@ -626,7 +628,6 @@ tList( const tList< NodeType, ListNodeType > &original ) :
 {
   int i;
 
-  assert( original != 0 );
   ListNodeType * current = original.first;
   for( i=0; i<original.nNodes; ++i )
     {
@@ -1317,6 +1318,55 @@ makeCircular()
 }
 
 
+/**************************************************************************\
+ **
+ **  tList::relinkInOrder
+ **
+ **  Relinks the list so that its items come in the order given by
+ **  _order_, an array holding each list node exactly once. The list
+ **  nodes themselves are not moved, so pointers to items stay valid. A
+ **  circular list stays circular.
+ **
+\**************************************************************************/
+template< class NodeType, class ListNodeType >
+void tList< NodeType, ListNodeType >::
+relinkInOrder( ListNodeType * const * order )
+{
+  if( nNodes == 0 ) return;
+  const bool circular = ( first->prev != 0 );
+  for( int i=0; i<nNodes; ++i )
+    {
+      order[i]->prev = ( i > 0 ) ? order[i-1] : 0;
+      order[i]->next = ( i < nNodes-1 ) ? order[i+1] : 0;
+    }
+  first = order[0];
+  last = order[nNodes-1];
+  if( circular ) makeCircular();
+}
+
+/**************************************************************************\
+ **
+ **  tList::relocateInOrder
+ **
+ **  As relinkInOrder, but the items are copied into newly allocated list
+ **  nodes, made one after another in the given order, so that walking
+ **  the list also walks memory in order. The new list nodes are returned
+ **  in _moved_. The old ones are taken off the list but not deleted:
+ **  pointers between items still lead to the old copies, and the caller
+ **  deletes them once it has redirected those pointers.
+ **
+\**************************************************************************/
+template< class NodeType, class ListNodeType >
+void tList< NodeType, ListNodeType >::
+relocateInOrder( ListNodeType * const * order, ListNodeType ** moved )
+{
+  for( int i=0; i<nNodes; ++i )
+    moved[i] = new ListNodeType( order[i]->getDataRef() );
+  relinkInOrder( moved );
+  currentItem = 0;
+}
+
+
 template< class NodeType, class ListNodeType >
 void tList< NodeType, ListNodeType >::
 DebugTellPtrs() const
@@ -0,0 +1,96 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+ **  @file tSharedList.h
+ **  @brief Header file for class tSharedList, a tList shared between
+ **         copies until one of them changes it (copy on write).
+ **
+ **  Copying a tSharedList does not copy the list: the copies point to the
+ **  same list and count how many of them do. The list is duplicated only
+ **  when one of the copies asks for it to change it (getNC), so that
+ **  copies which never change their list never pay for it. This is used
+ **  for the layer lists of tLNode, which make up most of the memory of a
+ **  model with stratigraphy and are copied in full by
+ **  childInterface::Initialize_Copy.
+ **
+ **  Only getNC() may be used to change the list, and a reference or
+ **  pointer it returns must not be kept across a copy of the tSharedList
+ **  that owns it. The count is changed atomically when built with OpenMP,
+ **  so that copies may be used by different threads.
+ **
+ **  Created 10/2026
+ */
+/**************************************************************************/
+
+#ifndef TSHAREDLIST_H
+#define TSHAREDLIST_H
+
+#include "tList.h"
+
+template< class NodeType >
+class tSharedList
+{
+  struct tBody
+  {
+    tList< NodeType > list;
+    int refs;                   // number of tSharedLists pointing here
+    tBody() : list(), refs(1) {}
+    explicit tBody( tList< NodeType > const &l ) : list( l ), refs(1) {}
+  };
+
+public:
+  tSharedList() : body( new tBody ) {}
+  tSharedList( tSharedList const &orig ) : body( orig.body ) { Hold(); }
+  ~tSharedList() { Release(); }
+  tSharedList &operator=( tSharedList const &right )
+  {
+    if( body != right.body )
+      {
+	Release();
+	body = right.body;
+	Hold();
+      }
+    return *this;
+  }
+
+  tList< NodeType > const &get() const { return body->list; }
+  inline tList< NodeType > &getNC();  // makes the list our own first
+  bool isShared() const { return body->refs > 1; }
+  int getShareCount() const { return body->refs; }
+
+private:
+  void Hold()
+  {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    ++body->refs;
+  }
+  void Release()
+  {
+    int left;
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+    left = --body->refs;
+    if( left == 0 )
+      delete body;
+  }
+
+  tBody *body;
+};
+
+template< class NodeType >
+inline tList< NodeType > &tSharedList< NodeType >::getNC()
+{
+  if( unlikely( body->refs > 1 ) )
+    {
+      tBody *own = new tBody( body->list );
+      Release();
+      body = own;
+    }
+  return body->list;
+}
+
+#endif
@@ -0,0 +1,106 @@
+/***************************************************************************/
+/**
+**  @file tMemoryFootprint.cpp
+**  @brief Functions for tMemoryFootprint (see tMemoryFootprint.h).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+
+#include "tMemoryFootprint.h"
+
+tMemoryFootprint::tMemoryFootprint()
+{
+  Reset();
+}
+
+void tMemoryFootprint::Reset()
+{
+  for( int p=0; p<kNumParts; ++p )
+    bytes[p] = 0;
+  overhead = 0;
+  nNodes = nEdges = nTriangles = nLayers = 0;
+}
+
+size_t tMemoryFootprint::getTotal() const
+{
+  size_t total = 0;
+  for( int p=0; p<kNumParts; ++p )
+    total += bytes[p];
+  return total;
+}
+
+double tMemoryFootprint::getLayersPerNode() const
+{
+  return nNodes>0 ? static_cast< double >( nLayers ) / nNodes : 0.;
+}
+
+const char *tMemoryFootprint::PartName( tPart_t p )
+{
+  static const char *names[kNumParts] =
+    { "nodes", "edges", "triangles", "layers", "node arrays",
+      "vegetation", "strat grid" };
+  return names[p];
+}
+
+/**************************************************************************\
+**
+**  tMemoryFootprint::WriteLogLine
+**
+**  Writes the tally on a single line, in MB, for the run log: total,
+**  each subsystem that holds any memory, allocator overhead, element
+**  counts and the mean number of layers per node.
+**
+\**************************************************************************/
+void tMemoryFootprint::WriteLogLine( std::ostream &os, double time ) const
+{
+  const double MB = 1024.*1024.;
+  const std::ios_base::fmtflags flags = os.flags();
+  const std::streamsize prec = os.precision();
+  os << std::fixed << std::setprecision(1)
+     << "Memory at time " << time << ": " << getTotal()/MB << " MB (";
+  bool first = true;
+  for( int p=0; p<kNumParts; ++p )
+    if( bytes[p]>0 )
+    {
+      os << (first ? "" : ", ") << PartName( static_cast< tPart_t >(p) )
+         << " " << bytes[p]/MB;
+      first = false;
+    }
+  os << "; overhead " << overhead/MB << "); " << nNodes << " nodes, "
+     << nEdges << " edges, " << nTriangles << " triangles, "
+     << std::setprecision(2) << getLayersPerNode() << " layers/node\n";
+  os.flags( flags );
+  os.precision( prec );
+}
+
+/**************************************************************************\
+**
+**  tMemoryFootprint::WriteReport
+**
+**  Writes a table of bytes and share of the total for each subsystem,
+**  followed by the allocator overhead and the element counts.
+**
+\**************************************************************************/
+void tMemoryFootprint::WriteReport( std::ostream &os ) const
+{
+  const size_t total = getTotal();
+  const std::ios_base::fmtflags flags = os.flags();
+  const std::streamsize prec = os.precision();
+  os << std::fixed << std::setprecision(1);
+  for( int p=0; p<kNumParts; ++p )
+    os << std::setw(12) << PartName( static_cast< tPart_t >(p) ) << ": "
+       << std::setw(14) << bytes[p] << " bytes "
+       << std::setw(5) << (total>0 ? 100.*bytes[p]/total : 0.) << "%\n";
+  os << std::setw(12) << "total" << ": " << std::setw(14) << total
+     << " bytes, of which allocator overhead " << overhead << "\n"
+     << std::setw(12) << "elements" << ": " << nNodes << " nodes, "
+     << nEdges << " edges, " << nTriangles << " triangles, " << nLayers
+     << " layers (" << std::setprecision(2) << getLayersPerNode()
+     << " per node)\n";
+  os.flags( flags );
+  os.precision( prec );
+}
@@ -0,0 +1,98 @@
+//-*-c++-*-
+
+/***************************************************************************/
+/**
+**  @file tMemoryFootprint.h
+**  @brief Header for tMemoryFootprint, a tally of the memory held by the
+**         model, by subsystem.
+**
+**  The mesh, its nodes and the stratigraphy grid each add what they own
+**  (see tMesh::AddMemoryFootprint, tLNode::AddMemoryFootprint and
+**  tStratGrid::AddMemoryFootprint). Every heap block is counted at the
+**  size the allocator actually sets aside for it, and the difference
+**  from the size requested is also kept, as allocator overhead. The
+**  estimate assumes a GNU-style allocator: a one-word header per block,
+**  blocks rounded up to 16 bytes, and 32 bytes at least.
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#ifndef TMEMORYFOOTPRINT_H
+#define TMEMORYFOOTPRINT_H
+
+#include <stddef.h>
+#include <iosfwd>
+#include "../tArray/tArray.h"
+
+class tMemoryFootprint
+{
+public:
+  // subsystems the memory is shared among
+  typedef enum {
+    kNodes = 0,     // node list cells
+    kEdges,         // edge list cells
+    kTriangles,     // triangle list cells
+    kLayers,        // layer list cells and their grain-size arrays
+    kNodeArrays,    // other arrays held by each node
+    kVegetation,    // vegetation and forest
+    kStratGrid,     // stratigraphy grid
+    kNumParts
+  } tPart_t;
+
+  tMemoryFootprint();
+  void Reset();
+  // one heap block of the given size, or the data of an array (none if
+  // the array is empty)
+  inline void AddBlock( tPart_t, size_t );
+  template< class T > inline void AddArray( tPart_t, tArray< T > const & );
+  // memory held within another object, not allocated by itself
+  inline void AddInline( tPart_t, size_t );
+
+  size_t getBytes( tPart_t p ) const { return bytes[p]; }
+  size_t getTotal() const;
+  size_t getOverhead() const { return overhead; }
+  double getLayersPerNode() const;
+  static const char *PartName( tPart_t );
+  // bytes the allocator sets aside for a request of the given size
+  static inline size_t BlockSize( size_t );
+
+  void WriteLogLine( std::ostream &, double time ) const;  // one line
+  void WriteReport( std::ostream & ) const;  // one line per subsystem
+
+  long nNodes;      // element counts, filled in by tMesh
+  long nEdges;
+  long nTriangles;
+  long nLayers;     // layers of all nodes
+
+private:
+  size_t bytes[kNumParts];
+  size_t overhead;
+};
+
+inline size_t tMemoryFootprint::BlockSize( size_t n )
+{
+  const size_t sz = ( n + sizeof(size_t) + 15 ) & ~static_cast< size_t >(15);
+  return sz < 32 ? 32 : sz;
+}
+
+inline void tMemoryFootprint::AddBlock( tPart_t p, size_t n )
+{
+  const size_t sz = BlockSize( n );
+  bytes[p] += sz;
+  overhead += sz - n;
+}
+
+template< class T >
+inline void tMemoryFootprint::AddArray( tPart_t p, tArray< T > const &a )
+{
+  if( a.getSize() > 0 )
+    AddBlock( p, a.getSize() * sizeof(T) );
+}
+
+inline void tMemoryFootprint::AddInline( tPart_t p, size_t n )
+{
+  bytes[p] += n;
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include <fstream>
 #include <time.h>
 #include <assert.h>
+#include <vector>
 
 #include "TipperTriangulator.h"
 
@@ -490,26 +491,17 @@ void start_aligned_point(int &lower_hull_pos, int &upper_hull_pos,
   }
 }
 
+// Triangulate npoints sorted, unique points into "edges", which must
+// hold 3*npoints default edges (there are at most three edges per point).
+// Returns the number of edges.
 static
-void triangulate(int npoints,const point p[], int *pnedges, edge** edges_ret){
-  // we assume that all points are unique
-
-  if (npoints < 3) {
-    std::cout << "Less than 3 distinct nodes to triangulate. Bailing out."
-	      << std::endl;
-    tt_error_handler();
-  }
+int triangulate_into(int npoints,const point p[], edge *edges){
 
   //convex hull is a cyclical list - it will consist of anticlockwise
   //ordered edges - since each new point adds at most 1 extra edge (nett)
   //to the hull, there are at most npoints edges on the hull
   cyclist hull(npoints);
 
-  //and the edges - there are at most three edges per point
-  const long nn=3*npoints;
-  edge* edges;
-  edges=new edge[nn];
-
   int lower_hull_pos, upper_hull_pos, next_edge, next_point;
 
   //make first three edges  - these will form the initial convex hull
@@ -676,13 +668,323 @@ void triangulate(int npoints,const point p[], int *pnedges, edge** edges_ret){
   }
 
   // results
-  {
-    int i=0;
-    while(edges[i].from != edge::end ) i++;
-    *pnedges = i;
+  int i=0;
+  while(edges[i].from != edge::end ) i++;
+  return i;
+}
+
+static
+void triangulate(int npoints,const point p[], int *pnedges, edge** edges_ret){
+  // we assume that all points are unique
+
+  if (npoints < 3) {
+    std::cout << "Less than 3 distinct nodes to triangulate. Bailing out."
+	      << std::endl;
+    tt_error_handler();
   }
+
+  //and the edges - there are at most three edges per point
+  const long nn=3*npoints;
+  edge* edges;
+  edges=new edge[nn];
+
+  *pnedges = triangulate_into(npoints, p, edges);
   *edges_ret = edges;
+}
+
+// Parallel triangulation of large point sets.
+//
+// The sorted points are cut into strips at changes of x, so that strips
+// are separated by vertical lines. Each strip is triangulated on its own
+// (concurrently with OpenMP), then neighbouring strips are merged pairwise,
+// log2(nstrips) rounds of concurrent merges. A merge walks up the gap
+// between the two convex hulls from their lower to their upper common
+// tangent, adding one triangle per step, and then restores the Delaunay
+// property with the edge swaps used by triangulate (tt_swap), starting
+// from the new edges and the hull edges they cover.
+//
+// Strip s owns points [first[s],first[s+1]) and edge slots
+// [3*first[s],3*first[s+1]). A triangulation of n points with h of them
+// on the hull has 3n-3-h edges, so the unused slots of the strips of a
+// merged group always hold the edges added by its merges. Concurrent
+// merges thus never touch the same points or edges. The slots are
+// compacted once at the end.
+//
+// The number of strips depends on the number of points only, so the
+// result does not depend on the number of threads.
+
+static int min_strip_points = 65536; // do not split below this many points
+static const int max_strips = 64;
+
+void tt_set_min_strip_points(int n){ min_strip_points = n; }
+
+class strip_set{
+  const strip_set &operator=( const strip_set & );
+  strip_set( const strip_set & );
+public:
+  strip_set(int npoints, int ns, const point *pp);
+  ~strip_set();
+  bool triangulate_strip(int s);
+  bool merge(int sa, int sm, int sb);
+  int compact();
+
+  const int nstrips;
+  const point *p;
+  edge *edges;
+  int *first;  // first point of each strip (nstrips+1 entries)
+private:
+  int new_edge(int &s, int send);
+  int *hnext, *hprev; // counterclockwise neighbours of a point on its hull
+  int *hout;   // hull edge from a point to hnext
+  int *free_begin, *free_end; // unused edge slots of each strip
+};
+
+strip_set::strip_set(int npoints, int ns, const point *pp) :
+  nstrips(ns), p(pp),
+  edges(new edge[3*npoints]),
+  first(new int[ns+1]),
+  hnext(new int[npoints]), hprev(new int[npoints]), hout(new int[npoints]),
+  free_begin(new int[ns]), free_end(new int[ns])
+{}
+
+strip_set::~strip_set(){
+  delete [] edges;
+  delete [] first;
+  delete [] hnext; delete [] hprev; delete [] hout;
+  delete [] free_begin; delete [] free_end;
+}
+
+// Triangulate strip s into its edge slots and record its hull.
+bool strip_set::triangulate_strip(int s){
+  const int a = first[s], z = first[s+1]-1;
+  // triangulate bails out if all points are aligned
+  if (z-a < 2)
+    return false;
+  int k=a+1;
+  while (k<z && orient2d(a,z,k,p)==0.) ++k;
+  if (k==z)
+    return false;
+
+  const int base = 3*a;
+  edge *e = edges+base;
+  const int ne = triangulate_into(z-a+1, p+a, e);
+  for(int i=0;i<ne;++i){
+    e[i].from += a;
+    e[i].to += a;
+    if (e[i].lef != edge::none) e[i].lef += base;
+    if (e[i].let != edge::none) e[i].let += base;
+    if (e[i].ref != edge::none) e[i].ref += base;
+    if (e[i].ret != edge::none) e[i].ret += base;
+    // hull edges are counterclockwise: the strip lies on their left
+    if (e[i].ref == edge::none){
+      if (e[i].lef == edge::none)
+	return false;
+      hnext[e[i].from] = e[i].to;
+      hprev[e[i].to] = e[i].from;
+      hout[e[i].from] = base+i;
+    }
+  }
+  free_begin[s] = base+ne;
+  free_end[s] = 3*(z+1);
+  return true;
+}
+
+// Take an unused edge slot from the strips [s,send).
+int strip_set::new_edge(int &s, int send){
+  while (s<send && free_begin[s]==free_end[s]) ++s;
+  if (s==send)
+    return edge::none;
+  return free_begin[s]++;
+}
+
+// Merge the triangulation of strips [sa,sm) with that of strips [sm,sb).
+bool strip_set::merge(int sa, int sm, int sb){
+  // lower and upper common tangents, starting from the rightmost point
+  // of the left part and the leftmost point of the right one
+  int l = first[sm]-1, r = first[sm];
+  bool moved;
+  do {
+    moved = false;
+    while (orient2d(l,r,hprev[l],p) < 0.) { l = hprev[l]; moved = true; }
+    while (orient2d(l,r,hnext[r],p) < 0.) { r = hnext[r]; moved = true; }
+  } while (moved);
+  const int l0 = l, r0 = r;
+  l = first[sm]-1; r = first[sm];
+  do {
+    moved = false;
+    while (orient2d(l,r,hnext[l],p) > 0.) { l = hnext[l]; moved = true; }
+    while (orient2d(l,r,hprev[r],p) > 0.) { r = hprev[r]; moved = true; }
+  } while (moved);
+  const int lu = l, ru = r;
+
+  // number of hull edges on each side of the gap; if both tangents touch
+  // the same vertex, the gap takes in either all of that hull or none of it
+  int nl = 0, nr = 0;
+  for(l=l0; l!=lu; l=hnext[l]) ++nl;
+  for(r=r0; r!=ru; r=hprev[r]) ++nr;
+  if (l0==lu && orient2d(l0,r0,hnext[l0],p) > 0. &&
+      orient2d(l0,ru,hnext[l0],p) < 0.)
+    for(l=hnext[l0], nl=1; l!=l0; l=hnext[l]) ++nl;
+  if (r0==ru && orient2d(r0,lu,hprev[r0],p) > 0. &&
+      orient2d(r0,l0,hprev[r0],p) < 0.)
+    for(r=hprev[r0], nr=1; r!=r0; r=hprev[r]) ++nr;
+  if (nl+nr == 0 || (l0==lu && r0==ru))
+    return false;
+
+  // fill the gap bottom up; b is the cross edge (left to right) whose
+  // left side is still open
+  int slot = sa;
+  const int b0 = new_edge(slot, sb);
+  if (b0 == edge::none)
+    return false;
+  edges[b0].from = l0;
+  edges[b0].to = r0;
+  std::vector<int> to_check;
+  int b = b0;
+  l = l0; r = r0;
+  while (nl>0 || nr>0){
+    const int ln = hnext[l], rn = hprev[r];
+    const int lp = hprev[l], rnx = hnext[r];
+    // ln is a candidate if l, r, ln is a proper triangle, and the new
+    // edge r-ln leaves r outside the right hull, whose corner at r is
+    // spanned by rn-r and r-rnx, and does not enclose rn (and likewise
+    // for rn).
+    const bool okL = nl>0 && orient2d(l,r,ln,p) > 0. &&
+      (orient2d(rn,r,ln,p) <= 0. || orient2d(r,rnx,ln,p) <= 0.) &&
+      !(orient2d(r,ln,rn,p) > 0. && orient2d(r,l,rn,p) < 0.);
+    const bool okR = nr>0 && orient2d(l,r,rn,p) > 0. &&
+      (orient2d(lp,l,rn,p) <= 0. || orient2d(l,ln,rn,p) <= 0.) &&
+      !(orient2d(l,r,ln,p) > 0. && orient2d(l,rn,ln,p) < 0.);
+    if (!okL && !okR)
+      return false;
+    const int n = new_edge(slot, sb);
+    if (n == edge::none)
+      return false;
+    if (okL && (!okR || !needswap(l,rn,ln,r,p))){
+      // triangle l, r, ln
+      const int h = hout[l];
+      edges[n].from = ln; edges[n].to = r;
+      edges[b].lef = h; edges[b].let = n;
+      edges[h].ref = b; edges[h].ret = n;
+      edges[n].ref = h; edges[n].ret = b;
+      to_check.push_back(h);
+      l = ln;
+      --nl;
+    } else {
+      // triangle l, r, rn
+      const int h = hout[rn];
+      edges[n].from = l; edges[n].to = rn;
+      edges[b].lef = n; edges[b].let = h;
+      edges[h].ref = n; edges[h].ret = b;
+      edges[n].ref = b; edges[n].ret = h;
+      to_check.push_back(h);
+      r = rn;
+      --nr;
+    }
+    to_check.push_back(n);
+    b = n;
+  }
+  // turn the upper tangent round so that the merged hull is
+  // counterclockwise
+  {
+    edge &u = edges[b];
+    const int f = u.from;
+    u.from = u.to;
+    u.to = f;
+    u.lef = u.ret;
+    u.let = u.ref;
+    u.ref = edge::none;
+    u.ret = edge::none;
+  }
+  hnext[l0] = r0; hprev[r0] = l0; hout[l0] = b0;
+  hnext[ru] = lu; hprev[lu] = ru; hout[ru] = b;
+
+  for(size_t i=0;i<to_check.size();++i)
+    tt_swap(to_check[i],edges,p);
+  return true;
+}
+
+// Squeeze out the unused slots. Returns the number of edges.
+int strip_set::compact(){
+  const int nslots = 3*first[nstrips];
+  int *newidx = new int[nslots];
+  int nedges = 0;
+  for(int i=0;i<nslots;++i)
+    newidx[i] = (edges[i].from != edge::end) ? nedges++ : edge::none;
+  // newidx[i] <= i, so the edges can be moved down in place
+  for(int i=0;i<nslots;++i){
+    if (newidx[i] == edge::none) continue;
+    edge &e = edges[newidx[i]];
+    e.from = edges[i].from;
+    e.to = edges[i].to;
+    e.lef = (edges[i].lef != edge::none) ? newidx[edges[i].lef] : edge::none;
+    e.let = (edges[i].let != edge::none) ? newidx[edges[i].let] : edge::none;
+    e.ref = (edges[i].ref != edge::none) ? newidx[edges[i].ref] : edge::none;
+    e.ret = (edges[i].ret != edge::none) ? newidx[edges[i].ret] : edge::none;
+  }
+  for(int i=nedges;i<nslots;++i){
+    edges[i].from = edges[i].to = edge::end;
+    edges[i].lef = edges[i].let = edges[i].ref = edges[i].ret = edge::none;
+  }
+  delete [] newidx;
+  return nedges;
+}
+
+// Triangulate in strips if there are enough points. Returns false (and
+// leaves the work to triangulate) if the points are too few or a strip
+// is degenerate.
+static
+bool triangulate_strips(int npoints,const point p[],
+			int *pnedges, edge** edges_ret){
+  int nstrips = 1;
+  while (2*nstrips <= max_strips &&
+	 npoints/(2*nstrips) >= min_strip_points)
+    nstrips *= 2;
+  if (nstrips == 1)
+    return false;
+
+  strip_set S(npoints, nstrips, p);
+  S.first[0] = 0;
+  S.first[nstrips] = npoints;
+  for(int s=1;s<nstrips;++s){
+    int k = static_cast<int>(static_cast<long>(npoints)*s/nstrips);
+    if (k <= S.first[s-1]) k = S.first[s-1]+1;
+    while (k<npoints && p[k].x()==p[k-1].x()) ++k;
+    // a strip with a single x would be aligned: take in the next x too
+    if (k<npoints && p[k-1].x()==p[S.first[s-1]].x()) {
+      ++k;
+      while (k<npoints && p[k].x()==p[k-1].x()) ++k;
+    }
+    S.first[s] = k;
+  }
+
+  std::vector<char> ok(nstrips);
+  int s;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+  for(s=0;s<nstrips;++s)
+    ok[s] = S.triangulate_strip(s);
+
+  for(int width=1;width<nstrips;width*=2){
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+    for(s=0;s<nstrips-width;s+=2*width){
+      const int send = (s+2*width < nstrips) ? s+2*width : nstrips;
+      ok[s] = ok[s] && ok[s+width] && S.merge(s, s+width, send);
+    }
+  }
+  if (!ok[0]){
+    if (0) // DEBUG
+      std::cout << "triangulate_strips: falling back to serial" << std::endl;
+    return false;
+  }
 
+  *pnedges = S.compact();
+  *edges_ret = S.edges;
+  S.edges = 0;
+  return true;
 }
 
 #include "heapsort.h"
@@ -791,8 +1093,9 @@ void tt_sort_triangulate(int npoints, point *p,
     moved_duplicated_points(npoints, p, npoints_unique);
     *pnpoints_unique = npoints_unique;
 
-    //triangulate the set of points
-    triangulate(npoints_unique,p,pnedges, edges_ret);
+    //triangulate the set of points, in parallel strips if large enough
+    if (!triangulate_strips(npoints_unique,p,pnedges, edges_ret))
+      triangulate(npoints_unique,p,pnedges, edges_ret);
 
 #if defined(TIMING)
     time_t t2 = time(NULL);
@@ -35,6 +35,7 @@ void tt_sort_triangulate(int npoints, point *p,
 			 int *pnedges, edge** edges_ret,
 			 int *pnelem, elem** pelems_ret);
 void tt_sort_only( int npoints, point *p, int &npoints_unique );
+void tt_set_min_strip_points(int n);
 void tt_build_elem_table(int npoints, const point *p,
 			 int nedges, const edge* edges,
 			 int *pnelem, elem** pelems_ret);
@@ -10,6 +10,11 @@
 **   (with algorithms in predicates.cpp)
 **   g++ -DTIPPER_TEST TipperTriangulator_test.cpp TipperTriangulator.cpp
 **      TipperTriangulatorError.cpp ../Predicates/predicates.cpp
+**   (add -O2 -fopenmp for the parallel strip triangulation)
+**
+** Without arguments, triangulates the points in file "points". With an
+** argument n, triangulates n*n perturbed grid points serially and in
+** parallel strips, checks both and reports the throughput in points/s.
 **
 */
 /***************************************************************************/
@@ -18,10 +23,15 @@
 #include <iostream>
 #include <fstream>
 #include <stdlib.h>
+#include <time.h>
 #include <assert.h>
 
 #include "TipperTriangulator.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifndef DONT_USE_PREDICATE
 #include "../globalFns.h"
 Predicates predicate;
@@ -213,8 +223,72 @@ void test_triangulate_from_file(){
   delete [] p;
 }
 
+static
+double wall_time(){
+#ifdef _OPENMP
+  return omp_get_wtime();
+#else
+  return static_cast<double>(clock())/CLOCKS_PER_SEC;
+#endif
+}
+
+#ifndef DONT_USE_PREDICATE
+// every interior edge must pass the empty circle test
+static
+void check_delaunay(int nedges, const edge *edges, const point *p){
+  int nbad = 0;
+  for(int i=0;i<nedges;++i){
+    const edge &e = edges[i];
+    if (e.lef == edge::none || e.ref == edge::none) continue;
+    const int leftp = (edges[e.lef].from==e.from) ?
+      edges[e.lef].to : edges[e.lef].from;
+    const int rightp = (edges[e.ref].from==e.from) ?
+      edges[e.ref].to : edges[e.ref].from;
+    if (predicate.incircle(p[e.from].XY(), p[e.to].XY(), p[leftp].XY(),
+			   p[rightp].XY()) > 0)
+      ++nbad;
+  }
+  if (nbad > 0)
+    cout << "ERR " << nbad << " edges are not Delaunay" << endl;
+  assert(nbad == 0);
+}
+#endif
+
+static
+void bench_triangulate(int n, int min_strip_points, const char *label){
+  const long npoints=long(n)*n;
+  point *p = new point[npoints];
+  generate_dataset(n,p);
+  tt_set_min_strip_points(min_strip_points);
+
+  int nedges, npoints_unique;
+  edge* edges = NULL;
+  const double t0 = wall_time();
+  tt_sort_triangulate(npoints,p,&npoints_unique,&nedges,&edges);
+  const double t1 = wall_time();
+  cout << label << ": npoints=" << npoints << " nedges=" << nedges
+       << " time=" << t1-t0 << " s, "
+       << static_cast<double>(npoints)/(t1-t0) << " points/s" << endl;
+
+  sanity_check_edge(edges);
+  sanity_check_ccwedge(nedges, edges);
+#ifndef DONT_USE_PREDICATE
+  check_delaunay(nedges, edges, p);
+#endif
+  delete [] edges;
+  delete [] p;
+}
+
 #if !defined(DONT_USE_MAIN)
-int main(void){
+int main(int argc, char **argv){
+
+  if (argc > 1) {
+    const int n = atoi(argv[1]);
+    bench_triangulate(n, n*n+1, "serial");
+    bench_triangulate(n, 65536, "strips");
+    return 0;
+  }
+
 
   switch(2){
   case 0:
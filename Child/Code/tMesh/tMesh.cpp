@@ -18,6 +18,8 @@
 #include "tMesh.h"
 
 #include <stdlib.h>
+#include <algorithm>
+#include <set>
 
 #include "ParamMesh_t.h"
 
@@ -77,9 +79,9 @@ int Next3Delaunay( tPtrList< tSubNode > & /*nbrList*/,
  \**************************************************************************/
 
 //copy constructor (created 11/99, GT)
-//WARNING: this constructor relies on the behavior of assignment operations
-//in tMeshList, tList, and tPtrList, which may or not give the desired
-//results! Caveat emptor! -GT
+//The lists are copied by value, so the copied elements at first still
+//point to the elements of the original mesh; RelinkCopiedElements then
+//redirects them to their counterparts in the copy (10/2026).
 template< class tSubNode >
 tMesh<tSubNode>::tMesh( tMesh const *originalMesh )
 :
@@ -93,11 +95,134 @@ nnodes(originalMesh->nnodes),
 nedges(originalMesh->nedges),
 ntri(originalMesh->ntri),
 miNextNodeID(originalMesh->miNextNodeID),
+miNextPermNodeID(originalMesh->miNextPermNodeID),
 miNextEdgID(originalMesh->miNextEdgID),
 miNextTriID(originalMesh->miNextTriID),
 layerflag(originalMesh->layerflag),
-runCheckMeshConsistency(originalMesh->runCheckMeshConsistency)
-{}
+runCheckMeshConsistency(originalMesh->runCheckMeshConsistency),
+miCheckMeshMode(originalMesh->miCheckMeshMode),
+miCheckMeshSample(originalMesh->miCheckMeshSample),
+miCheckSampleLeft(originalMesh->miCheckSampleLeft),
+mbCheckMeshFull(true),
+mCheckChangedNodes(),
+mCheckRand(originalMesh->mCheckRand),
+node_ID_generator(originalMesh->node_ID_generator),
+miGeomUpdateMode(originalMesh->miGeomUpdateMode),
+mbGeomFullUpdate(true),
+mbReorder(originalMesh->mbReorder),
+miNodesChangedSinceReorder(originalMesh->miNodesChangedSinceReorder),
+mlNodeListVersion(0),
+mbKineticMove(originalMesh->mbKineticMove),
+maxXdomain(originalMesh->maxXdomain),
+maxYdomain(originalMesh->maxYdomain)
+{
+  RelinkCopiedElements( const_cast< tMesh * >( originalMesh ) );
+}
+
+/************************************************************************** **
+ **  tMesh::RelinkCopiedElements
+ **
+ **  Called by the copy constructor, once the node, edge and triangle
+ **  lists have been copied from those of orig. Each copied element still
+ **  points to nodes, edges and triangles of orig; here every such pointer
+ **  is replaced by a pointer to the element at the same place in the
+ **  lists of this mesh. As in ReorderHilbert, the elements of orig are
+ **  numbered by their place in the lists so that pointers can be looked
+ **  up by ID; their own IDs are put back afterwards, which the copies
+ **  kept.
+ **
+ **  Copying the triangles has also pointed the edges of orig at the
+ **  copied triangles (see tTriangle::setEPtr), which is undone here too.
+ **
+ **  Created: 10/2026
+ **
+ \**************************************************************************/
+template< class tSubNode >
+void tMesh<tSubNode>::RelinkCopiedElements( tMesh *orig )
+{
+  const int nn = nodeList.getSize();
+  const int ne = edgeList.getSize();
+  const int nt = triList.getSize();
+  assert( nn == orig->nodeList.getSize() && ne == orig->edgeList.getSize()
+          && nt == orig->triList.getSize() );
+  nodeListIter_t niter( nodeList ), oniter( orig->nodeList );
+  edgeListIter_t eiter( edgeList ), oeiter( orig->edgeList );
+  triListIter_t titer( triList ), otiter( orig->triList );
+  std::vector< tSubNode * > nodes( nn );
+  std::vector< tEdge * > edges( ne );
+  std::vector< tTriangle * > tris( nt );
+  std::vector< int > nodeIDs( nn ), edgeIDs( ne ), triIDs( nt );
+  tSubNode *cn;
+  tEdge *ce;
+  tTriangle *ct;
+  int i;
+
+  // Number the elements of orig by their place in the lists
+  for( cn = oniter.FirstP(), i = 0; !(oniter.AtEnd()); cn = oniter.NextP(), ++i )
+  {
+    nodeIDs[i] = cn->getID();
+    cn->setID( i );
+  }
+  for( ce = oeiter.FirstP(), i = 0; !(oeiter.AtEnd()); ce = oeiter.NextP(), ++i )
+  {
+    edgeIDs[i] = ce->getID();
+    ce->setID( i );
+  }
+  for( ct = otiter.FirstP(), i = 0; !(otiter.AtEnd()); ct = otiter.NextP(), ++i )
+  {
+    triIDs[i] = ct->getID();
+    ct->setID( i );
+  }
+  for( cn = niter.FirstP(), i = 0; !(niter.AtEnd()); cn = niter.NextP(), ++i )
+    nodes[i] = cn;
+  for( ce = eiter.FirstP(), i = 0; !(eiter.AtEnd()); ce = eiter.NextP(), ++i )
+    edges[i] = ce;
+  for( ct = titer.FirstP(), i = 0; !(titer.AtEnd()); ct = titer.NextP(), ++i )
+    tris[i] = ct;
+
+  // Redirect the pointers of the copies
+  for( i = 0; i < ne; ++i )
+  {
+    ce = edges[i];
+    ce->setOriginPtr( nodes[ce->getOriginPtr()->getID()] );
+    ce->setDestinationPtr( nodes[ce->getDestinationPtr()->getID()] );
+    ce->setCCWEdg( edges[ce->getCCWEdg()->getID()] );
+    ce->setCWEdg( edges[ce->getCWEdg()->getID()] );
+    ce->setComplementEdge( edges[ce->getComplementEdge()->getID()] );
+    ce->setTri( 0 );
+  }
+  for( i = 0; i < nt; ++i )
+  {
+    ct = tris[i];
+    for( int k = 0; k < 3; ++k )
+    {
+      ct->setPPtr( k, nodes[ct->pPtr(k)->getID()] );
+      ct->setEPtr( k, edges[ct->ePtr(k)->getID()] );
+      ct->setTPtr( k, ( ct->tPtr(k) != 0 ) ? tris[ct->tPtr(k)->getID()] : 0 );
+    }
+  }
+  for( cn = oniter.FirstP(), i = 0; !(oniter.AtEnd()); cn = oniter.NextP(), ++i )
+  {
+    // the copy constructors of some node types drop some edge pointers
+    // (e.g. tLNode's flow edge), so read them from orig
+    tArray< int > ids = cn->getEdgePtrIndices();
+    std::vector< tEdge * > ptrs( ids.getSize() );
+    for( size_t k = 0; k < ids.getSize(); ++k )
+      ptrs[k] = ( ids[k] >= 0 ) ? edges[ids[k]] : 0;
+    nodes[i]->setEdgePtrsFromVector( ptrs );
+  }
+
+  // Give orig back its own triangles and IDs
+  for( ct = otiter.FirstP(); !(otiter.AtEnd()); ct = otiter.NextP() )
+    for( int k = 0; k < 3; ++k )
+      ct->ePtr(k)->setTri( ct );
+  for( cn = oniter.FirstP(), i = 0; !(oniter.AtEnd()); cn = oniter.NextP(), ++i )
+    cn->setID( nodeIDs[i] );
+  for( ce = oeiter.FirstP(), i = 0; !(oeiter.AtEnd()); ce = oeiter.NextP(), ++i )
+    ce->setID( edgeIDs[i] );
+  for( ct = otiter.FirstP(), i = 0; !(otiter.AtEnd()); ct = otiter.NextP(), ++i )
+    ct->setID( triIDs[i] );
+}
 
 
 /**************************************************************************\
@@ -141,7 +266,19 @@ miNextPermNodeID(0),
 miNextEdgID(0),
 miNextTriID(0),
 layerflag(false),
-runCheckMeshConsistency(checkMeshConsistency)
+runCheckMeshConsistency(checkMeshConsistency),
+miCheckMeshMode(kCheckMeshFull),
+miCheckMeshSample(0),
+miCheckSampleLeft(0),
+mbCheckMeshFull(true),
+mCheckChangedNodes(),
+mCheckRand(1),
+miGeomUpdateMode(kGeomUpdateLocal),
+mbGeomFullUpdate(true),
+mbReorder(false),
+miNodesChangedSinceReorder(0),
+mlNodeListVersion(0),
+mbKineticMove(false)
 {
   // mSearchOriginTriPtr:
   // initially set search origin (tTriangle*) to zero:
@@ -150,6 +287,33 @@ runCheckMeshConsistency(checkMeshConsistency)
   // As "layerflag" is used in this constructor, we compute it now.
   layerflag =  infile.ReadBool( "OPTINTERPLAYER" );
 
+  // Voronoi geometry update strategy; local unless asked otherwise
+  // (0=local, 1=full recompute, 2=local checked against full)
+  {
+    const int geomMode = infile.ReadInt( "OPT_MESH_GEOMETRY_UPDATE", false );
+    if( geomMode < kGeomUpdateLocal || geomMode > kGeomUpdateValidate )
+      ReportFatalError( "OPT_MESH_GEOMETRY_UPDATE must be 0 (local), "
+                        "1 (full) or 2 (validate)." );
+    miGeomUpdateMode = static_cast<kGeomUpdate_t>( geomMode );
+  }
+
+  // Mesh consistency checks, when enabled: which elements to check
+  // (0=all, 1=changed since last check, 2=random sample, 3=all, threaded)
+  {
+    const int checkMode = infile.ReadInt( "OPT_CHECK_MESH_MODE", false );
+    if( checkMode < kCheckMeshFull || checkMode > kCheckMeshParallel )
+      ReportFatalError( "OPT_CHECK_MESH_MODE must be 0 (full), "
+                        "1 (incremental), 2 (sampled) or 3 (parallel)." );
+    miCheckMeshMode = static_cast<kCheckMesh_t>( checkMode );
+    if( miCheckMeshMode == kCheckMeshSampled )
+    {
+      miCheckMeshSample = infile.ReadInt( "CHECK_MESH_SAMPLE" );
+      if( miCheckMeshSample < 1 )
+        ReportFatalError( "CHECK_MESH_SAMPLE must be at least 1." );
+      miCheckSampleLeft = miCheckMeshSample;
+    }
+  }
+
   // option for reading/generating initial mesh
   int read;
   read = infile.ReadItem( read, "OPTREADINPUT" );
@@ -215,6 +379,14 @@ runCheckMeshConsistency(checkMeshConsistency)
       break;
   }
 
+  // Option for keeping the element lists in Hilbert order
+  mbReorder = infile.ReadBool( "OPT_MESH_REORDER", false );
+  if( mbReorder )
+    ReorderHilbert();
+
+  // Option for updating the triangulation kinetically when nodes move
+  mbKineticMove = infile.ReadBool( "OPT_KINETIC_MOVE", false );
+
   // find geometric center of domain:
   double cx = 0.0;
   double cy = 0.0;
@@ -283,7 +455,20 @@ miNextNodeID(0),
 miNextPermNodeID(0),
 miNextEdgID(0),
 miNextTriID(0),
-layerflag(false)
+layerflag(false),
+runCheckMeshConsistency(true),
+miCheckMeshMode(kCheckMeshFull),
+miCheckMeshSample(0),
+miCheckSampleLeft(0),
+mbCheckMeshFull(true),
+mCheckChangedNodes(),
+mCheckRand(1),
+miGeomUpdateMode(kGeomUpdateLocal),
+mbGeomFullUpdate(true),
+mbReorder(false),
+miNodesChangedSinceReorder(0),
+mlNodeListVersion(0),
+mbKineticMove(false)
 {
   // do what MakeMeshFromPointsTipper does:
   int numpts = x.getSize();                      // no. of points in mesh
@@ -550,16 +735,16 @@ MeshDensification( const tInputFile &infile )
         }
       }
 
-      // Now loop through and add the nodes
+      // Now add the nodes in one batch (AddNodes assigns the IDs)
       {
+        tList< tSubNode > newNodes;
         for( int i=0; i<nnewpoints; i++ )
         {
           tempnode.set3DCoords( newx[i], newy[i], newz[i] );  // assign them
-          miNextNodeID = nnodes+i;      // TODO: shouldn't this be nnodes+1??
-          tempnode.setID( miNextNodeID );
-          tempnode.setPermID( node_ID_generator.getNextID() );
-          AddNode( tempnode );        // Add the new node
+          newNodes.insertAtBack( tempnode );
         }
+        miNextNodeID = nnodes;
+        AddNodes( newNodes, kNoUpdateMesh );
       }
     }  // end of current densification level
   } // end of optional mesh densification
@@ -2874,6 +3059,7 @@ ConvertToOpenBoundary( nodeListNode_t *listNode )
   nodeList.moveToBoundFront( listNode );
   // reset boundary flag (must be done after changing place in list):
   node->setBoundaryFlag( kOpenBoundary );
+  MarkGeometryChanged( node );
 
   edgeListIter_t eI( edgeList );
   // go through spokes (edges):
@@ -3034,6 +3220,26 @@ MakeStreamLineBoundaries( tPtrList< tSubNode > &streamList )
  **     - If an opposite triange Ti does not exist, points P((i+1)%3) and
  **       and P((i+2)%3) should both be boundary points.
  **
+ **  Which elements are checked depends on OPT_CHECK_MESH_MODE:
+ **   0 (kCheckMeshFull): all of them, as above;
+ **   1 (kCheckMeshIncremental): the nodes recorded by MarkGeometryChanged
+ **     since the last check, their spokes and the triangles around them
+ **     (any element changed by AddEdge, DeleteEdge or FlipEdge, or
+ **     deformed by a moving node, is among these). A full check is done
+ **     the first time and after InvalidateGeometry;
+ **   2 (kCheckMeshSampled): edge pairs, nodes and triangles picked at
+ **     random, CHECK_MESH_SAMPLE of each per time step (see
+ **     StartCheckMeshStep) however many checks the step makes: each
+ **     check takes what is left of the step's budget, so once it is
+ **     spent the checks of the rest of the step do nothing;
+ **   3 (kCheckMeshParallel): all of them, checked by several threads
+ **     (with OpenMP). The first failure reported is the same as in the
+ **     serial check.
+ **  The list order of edge pairs (each edge followed by its complement,
+ **  which points back to it) and the active/boundary lists are only
+ **  checked by the full modes. The tests on each element are made by
+ **  CheckEdgeConsistency, CheckNodeConsistency and CheckTriConsistency.
+ **
  **      Parameters:  boundaryCheckFlag -- defaults to TRUE; if FALSE,
  **                                        node connection to open node or
  **                                        open boundary isn't tested
@@ -3049,6 +3255,8 @@ MakeStreamLineBoundaries( tPtrList< tSubNode > &streamList )
  **               boundary checks can be disabled when the routine is called
  **               in the middle of mesh creation operation as a debug/test
  **               helper.
+ **        - 10/2026 split into per-element tests; incremental, sampled
+ **               and parallel modes (OPT_CHECK_MESH_MODE).
  **
  \*****************************************************************************/
 #define kMaxSpokes 1000
@@ -3061,268 +3269,508 @@ CheckMeshConsistency( bool boundaryCheckFlag /* default: true */)
 
   if(1) std::cout << "CheckMeshConsistency() ...\n";
 
-  nodeListIter_t nodIter( nodeList );
-  edgeListIter_t edgIter( edgeList );
-  triListIter_t triIter( triList );
-  tNode * cn;
-  tEdge * ce, * cne;
-  tTriangle * ct, * optr;
-  bool boundary_check_ok;
   const bool verbose = true;
-  int i, nvop;
-
-  // Edges: make sure complementary pairs are together in the list
-  // (each pair Ei and Ei+1, for i=0,2,4,...nedges-1, should have the same
-  // endpoints but the opposite orientation)
-  for( ce=edgIter.FirstP(); !(edgIter.AtEnd()); ce=edgIter.NextP() )
+  kCheckMesh_t mode = miCheckMeshMode;
+  if( mode == kCheckMeshIncremental && mbCheckMeshFull )
+    mode = kCheckMeshFull;
+  std::vector< tEdge * > edges;
+  std::vector< tNode * > nodes;
+  std::vector< tTriangle * > tris;
+
+  if( mode == kCheckMeshFull || mode == kCheckMeshParallel )
   {
-    assert( ce != NULL);
-    cne = edgIter.NextP();
-    assert( cne != NULL);
-    if( ce->getOriginPtrNC() != cne->getDestinationPtrNC()
-       || ce->getDestinationPtrNC() != cne->getOriginPtrNC() )
+    edgeListIter_t edgIter( edgeList );
+    nodeListIter_t nodIter( nodeList );
+    triListIter_t triIter( triList );
+    tEdge * ce, * cne;
+
+    // Edges: make sure complementary pairs are together in the list
+    // (each pair Ei and Ei+1, for i=0,2,4,...nedges-1, should have the same
+    // endpoints but the opposite orientation)
+    for( ce=edgIter.FirstP(); !(edgIter.AtEnd()); ce=edgIter.NextP() )
     {
-      std::cerr << "EDGE #" << ce->getID()
-      << " must be followed by its complement in the list\n";
+      assert( ce != NULL);
+      cne = edgIter.NextP();
+      assert( cne != NULL);
+      if( ce->getOriginPtrNC() != cne->getDestinationPtrNC()
+         || ce->getDestinationPtrNC() != cne->getOriginPtrNC() )
+      {
+        std::cerr << "EDGE #" << ce->getID()
+        << " must be followed by its complement in the list\n";
+        goto error;
+      }
+      if( ce->getComplementEdge() != cne
+         || ce != cne->getComplementEdge() )
+      {
+        std::cerr << "EDGE #" << ce->getID() << " EDGE #" << cne->getID()
+        << " do not point to each other\n";
+        goto error;
+      }
+      if( ce->getID()%2 != 0 || cne->getID()%2 != 1 )
+      {
+        std::cerr << "EDGE #" << ce->getID()
+        << " and EDGE #" << cne->getID()
+        << " should have respectively an even and odd ID.\n";
+        goto error;
+      }
+      edges.push_back( ce );
+    }
+    // Edges and nodes: check active/boundary lists
+    if (edgeList.CheckConsistency("edge"))
       goto error;
+    if (nodeList.CheckConsistency("node"))
+      goto error;
+
+    nodes.reserve( nodeList.getSize() );
+    for( tNode *cn=nodIter.FirstP(); !(nodIter.AtEnd()); cn=nodIter.NextP() )
+      nodes.push_back( cn );
+    tris.reserve( triList.getSize() );
+    for( tTriangle *ct=triIter.FirstP(); !(triIter.AtEnd());
+         ct=triIter.NextP() )
+      tris.push_back( ct );
+  }
+  else if( mode == kCheckMeshIncremental )
+  {
+    // The nodes recorded by MarkGeometryChanged, their spokes (either
+    // half of each pair, normalized to the even one) and the triangles
+    // they are a vertex of.
+    PurgeForgottenNodes( mCheckChangedNodes, mCheckForgotten );
+    tPtrListIter< tSubNode > cI( mCheckChangedNodes );
+    for( tSubNode *cn = cI.FirstP(); !(cI.AtEnd()); cn = cI.NextP() )
+    {
+      nodes.push_back( cn );
+      tEdge * const ce0 = cn->getEdg();
+      tEdge *ce = ce0;
+      int nspokes = 0;
+      // a broken spoke ring is reported by CheckNodeConsistency
+      while( ce != NULL && nspokes++ <= kMaxSpokes )
+      {
+        tEdge * const cne = ce->getComplementEdge();
+        edges.push_back( ( ce->getID()%2 != 0 && cne != NULL ) ? cne : ce );
+        tTriangle * const ct = ce->TriWithEdgePtr();
+        if( ct != NULL ) tris.push_back( ct );
+        if( (ce = ce->getCCWEdg()) == ce0 ) break;
+      }
     }
-    if( ce->getComplementEdge() != cne
-       || ce != cne->getComplementEdge() )
+    std::sort( nodes.begin(), nodes.end() );
+    nodes.erase( std::unique( nodes.begin(), nodes.end() ), nodes.end() );
+    std::sort( edges.begin(), edges.end() );
+    edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+    std::sort( tris.begin(), tris.end() );
+    tris.erase( std::unique( tris.begin(), tris.end() ), tris.end() );
+  }
+  else if( miCheckSampleLeft > 0 )
+  {
+    SampleCheckElements( edges, nodes, tris );
+    miCheckSampleLeft = 0;
+  }
+
+  {
+    // Check edges, then nodes, then triangles. The parallel loop finds
+    // the first inconsistent element in that order, as the serial one
+    // does, and the test is repeated to report it.
+    const long nedg = static_cast<long>( edges.size() );
+    const long nnod = static_cast<long>( nodes.size() );
+    const long ntot = nedg + nnod + static_cast<long>( tris.size() );
+    long bad = ntot;
+    long k;
+    if( mode == kCheckMeshParallel )
     {
-      std::cerr << "EDGE #" << ce->getID() << " EDGE #" << cne->getID()
-      << " do not point to each other\n";
-      goto error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,256)
+#endif
+      for( k=0; k<ntot; ++k )
+      {
+        const bool ok = k < nedg ? CheckEdgeConsistency( edges[k], false )
+          : k < nedg+nnod ?
+          CheckNodeConsistency( nodes[k-nedg], boundaryCheckFlag, false )
+          : CheckTriConsistency( tris[k-nedg-nnod], false );
+        if( !ok )
+        {
+#ifdef _OPENMP
+#pragma omp critical(CheckMeshConsistency)
+#endif
+          if( k < bad ) bad = k;
+        }
+      }
+    }
+    else
+    {
+      for( k=0; k<ntot && bad==ntot; ++k )
+      {
+        const bool ok = k < nedg ? CheckEdgeConsistency( edges[k], false )
+          : k < nedg+nnod ?
+          CheckNodeConsistency( nodes[k-nedg], boundaryCheckFlag, false )
+          : CheckTriConsistency( tris[k-nedg-nnod], false );
+        if( !ok ) bad = k;
+      }
     }
-    if( ce->getID()%2 != 0 || cne->getID()%2 != 1 )
+    if( bad < nedg )
     {
-      std::cerr << "EDGE #" << ce->getID()
-      << " and EDGE #" << cne->getID()
-      << " should have respectively an even and odd ID.\n";
+      CheckEdgeConsistency( edges[bad], true );
       goto error;
     }
-    if (!ce->CheckConsistency())
+    if( verbose )
+      std::cout << "EDGES PASSED\n";
+    if( bad < nedg+nnod )
+    {
+      CheckNodeConsistency( nodes[bad-nedg], boundaryCheckFlag, true );
       goto error;
-    if (!cne->CheckConsistency())
+    }
+    if( verbose )
+      std::cout << "NODES PASSED\n";
+    if( bad < ntot )
+    {
+      CheckTriConsistency( tris[bad-nedg-nnod], true );
       goto error;
+    }
+    if( verbose )
+      std::cout << "TRIANGLES PASSED\n";
+    if( verbose && mode != kCheckMeshFull && mode != kCheckMeshParallel )
+      std::cout << nedg << " edges, " << nnod << " nodes and "
+                << ntot-nedg-nnod << " triangles checked\n";
   }
-
-  // Edges: check active/boundary list
-  if (edgeList.CheckConsistency("edge"))
-    goto error;
   if (verbose)
-    std::cout << "EDGES PASSED\n";
+    std::cout << "MESH PASSED\n";
+  mCheckChangedNodes.Flush();
+  mCheckForgotten.clear();
+  mbCheckMeshFull = false;
+  return;
+
+error:
+  ReportFatalError( "Error in mesh consistency." );
+
+}
+
+/*****************************************************************************\
+ **
+ **  tMesh::CheckEdgeConsistency / CheckNodeConsistency / CheckTriConsistency
+ **
+ **  The tests CheckMeshConsistency makes on each edge (with its
+ **  complement), node and triangle. They return false on the first
+ **  failure, which is described on std::cerr if "report" is set.
+ **
+ **      Created: 10/2026, from CheckMeshConsistency
+ **
+ \*****************************************************************************/
+template<class tSubNode>
+bool tMesh< tSubNode >::
+CheckEdgeConsistency( tEdge *ce, bool report ) const
+{
+  std::ostream quiet( 0 );
+  std::ostream &err = report ? std::cerr : quiet;
+  tEdge * const cne = ce->getComplementEdge();
+
+  if( cne == NULL || ce != cne->getComplementEdge() )
+  {
+    err << "EDGE #" << ce->getID() << " EDGE #"
+    << ( cne != NULL ? cne->getID() : -1 )
+    << " do not point to each other\n";
+    return false;
+  }
+  if( ce->getOriginPtrNC() != cne->getDestinationPtrNC()
+     || ce->getDestinationPtrNC() != cne->getOriginPtrNC() )
+  {
+    err << "EDGE #" << ce->getID() << " and its complement EDGE #"
+    << cne->getID() << " do not have the same endpoints\n";
+    return false;
+  }
+  if( (ce->getID() + cne->getID())%2 != 1 )
+  {
+    err << "EDGE #" << ce->getID()
+    << " and EDGE #" << cne->getID()
+    << " should have respectively an even and odd ID.\n";
+    return false;
+  }
+  if (!ce->CheckConsistency())
+    return false;
+  if (!cne->CheckConsistency())
+    return false;
+  return true;
+}
+
+template<class tSubNode>
+bool tMesh< tSubNode >::
+CheckNodeConsistency( tNode *cn, bool boundaryCheckFlag, bool report ) const
+{
+  std::ostream quiet( 0 );
+  std::ostream &err = report ? std::cerr : quiet;
+  tEdge * ce;
+
+  // edg pointer
+  if( (ce = cn->getEdg()) == NULL)
+  {
+    err << "NODE #" << cn->getID()
+    << " does not point to a valid edge\n";
+    return false;
+  }
+  if( ce->getOriginPtrNC()!=cn )
+  {
+    err << "NODE #" << cn->getID()
+    << " points to an edge that has a different origin\n";
+    return false;
+  }
 
-  // Nodes: check for valid edg pointer, spoke connectivity, and connection
-  // to at least one non-boundary or open boundary node
-  for( cn=nodIter.FirstP(); !(nodIter.AtEnd()); cn=nodIter.NextP() )
+  // Boundary check and spoke consistency: if node is NOT a boundary,
+  // it should be adjacent to at least one non-boundary or open boundary
+  // point. Here we also test for an infinite loop in spoke connectivity.
+  //   (Note that the boundary test always passes if the boundaryCheckFlag
+  // is FALSE, meaning that we're in the middle of an operation that
+  // could legitimately add open points without connection to an
+  // open node or boundary --- this is added to allow for frequent
+  // consistency checks even in the middle of mesh creation operations,
+  // for testing/debugging purposes).
+  bool boundary_check_ok = ( cn->getBoundaryFlag()==kNonBoundary &&
+                             boundaryCheckFlag ) ? false : true;
+  int i = 0;
+  // Loop around the spokes until we're back at the beginning
+  do
   {
-    // edg pointer
-    if( (ce = cn->getEdg()) == NULL)
+    if( ce == NULL )
     {
-      std::cerr << "NODE #" << cn->getID()
-      << " does not point to a valid edge\n";
-      goto error;
+      err << "NODE #" << cn->getID()
+      << " has a spoke without a counter-clockwise edge\n";
+      return false;
     }
-    if( ce->getOriginPtrNC()!=cn )
+    if( ce->getDestinationPtrNC()->getBoundaryFlag()!=kClosedBoundary )
+      boundary_check_ok = true;  // OK, there's at least one open nbr
+    i++;
+    if( i>kMaxSpokes ) // Uh-oh, an infinite loop
     {
-      std::cerr << "NODE #" << cn->getID()
-      << " points to an edge that has a different origin\n";
-      goto error;
+      err << "NODE #" << cn->getID()
+      << " has more than " << kMaxSpokes << " spokes.\n";
+      err << "This error can result from a very high differential "
+      << "mesh resolution.\n"
+      << "Check input parameters controlling mesh densification.\n";
+      return false;
     }
 
-    // Boundary check and spoke consistency: if node is NOT a boundary,
-    // it should be adjacent to at least one non-boundary or open boundary
-    // point. Here we also test for an infinite loop in spoke connectivity.
-    //   (Note that the boundary test always passes if the boundaryCheckFlag
-    // is FALSE, meaning that we're in the middle of an operation that
-    // could legitimately add open points without connection to an
-    // open node or boundary --- this is added to allow for frequent
-    // consistency checks even in the middle of mesh creation operations,
-    // for testing/debugging purposes).
-    boundary_check_ok = ( cn->getBoundaryFlag()==kNonBoundary &&
-                         boundaryCheckFlag ) ? false : true;
-    i = 0;
-    // Loop around the spokes until we're back at the beginning
-    do
+    // Make sure node is the origin --- and not the destination
+    if( ce->getOriginPtrNC()!=cn )
     {
-
-      if( ce->getDestinationPtrNC()->getBoundaryFlag()!=kClosedBoundary )
-        boundary_check_ok = true;  // OK, there's at least one open nbr
-      i++;
-      if( i>kMaxSpokes ) // Uh-oh, an infinite loop
-      {
-        std::cerr << "NODE #" << cn->getID()
-        << " has more than " << kMaxSpokes << " spokes.\n";
-        std::cerr << "This error can result from a very high differential "
-        << "mesh resolution.\n"
-        << "Check input parameters controlling mesh densification.\n";
-        goto error;
-      }
-
-      // Make sure node is the origin --- and not the destination
-      if( ce->getOriginPtrNC()!=cn )
-      {
-        std::cerr << "EDGE #" << ce->getID()
-        << " is in the spoke chain of NODE " << cn->getID()
-        << " but does not have the node as an origin\n";
-        goto error;
-      }
-      if( ce->getDestinationPtrNC()==cn )
-      {
-        std::cerr << "EDGE #" << ce->getID()
-        << " is in the spoke chain of NODE " << cn->getID()
-        << " but has the node as its destination\n";
-        goto error;
-      }
-
-    } while( (ce=ce->getCCWEdg())!=cn->getEdg() );
-    if( !boundary_check_ok )
+      err << "EDGE #" << ce->getID()
+      << " is in the spoke chain of NODE " << cn->getID()
+      << " but does not have the node as an origin\n";
+      return false;
+    }
+    if( ce->getDestinationPtrNC()==cn )
     {
-      std::cerr << "NODE #" << cn->getID()
-      << " is surrounded by closed boundary nodes\n";
-      goto error;
+      err << "EDGE #" << ce->getID()
+      << " is in the spoke chain of NODE " << cn->getID()
+      << " but has the node as its destination\n";
+      return false;
     }
 
-    //make sure node coords are consistent with edge endpoint coords:
-    tSpkIter sIter( cn );
-    for( ce = sIter.FirstP(); !(sIter.AtEnd()); ce = sIter.NextP() )
+  } while( (ce=ce->getCCWEdg())!=cn->getEdg() );
+  if( !boundary_check_ok )
+  {
+    err << "NODE #" << cn->getID()
+    << " is surrounded by closed boundary nodes\n";
+    return false;
+  }
+
+  //make sure node coords are consistent with edge endpoint coords:
+  tSpkIter sIter( cn );
+  for( ce = sIter.FirstP(); !(sIter.AtEnd()); ce = sIter.NextP() )
+  {
+    if( ce->getOriginPtrNC()->getX() != cn->getX() ||
+       ce->getOriginPtrNC()->getY() != cn->getY() )
     {
-      if( ce->getOriginPtrNC()->getX() != cn->getX() ||
-         ce->getOriginPtrNC()->getY() != cn->getY() )
-      {
-        std::cerr << "NODE #" << cn->getID()
-        << " coords don't match spoke origin coords\n";
-        goto error;
-      }
+      err << "NODE #" << cn->getID()
+      << " coords don't match spoke origin coords\n";
+      return false;
     }
-
   }
-  // Nodes: check active/boundary list
-  if (nodeList.CheckConsistency("node"))
-    goto error;
-  if (verbose)
-    std::cout << "NODES PASSED\n";
+  return true;
+}
+
+template<class tSubNode>
+bool tMesh< tSubNode >::
+CheckTriConsistency( tTriangle *ct, bool report )
+{
+  std::ostream quiet( 0 );
+  std::ostream &err = report ? std::cerr : quiet;
+  tNode * cn;
+  tEdge * ce;
+  tTriangle * optr;
+  int i, nvop;
 
-  // Triangles: check for valid points and connectivity
-  for( ct=triIter.FirstP(); !(triIter.AtEnd()); ct=triIter.NextP() )
+  for( i=0; i<=2; i++ )
   {
-    for( i=0; i<=2; i++ )
+    // Valid point i?
+    if( (cn=ct->pPtr(i)) == NULL)
     {
-      // Valid point i?
-      if( (cn=ct->pPtr(i)) == NULL)
-      {
-        std::cerr << "TRIANGLE #" << ct->getID()
-        << " has an invalid point " << i << std::endl;
-        goto error;
-      }
-      // Valid edge i?
-      if( (ce=ct->ePtr(i)) == NULL)
-      {
-        std::cerr << "TRIANGLE #" << ct->getID()
-        << " has an invalid edge " << i << std::endl;
-        goto error;
-      }
-      // Edge and point consistency
-      if( ce->getOriginPtrNC()!=cn )
-      {
-        std::cerr << "TRIANGLE #" << ct->getID()
-        << ": edge " << i << " does not have point " << i
-        << " as origin\n";
-        goto error;
-      }
-      // changed from (i+1) to (i+2) for "right-hand" format gt 3/98
-      if( ce->getDestinationPtrNC()!=ct->pPtr((i+2)%3) )
-      {
-        std::cerr << "TRIANGLE #" << ct->getID()
-        << ": edge " << i << " does not have point " << (i+1)%3
-        << " as destination\n";
-        goto error;
-      }
-      // Opposite triangle: if it exists, check common points
-      if( (optr = ct->tPtr(i)) != 0 )
+      err << "TRIANGLE #" << ct->getID()
+      << " has an invalid point " << i << std::endl;
+      return false;
+    }
+    // Valid edge i?
+    if( (ce=ct->ePtr(i)) == NULL)
+    {
+      err << "TRIANGLE #" << ct->getID()
+      << " has an invalid edge " << i << std::endl;
+      return false;
+    }
+    // Edge and point consistency
+    if( ce->getOriginPtrNC()!=cn )
+    {
+      err << "TRIANGLE #" << ct->getID()
+      << ": edge " << i << " does not have point " << i
+      << " as origin\n";
+      return false;
+    }
+    // changed from (i+1) to (i+2) for "right-hand" format gt 3/98
+    if( ce->getDestinationPtrNC()!=ct->pPtr((i+2)%3) )
+    {
+      err << "TRIANGLE #" << ct->getID()
+      << ": edge " << i << " does not have point " << (i+1)%3
+      << " as destination\n";
+      return false;
+    }
+    // Opposite triangle: if it exists, check common points
+    if( (optr = ct->tPtr(i)) != 0 )
+    {
+      nvop = optr->nVOp(ct); // Num (0,1,2) of opposite vertex in optr
+      if( nvop < 3 )
       {
-        nvop = optr->nVOp(ct); // Num (0,1,2) of opposite vertex in optr
-        if( nvop < 3 )
-        {
-          if( ct->pPtr((i+1)%3) != optr->pPtr((nvop+2)%3)
-             || ct->pPtr((i+2)%3) != optr->pPtr((nvop+1)%3) )
-          {
-            std::cerr << "TRIANGLE #" << ct->getID()
-            << ": opposite triangle " << i << " does not share nodes "
-            << (ct->pPtr((i+1)%3))->getID() << " and "
-            << (ct->pPtr((i+2)%3))->getID() << std::endl;
-            goto error;
-          }
-        }
-        else
+        if( ct->pPtr((i+1)%3) != optr->pPtr((nvop+2)%3)
+           || ct->pPtr((i+2)%3) != optr->pPtr((nvop+1)%3) )
         {
-          std::cerr << "TRIANGLE #" << ct->getID()
-          << ": opposite triangle " << i << ", triangle #"
-          << optr->getID() << ", does not have current tri as neighbor\n";
-          goto error;
+          err << "TRIANGLE #" << ct->getID()
+          << ": opposite triangle " << i << " does not share nodes "
+          << (ct->pPtr((i+1)%3))->getID() << " and "
+          << (ct->pPtr((i+2)%3))->getID() << std::endl;
+          return false;
         }
       }
-      // If no opposite triangle, make sure it really is a boundary
       else
       {
-        if( (ct->pPtr((i+1)%3))->getBoundaryFlag()==kNonBoundary
-           || (ct->pPtr((i+2)%3))->getBoundaryFlag()==kNonBoundary )
-        {
-          std::cerr << "TRIANGLE #" << ct->getID()
-          << ": there is no neighboring triangle opposite node "
-          << cn->getID() << " but one (or both) of the other nodes "
-          << "is a non-boundary point, boundary conditions not OK \n"
-          << "The two nodes x, y and boundary flags are: \n"
-          << (ct->pPtr((i+1)%3))->getX() << ' ' << (ct->pPtr((i+1)%3))->getY() << ' '
-          << BoundName((ct->pPtr((i+1)%3))->getBoundaryFlag())
-          << " and \n" << (ct->pPtr((i+2)%3))->getX() <<' ' << (ct->pPtr((i+2)%3))->getY()<< ' '
-          << BoundName((ct->pPtr((i+2)%3))->getBoundaryFlag())<< std::endl;
-          goto error;
-        }
+        err << "TRIANGLE #" << ct->getID()
+        << ": opposite triangle " << i << ", triangle #"
+        << optr->getID() << ", does not have current tri as neighbor\n";
+        return false;
       }
-      // check flip test
-      if(0) std::cout << " About to do flip test ... ";
-      if( ct->tPtr(i) != 0 )
+    }
+    // If no opposite triangle, make sure it really is a boundary
+    else
+    {
+      if( (ct->pPtr((i+1)%3))->getBoundaryFlag()==kNonBoundary
+         || (ct->pPtr((i+2)%3))->getBoundaryFlag()==kNonBoundary )
       {
-        switch(CheckForFlip( ct, i, false, false )) {
-          case FLIP_NOT_NEEDED:
-            break;
-          case FLIP_DONE: // Cannot happen.
-            assert(0);
-            abort();
-            break;
-          case FLIP_NOT_ALLOWED:
-          case FLIP_NEEDED:
-            std::cerr << "TRIANGLE #" << ct->getID()
-            << ": flip test failed for edge opposite to vertex "
-            << cn->getID() << ".\n";
-            if(1) {
-              cn->TellAll();
-              ct->TellAll();
-            }
-            goto error;
-          case FLIP_ERROR:
-            std::cerr << "TRIANGLE #" << ct->getID()
-            << ": flip test return an error for edge opposite"
-            " to vertex "
-            << cn->getID() << ".\n";
-            goto error;
-        }
+        err << "TRIANGLE #" << ct->getID()
+        << ": there is no neighboring triangle opposite node "
+        << cn->getID() << " but one (or both) of the other nodes "
+        << "is a non-boundary point, boundary conditions not OK \n"
+        << "The two nodes x, y and boundary flags are: \n"
+        << (ct->pPtr((i+1)%3))->getX() << ' ' << (ct->pPtr((i+1)%3))->getY() << ' '
+        << BoundName((ct->pPtr((i+1)%3))->getBoundaryFlag())
+        << " and \n" << (ct->pPtr((i+2)%3))->getX() <<' ' << (ct->pPtr((i+2)%3))->getY()<< ' '
+        << BoundName((ct->pPtr((i+2)%3))->getBoundaryFlag())<< std::endl;
+        return false;
+      }
+    }
+    // check flip test
+    if(0) std::cout << " About to do flip test ... ";
+    if( ct->tPtr(i) != 0 )
+    {
+      switch(CheckForFlip( ct, i, false, false )) {
+        case FLIP_NOT_NEEDED:
+          break;
+        case FLIP_DONE: // Cannot happen.
+          assert(0);
+          abort();
+          break;
+        case FLIP_NOT_ALLOWED:
+        case FLIP_NEEDED:
+          err << "TRIANGLE #" << ct->getID()
+          << ": flip test failed for edge opposite to vertex "
+          << cn->getID() << ".\n";
+          if( report ) {
+            cn->TellAll();
+            ct->TellAll();
+          }
+          return false;
+        case FLIP_ERROR:
+          err << "TRIANGLE #" << ct->getID()
+          << ": flip test return an error for edge opposite"
+          " to vertex "
+          << cn->getID() << ".\n";
+          return false;
       }
     }
   }
-  if (verbose)
-    std::cout << "TRIANGLES PASSED\n";
-  if (verbose)
-    std::cout << "MESH PASSED\n";
-  return;
-
-error:
-  ReportFatalError( "Error in mesh consistency." );
-
+  return true;
 }
 #undef kMaxSpokes
 
+/*****************************************************************************\
+ **
+ **  tMesh::SampleCheckElements
+ **
+ **  Picks what is left of this step's CHECK_MESH_SAMPLE edges, nodes and
+ **  triangles at random (fewer if a list is shorter) for a sampled
+ **  CheckMeshConsistency. Each list
+ **  is walked once, taking the elements at sorted random positions;
+ **  edges are taken by pairs, through the even one.
+ **
+ **      Created: 10/2026
+ **
+ \*****************************************************************************/
+template<class tSubNode>
+void tMesh< tSubNode >::
+SampleCheckElements( std::vector< tEdge * > &edges,
+                     std::vector< tNode * > &nodes,
+                     std::vector< tTriangle * > &tris )
+{
+  std::vector< int > pos;
+  int n, i, k;
+
+  // positions of the sampled edge pairs
+  n = edgeList.getSize()/2;
+  for( k=0; k<miCheckSampleLeft && n>0; ++k )
+    pos.push_back( 2*std::min( static_cast<int>( mCheckRand.ran3()*n ),
+                               n-1 ) );
+  std::sort( pos.begin(), pos.end() );
+  pos.erase( std::unique( pos.begin(), pos.end() ), pos.end() );
+  {
+    edgeListIter_t edgIter( edgeList );
+    tEdge *ce = edgIter.FirstP();
+    for( i=0, k=0; k<static_cast<int>(pos.size()) && !(edgIter.AtEnd());
+         ce = edgIter.NextP(), ++i )
+      if( i == pos[k] ) { edges.push_back( ce ); ++k; }
+  }
+
+  pos.clear();
+  n = nodeList.getSize();
+  for( k=0; k<miCheckSampleLeft && n>0; ++k )
+    pos.push_back( std::min( static_cast<int>( mCheckRand.ran3()*n ),
+                             n-1 ) );
+  std::sort( pos.begin(), pos.end() );
+  pos.erase( std::unique( pos.begin(), pos.end() ), pos.end() );
+  {
+    nodeListIter_t nodIter( nodeList );
+    tSubNode *cn = nodIter.FirstP();
+    for( i=0, k=0; k<static_cast<int>(pos.size()) && !(nodIter.AtEnd());
+         cn = nodIter.NextP(), ++i )
+      if( i == pos[k] ) { nodes.push_back( cn ); ++k; }
+  }
+
+  pos.clear();
+  n = triList.getSize();
+  for( k=0; k<miCheckSampleLeft && n>0; ++k )
+    pos.push_back( std::min( static_cast<int>( mCheckRand.ran3()*n ),
+                             n-1 ) );
+  std::sort( pos.begin(), pos.end() );
+  pos.erase( std::unique( pos.begin(), pos.end() ), pos.end() );
+  {
+    triListIter_t triIter( triList );
+    tTriangle *ct = triIter.FirstP();
+    for( i=0, k=0; k<static_cast<int>(pos.size()) && !(triIter.AtEnd());
+         ct = triIter.NextP(), ++i )
+      if( i == pos[k] ) { tris.push_back( ct ); ++k; }
+  }
+}
+
 template< class tSubNode >
 void tMesh< tSubNode >::
 Print() const
@@ -3528,6 +3976,8 @@ DeleteNode( tSubNode const *node, kRepairMesh_t repairFlag,
  **  Modifications: added repairFlag 4/98 GT
  **  5/2003 SL, AD
  **  7/2003 SL: added updateFlag
+ **  10/2026: O(n) debug node counts switched off, since adaptive
+ **    coarsening deletes many nodes per storm
  **
  \**************************************************************************/
 template< class tSubNode >
@@ -3549,7 +3999,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
   }
 #endif
 
-  if (1) //DEBUG
+  if (0) //DEBUG
   {
     std::cout << "DeleteNode: " << node->getID() << " at " << node->getX() << " "
           << node->getY() << " " << node->getZ() << std::endl;
@@ -3569,8 +4019,11 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
 
   // extricate node from mesh and get list of its neighbors:
   if( !( ExtricateNode( node, nbrList ) ) ) return 0;
+  ForgetGeometryChange( node );
+  ++miNodesChangedSinceReorder;
+  ++mlNodeListVersion;
 
-  if (1) //DEBUG
+  if (0) //DEBUG
   {
     int nactive = 0, ntotalnodes = 0;
     nodeListIter_t nodIter( nodeList );
@@ -3596,7 +4049,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
     nodeList.removeFromFront( nodeVal );
   }
 
-  if(1)
+  if(0) //DEBUG
   {
     std::cout << "Removed node " << nodeVal.getID() << " at x, y "
       << nodeVal.getX() << ", " << nodeVal.getY() << "; " << std::endl;
@@ -3614,7 +4067,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
   nedges = edgeList.getSize();
   ntri = triList.getSize();
 
-  if (1) { //DEBUG
+  if (0) { //DEBUG
     std::cout << "nn " << nnodes << "  ne " << nedges << "  nt " << ntri << std::endl;
     tPtrListIter< tSubNode > nbrIter( nbrList );
     std::cout << "leaving hole defined by \n"
@@ -3647,7 +4100,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
   //reset node id's
   ResetNodeIDIfNecessary();
 
-  if (1) { //DEBUG
+  if (0) { //DEBUG
     std::cout << "Mesh repaired" << std::endl;
     nodeListIter_t nodIter( nodeList );
     tSubNode *cn;
@@ -3774,6 +4227,10 @@ DeleteEdge( tEdge * edgePtr )
   //edgePtr->TellCoords();
   tEdge edgeVal1, edgeVal2;
 
+  MarkGeometryChanged( static_cast<tSubNode *>(edgePtr->getOriginPtrNC()) );
+  MarkGeometryChanged(
+    static_cast<tSubNode *>(edgePtr->getDestinationPtrNC()) );
+
   // Detach the edge from other mesh elements
   if( !ExtricateEdge( edgePtr ) ) return 0;
 
@@ -3989,8 +4446,8 @@ ClearEdge( tEdge* ce ) const
  **  order, so that the point is contained within a given triangle (p0,p1,p2)
  **  if and only if the point lies to the left of vectors p0->p1, p1->p2,
  **  and p2->p0. Here's how it works:
- **   1 - start with a given triangle (currently first on the list, but a
- **       smarter initial guess could be used -- TODO)
+ **   1 - start with a given triangle (startTri if given, otherwise the
+ **       search origin or the first on the list)
  **   2 - lv is the number of successful left-hand checks found so far:
  **       initialize it to zero
  **   3 - check whether (x,y) lies to the left of p(lv)->p((lv+1)%3)
@@ -4004,6 +4461,8 @@ ClearEdge( tEdge* ce ) const
  **       the boundary, so we need to check
  **
  **  Input: x, y -- coordinates of the point
+ **         startTri -- triangle to start the walk from (optional; a
+ **                     triangle near the point makes the walk short)
  **  Modifies: (nothing)
  **  Returns: a pointer to the triangle that contains (x,y)
  **  Assumes: the point is contained within one of the current triangles
@@ -4011,12 +4470,13 @@ ClearEdge( tEdge* ce ) const
  \***************************************************************************/
 template< class tSubNode >
 tTriangle * tMesh< tSubNode >::
-LocateTriangle( double x, double y, bool useFuturePosn)
+LocateTriangle( double x, double y, bool useFuturePosn, tTriangle *startTri )
 {
   if (0) //DEBUG
     std::cout << "\nLocateTriangle (" << x << "," << y << ")\n";
   triListIter_t triIter( triList );  //lt
-  tTriangle *lt = ( mSearchOriginTriPtr != 0 ) ? mSearchOriginTriPtr
+  tTriangle *lt = ( startTri != 0 ) ? startTri :
+  ( mSearchOriginTriPtr != 0 ) ? mSearchOriginTriPtr
   : triIter.FirstP();
   int online = -1;
 
@@ -4501,6 +4961,9 @@ AddEdge( tSubNode *node1, tSubNode *node2, tSubNode const *node3 )
 
   tEdge *ce, *nle, *le;
 
+  MarkGeometryChanged( node1 );
+  MarkGeometryChanged( node2 );
+
   {
     tEdge
     tempEdge1(miNextEdgID++, node1, node2),
@@ -5200,6 +5663,8 @@ AddToList( tSubNode const & newNode )
   // boundary portion (if it is)
   if(0) //DEBUG
     std::cout<<"AddToList: nnodes="<<nnodes<<std::endl;
+  ++miNodesChangedSinceReorder;
+  ++mlNodeListVersion;
   nodeListIter_t nodIter( nodeList );
   tSubNode *cn = 0;
   switch (newNode.getBoundaryFlag()){
@@ -5237,6 +5702,7 @@ RemoveFromList( tSubNode * nPtr )
   // remove node from the back of either the
   // active portion of the node list (if it's not a boundary) or the
   // boundary portion (if it is)
+  ForgetGeometryChange( nPtr );
   nodeListIter_t nodIter( nodeList );
   tSubNode rmnode;
   switch (nPtr->getBoundaryFlag()){
@@ -5455,6 +5921,146 @@ AddNodeAt( tArray< double > &xyz, double time )
     std::cout << "AddNodeAt finished, " << nnodes << std::endl;
   return newNodePtr2;
 }
+
+/**************************************************************************\
+ **
+ **  tMesh::AddNodes
+ **
+ **  Adds copies of a batch of nodes to the mesh. Inserting the nodes one
+ **  at a time with AddNode costs a LocateTriangle walk from the search
+ **  origin for each node, and callers that update the mesh after every
+ **  node pay for that too. Here the batch is put in a biased randomized
+ **  insertion order (BRIO): each node is assigned to a round, half of
+ **  them to the last round, a quarter to the one before and so on, and
+ **  within a round the nodes are sorted along a Hilbert curve. Each
+ **  node is then located by walking from a triangle of the node inserted
+ **  just before it, which is usually a few steps away, and Delaunay-ness
+ **  is restored with local flips (CheckTrianglesAt) as in AddNode. The
+ **  Voronoi geometry is brought up to date once at the end; UpdateMesh
+ **  only recomputes it around the nodes that were touched.
+ **
+ **  Rounds come from a hash of each node's Hilbert index rather than
+ **  from the random number generator, so the order is reproducible and
+ **  the model's random streams are left alone. Nodes at identical (x,y)
+ **  sort next to each other and only the first is added (neighbouring
+ **  nodes share Voronoi vertices, see AddNodesAround). Nodes that fall
+ **  outside the mesh or on its boundary are skipped, as in AddNode.
+ **
+ **  Inputs: newNodes -- nodes to add (copied; layers are prepared for
+ **                      addition in place when time > 0)
+ **          updatemesh -- whether to call UpdateMesh at the end
+ **          time -- simulation time (for layer updating)
+ **          added -- if given, the new nodes are appended to it
+ **  Returns: the number of nodes added
+ **  Calls: LocateTriangle, AddToList, AttachNode, CheckTrianglesAt,
+ **         HilbertIndex
+ **
+ \**************************************************************************/
+template< class tSubNode >
+int tMesh< tSubNode >::
+AddNodes( tList< tSubNode > &newNodes, kUpdateMesh_t updatemesh, double time,
+          tPtrList< tSubNode > *added )
+{
+  const int kHilbertOrder = 16; // Hilbert grid is 2^16 cells on a side
+  const int kBRIOMinRound = 64; // don't split off rounds smaller than this
+  const int n = newNodes.getSize();
+  if( n == 0 ) return 0;
+
+  // Gather the batch and find its bounding box
+  tArray< tSubNode* > batch( n );
+  double xmin = 0., xmax = 0., ymin = 0., ymax = 0.;
+  {
+    tListIter< tSubNode > nodIter( newNodes );
+    tSubNode *nn;
+    int i;
+    for( nn = nodIter.FirstP(), i = 0; !(nodIter.AtEnd());
+         nn = nodIter.NextP(), ++i )
+    {
+      batch[i] = nn;
+      if( i == 0 || nn->getX() < xmin ) xmin = nn->getX();
+      if( i == 0 || nn->getX() > xmax ) xmax = nn->getX();
+      if( i == 0 || nn->getY() < ymin ) ymin = nn->getY();
+      if( i == 0 || nn->getY() > ymax ) ymax = nn->getY();
+    }
+  }
+  const double extent = ( xmax-xmin > ymax-ymin ) ? xmax-xmin : ymax-ymin;
+  const double scale = ( extent > 0.0 ) ?
+    ( ( 1u << kHilbertOrder ) - 1 ) / extent : 0.0;
+  int nrounds = 1;
+  for( int m = n; m >= 2*kBRIOMinRound; m /= 2 )
+    ++nrounds;
+
+  // Assign rounds and Hilbert indices, and sort
+  std::vector< tInsertionKey > order( n );
+  for( int i=0; i<n; ++i )
+  {
+    const double x = batch[i]->getX(), y = batch[i]->getY();
+    order[i].key =
+      HilbertIndex( static_cast<unsigned>( ( x - xmin ) * scale ),
+                    static_cast<unsigned>( ( y - ymin ) * scale ),
+                    kHilbertOrder );
+    // each trailing 1 bit of the hash is a coin flip won, which moves
+    // the node one round earlier
+    unsigned long h = ( order[i].key * 2654435761UL ) & 0xffffffffUL;
+    h ^= h >> 16;
+    h = ( h * 2246822519UL ) & 0xffffffffUL;
+    h ^= h >> 13;
+    int r = 0;
+    while( r < nrounds-1 && ( h & 1UL ) )
+    {
+      ++r;
+      h >>= 1;
+    }
+    order[i].round = nrounds - 1 - r;
+    order[i].x = x;
+    order[i].y = y;
+    order[i].index = i;
+  }
+  qsort( &order[0], order.size(), sizeof(order[0]), orderInsertion );
+
+  // Insert the nodes, each walk starting next to the previous node
+  int nadded = 0;
+  tTriangle *hint = 0;
+  for( int k=0; k<n; ++k )
+  {
+    if( k > 0 && order[k].x == order[k-1].x && order[k].y == order[k-1].y )
+      continue;
+    tSubNode *nn = batch[ order[k].index ];
+    tTriangle *tri = 0;
+    if( hint != 0 )
+      tri = LocateTriangle( order[k].x, order[k].y, false, hint );
+    // the walk can leave a non-convex mesh, so retry from the origin
+    if( tri == 0 )
+      tri = LocateTriangle( order[k].x, order[k].y );
+    if( tri == 0 )
+      continue;
+
+    if( layerflag && time > 0. )
+      nn->PrepForAddition( tri, time );
+    tSubNode *cn = AddToList( *nn );
+    if( AttachNode( cn, tri ) == 0 )
+    {
+      RemoveFromList( cn );
+      continue;
+    }
+    cn->setID( miNextNodeID );
+    miNextNodeID++;
+    cn->setPermID( node_ID_generator.getNextID() );
+    miNextPermNodeID++;
+    CheckTrianglesAt( cn, time );
+    cn->InitializeNode();
+    ++nadded;
+    if( added != 0 )
+      added->insertAtBack( cn );
+
+    // any triangle around the new node will do as the next start
+    hint = cn->getEdg()->TriWithEdgePtr();
+  }
+
+  ResetNodeIDIfNecessary();
+  if( updatemesh == kUpdateMesh ) UpdateMesh();
+  return nadded;
+}
 #undef kLargeNumber
 
 
@@ -5490,13 +6096,22 @@ getEdgeComplement( tEdge *edge ) const
  **   - computes Voronoi areas for interior (active) nodes
  **   - updates CCW-edge connectivity
  **
+ **  By default only the neighborhood of the nodes recorded by
+ **  MarkGeometryChanged since the last call is recomputed (see
+ **  UpdateMeshLocal). The whole mesh is recomputed when the mode read from
+ **  OPT_MESH_GEOMETRY_UPDATE is kGeomUpdateFull, when InvalidateGeometry
+ **  has been called (or the mesh was just built), or when the change set
+ **  is too large for a local update to pay off. In kGeomUpdateValidate
+ **  mode the local result is compared against a full recompute.
+ **
  **  Note that the call to CheckMeshConsistency is for debugging
  **  purposes and should be removed prior to release.
  **
- **  Calls: MakeCCWEdges(), setVoronoiVertices(), CalcVoronoiEdgeLengths(),
- **   CalcVAreas(), CheckMeshConsistency()
+ **  Calls: UpdateMeshFull(), UpdateMeshLocal(), ValidateMeshGeometry(),
+ **   CheckMeshConsistency()
  **  Assumes: nodes have been properly triangulated
  **  Created: SL fall, '97
+ **  Modified: local updates driven by the change set
  **
  \**************************************************************************/
 template <class tSubNode>
@@ -5506,6 +6121,44 @@ UpdateMesh( bool checkMeshConsistency )
   if (0) //DEBUG
     std::cout << "UpdateMesh()" << std::endl;
 
+  bool done = false;
+  PurgeForgottenNodes( mGeomChangedNodes, mGeomForgotten );
+  if( miGeomUpdateMode != kGeomUpdateFull && !mbGeomFullUpdate )
+  {
+    // past a quarter of the mesh a full sweep is cheaper (validation
+    // mode always exercises the local path)
+    if( miGeomUpdateMode == kGeomUpdateValidate
+        || 4*mGeomChangedNodes.getSize() < nodeList.getSize() )
+      done = UpdateMeshLocal();
+    if( done && miGeomUpdateMode == kGeomUpdateValidate )
+      ValidateMeshGeometry();
+  }
+  if( !done )
+    UpdateMeshFull();
+
+  mGeomChangedNodes.Flush();
+  mGeomForgotten.clear();
+  mbGeomFullUpdate = false;
+
+  if (checkMeshConsistency)
+    CheckMeshConsistency( false );  // debug only -- remove for release
+}
+
+
+/**************************************************************************\
+ **
+ **  tMesh::UpdateMeshFull
+ **
+ **  Recomputes edge lengths, Voronoi vertices, Voronoi edge lengths and
+ **  Voronoi areas over the whole mesh (the original UpdateMesh).
+ **
+ **  Calls: setVoronoiVertices(), CalcVoronoiEdgeLengths(), CalcVAreas()
+ **
+ \**************************************************************************/
+template <class tSubNode>
+void tMesh<tSubNode>::
+UpdateMeshFull()
+{
   edgeListIter_t elist( edgeList );
   double len;
   //DEBUG
@@ -5534,8 +6187,308 @@ UpdateMesh( bool checkMeshConsistency )
   setVoronoiVertices();
   CalcVoronoiEdgeLengths();
   CalcVAreas();
-  if (checkMeshConsistency)
-    CheckMeshConsistency( false );  // debug only -- remove for release
+}
+
+
+/**************************************************************************\
+ **
+ **  tMesh::UpdateMeshLocal
+ **
+ **  Recomputes the geometry that can have changed since the last update,
+ **  given the set C of nodes recorded by MarkGeometryChanged. Any triangle
+ **  created, destroyed or deformed since then has a vertex in C, so every
+ **  Voronoi vertex, Voronoi edge and Voronoi area that can differ belongs
+ **  to N1 = C plus its immediate neighbors:
+ **   1. lengths of the spokes of C;
+ **   2. Voronoi vertices (circumcenters) of the spokes of N1;
+ **   3. Voronoi edge lengths of the flow-allowed spokes of N1;
+ **   4. Voronoi areas of the interior nodes of N1.
+ **
+ **  The result is identical to UpdateMeshFull's, which requires some care
+ **  with the "loop" corrections made by tNode::ComputeVoronoiArea: these
+ **  overwrite rvtx and vedglen on the spokes of the node being processed.
+ **  Step 2 discards the corrections of N1 nodes (they are redone in step
+ **  4). In step 3 an edge pair whose nodes are both in N1 is recomputed
+ **  with CalcVEdgLen, from the first edge of the pair as in
+ **  CalcVoronoiEdgeLengths; when the far node lies outside N1 its geometry
+ **  is unchanged and only our side of the pair is reset, from the raw
+ **  circumcenters, so as to keep the far node's own corrections.
+ **
+ **  Returns: false if the update could not be done locally (node IDs
+ **           out of range), in which case nothing has been modified.
+ **  Called by: UpdateMesh
+ **
+ \**************************************************************************/
+template <class tSubNode>
+bool tMesh<tSubNode>::
+UpdateMeshLocal()
+{
+  const int nmark = ( miNextNodeID > nodeList.getSize() ) ?
+    miNextNodeID : nodeList.getSize();
+  if( nmark <= 0 ) return false;
+
+  tPtrListIter< tSubNode > cI( mGeomChangedNodes );
+  tSubNode *cn;
+  for( cn = cI.FirstP(); !cI.AtEnd(); cn = cI.NextP() )
+    if( cn->getID() < 0 || cn->getID() >= nmark ) return false;
+
+  // Build N1 (C first, then the neighbors), checking IDs as we go
+  tArray< char > inN1( nmark );
+  tPtrList< tSubNode > n1List;
+  for( cn = cI.FirstP(); !cI.AtEnd(); cn = cI.NextP() )
+    if( !inN1[cn->getID()] )
+    {
+      inN1[cn->getID()] = 1;
+      n1List.insertAtBack( cn );
+    }
+  for( cn = cI.FirstP(); !cI.AtEnd(); cn = cI.NextP() )
+  {
+    tEdge * const first = cn->getEdg();
+    if( first == 0 ) continue;
+    tEdge *ce = first;
+    do
+    {
+      tSubNode *nbr = static_cast<tSubNode *>(ce->getDestinationPtrNC());
+      if( nbr->getID() < 0 || nbr->getID() >= nmark ) return false;
+      if( !inN1[nbr->getID()] )
+      {
+        inN1[nbr->getID()] = 1;
+        n1List.insertAtBack( nbr );
+      }
+      ce = ce->getCCWEdg();
+    } while( ce != first );
+  }
+
+  // 1. Edge lengths (CalcLength also sets the complement)
+  for( cn = cI.FirstP(); !cI.AtEnd(); cn = cI.NextP() )
+  {
+    tEdge * const first = cn->getEdg();
+    if( first == 0 ) continue;
+    tEdge *ce = first;
+    do
+    {
+      const double len = ce->CalcLength();
+      if( len<=0.0 ) {
+        std::cout << "Edge " << ce->getID() << " length: " << len << std::endl;
+        ce->TellCoords();
+      }
+      assert( len>0.0 );
+      ce = ce->getCCWEdg();
+    } while( ce != first );
+  }
+
+  // 2. Voronoi vertices
+  tPtrListIter< tSubNode > nI( n1List );
+  for( cn = nI.FirstP(); !nI.AtEnd(); cn = nI.NextP() )
+  {
+    tEdge * const first = cn->getEdg();
+    if( first == 0 ) continue;
+    tEdge *ce = first;
+    do
+    {
+      if( ce->TriWithEdgePtr() != 0 )
+        ce->setRVtx( ce->TriWithEdgePtr()->FindCircumcenter() );
+      ce = ce->getCCWEdg();
+    } while( ce != first );
+  }
+
+  // 3. Voronoi edge lengths
+  for( cn = nI.FirstP(); !nI.AtEnd(); cn = nI.NextP() )
+  {
+    tEdge * const first = cn->getEdg();
+    if( first == 0 ) continue;
+    tEdge *ce = first;
+    do
+    {
+      if( ce->FlowAllowed() == tEdge::kFlowAllowed )
+      {
+        tEdge *pairFirst =
+          ( ce->getID()%2 == 0 ) ? ce : ce->getComplementEdge();
+        if( inN1[ce->getDestinationPtr()->getID()] )
+        {
+          // both ends in N1: do the pair once, from its first edge
+          if( ce == pairFirst )
+            ce->CalcVEdgLen();
+        }
+        else
+        {
+          tEdge *ccw = pairFirst->getCCWEdg();
+          const tArray2< double > xy =
+            ( pairFirst->TriWithEdgePtr() != 0 ) ?
+            pairFirst->TriWithEdgePtr()->FindCircumcenter() :
+            pairFirst->getRVtx();
+          const tArray2< double > xyccw =
+            ( ccw->TriWithEdgePtr() != 0 ) ?
+            ccw->TriWithEdgePtr()->FindCircumcenter() :
+            ccw->getRVtx();
+          const double dx = xy.at(0) - xyccw.at(0);
+          const double dy = xy.at(1) - xyccw.at(1);
+          ce->setVEdgLen( sqrt( dx*dx + dy*dy ) );
+        }
+      }
+      ce = ce->getCCWEdg();
+    } while( ce != first );
+  }
+
+  // 4. Voronoi areas
+  for( cn = nI.FirstP(); !nI.AtEnd(); cn = nI.NextP() )
+    if( cn->getBoundaryFlag() == kNonBoundary )
+      cn->ComputeVoronoiArea();
+
+  if (0) //DEBUG
+    std::cout << "UpdateMeshLocal: " << mGeomChangedNodes.getSize()
+              << " changed, " << n1List.getSize() << " updated nodes\n";
+  return true;
+}
+
+
+/**************************************************************************\
+ **
+ **  tMesh::ValidateMeshGeometry
+ **
+ **  Checks the result of a local update against a full recompute and
+ **  reports every node or edge that differs. Used when
+ **  OPT_MESH_GEOMETRY_UPDATE is 2; the mesh is left with the result of
+ **  the full recompute.
+ **
+ \**************************************************************************/
+template <class tSubNode>
+void tMesh<tSubNode>::
+ValidateMeshGeometry()
+{
+  const int nn = nodeList.getSize();
+  const int ne = edgeList.getSize();
+  tArray< double > varea( nn ), len( ne ), vlen( ne ), rx( ne ), ry( ne );
+
+  nodeListIter_t nI( nodeList );
+  edgeListIter_t eI( edgeList );
+  tSubNode *cn;
+  tEdge *ce;
+  int i;
+  for( cn = nI.FirstP(), i = 0; !nI.AtEnd(); cn = nI.NextP(), ++i )
+    varea[i] = cn->getVArea();
+  for( ce = eI.FirstP(), i = 0; !eI.AtEnd(); ce = eI.NextP(), ++i )
+  {
+    len[i] = ce->getLength();
+    vlen[i] = ce->getVEdgLen();
+    rx[i] = ce->getRVtx().at(0);
+    ry[i] = ce->getRVtx().at(1);
+  }
+
+  UpdateMeshFull();
+
+  int nbad = 0;
+  for( cn = nI.FirstP(), i = 0; nI.IsActive(); cn = nI.NextP(), ++i )
+    if( varea[i] != cn->getVArea() )
+    {
+      ++nbad;
+      std::cout << "ValidateMeshGeometry: node " << cn->getID()
+                << " varea local " << varea[i]
+                << " full " << cn->getVArea() << std::endl;
+    }
+  for( ce = eI.FirstP(), i = 0; !eI.AtEnd(); ce = eI.NextP(), ++i )
+  {
+    bool bad = ( len[i] != ce->getLength() );
+    if( eI.IsActive() && vlen[i] != ce->getVEdgLen() ) bad = true;
+    if( ce->TriWithEdgePtr() != 0 &&
+        ( rx[i] != ce->getRVtx().at(0) || ry[i] != ce->getRVtx().at(1) ) )
+      bad = true;
+    if( bad )
+    {
+      ++nbad;
+      std::cout << "ValidateMeshGeometry: edge " << ce->getID()
+                << " (" << ce->getOriginPtr()->getID() << ","
+                << ce->getDestinationPtr()->getID() << ") len "
+                << len[i] << "/" << ce->getLength() << " vedglen "
+                << vlen[i] << "/" << ce->getVEdgLen() << std::endl;
+    }
+  }
+  if( nbad > 0 )
+    ReportWarning( "local mesh geometry update differs from full update" );
+}
+
+
+/**************************************************************************\
+ **
+ **  tMesh::MarkGeometryChanged / InvalidateGeometry
+ **
+ **  MarkGeometryChanged records a node that has moved or gained or lost a
+ **  spoke, so that the next UpdateMesh recomputes the geometry around it.
+ **  It is called by the mesh editing routines (AddEdge, DeleteEdge,
+ **  FlipEdge, ConvertToOpenBoundary, node movement); code that moves
+ **  nodes or changes boundary codes directly must either mark the nodes
+ **  or call InvalidateGeometry, which makes the next update a full one.
+ **  ForgetGeometryChange drops a node that is about to be deleted: it is
+ **  only noted in a set, and the lists are purged of the noted nodes
+ **  when they are next used, so that deleting many nodes is not
+ **  quadratic in their number. A node marked again after it was noted
+ **  (a new node at the same address) is taken off the set.
+ **
+ **  The same records drive the incremental CheckMeshConsistency, which
+ **  keeps its own list as the checks do not follow every UpdateMesh.
+ **
+ \**************************************************************************/
+template <class tSubNode>
+void tMesh<tSubNode>::
+MarkGeometryChanged( tSubNode *node )
+{
+  if( runCheckMeshConsistency && miCheckMeshMode == kCheckMeshIncremental
+      && !mbCheckMeshFull )
+  {
+    if( !mCheckForgotten.empty() ) mCheckForgotten.erase( node );
+    mCheckChangedNodes.insertAtBack( node );
+    if( mCheckChangedNodes.getSize() > nodeList.getSize() )
+    {
+      mbCheckMeshFull = true;
+      mCheckChangedNodes.Flush();
+      mCheckForgotten.clear();
+    }
+  }
+  if( mbGeomFullUpdate ) return;
+  if( !mGeomForgotten.empty() ) mGeomForgotten.erase( node );
+  mGeomChangedNodes.insertAtBack( node );
+  // no point in tracking more changes than there are nodes
+  if( mGeomChangedNodes.getSize() > nodeList.getSize() )
+    InvalidateGeometry();
+}
+
+template <class tSubNode>
+void tMesh<tSubNode>::
+InvalidateGeometry()
+{
+  mbGeomFullUpdate = true;
+  mGeomChangedNodes.Flush();
+  mGeomForgotten.clear();
+  mbCheckMeshFull = true;
+  mCheckChangedNodes.Flush();
+  mCheckForgotten.clear();
+}
+
+template <class tSubNode>
+void tMesh<tSubNode>::
+ForgetGeometryChange( tSubNode const *node )
+{
+  if( mGeomChangedNodes.getSize() > 0 )
+    mGeomForgotten.insert( node );
+  if( mCheckChangedNodes.getSize() > 0 )
+    mCheckForgotten.insert( node );
+}
+
+// Drops the forgotten nodes from a list of changed nodes, in one pass
+template <class tSubNode>
+void tMesh<tSubNode>::
+PurgeForgottenNodes( tPtrList< tSubNode > &changed,
+                     std::set< tSubNode const * > &forgotten )
+{
+  if( forgotten.empty() ) return;
+  const int n = changed.getSize();
+  for( int i=0; i<n; ++i )
+  {
+    tSubNode *cn = changed.removeFromFront();
+    if( forgotten.find( cn ) == forgotten.end() )
+      changed.insertAtBack( cn );
+  }
+  forgotten.clear();
 }
 
 
@@ -5598,7 +6551,7 @@ CheckForFlip( tTriangle * tri, int nv, bool flip, bool useFuturePosn )
   // coordinates rather than current coordinates
   if( !flip && useFuturePosn)
   {
-    if(1) std::cout << "  Doing flip test based on future position\n";
+    if(0) std::cout << "  Doing flip test based on future position\n";
     // use virtual function that will return new coords for nodes
     p0 = node0->FuturePosn();
     p1 = node1->FuturePosn();
@@ -5609,12 +6562,12 @@ CheckForFlip( tTriangle * tri, int nv, bool flip, bool useFuturePosn )
   // If p0-p1-p2 passes the test, no flip is necessary
   if( TriPasses( ptest, p0, p1, p2 ) ) return FLIP_NOT_NEEDED;
 
-  if(1) std::cout << "CheckForFlip: case flip needed\n";
+  if(0) std::cout << "CheckForFlip: case flip needed\n";
 
   // Now a flip is necessary
   if ( !tri->ePtr( (nv+2)%3)->isFlippable() )
   {
-    if(1) std::cout << "In CheckForFlip, case FLIP_NOT_ALLOWED\n";
+    if(0) std::cout << "In CheckForFlip, case FLIP_NOT_ALLOWED\n";
     return FLIP_NOT_ALLOWED;
   }
 
@@ -5625,7 +6578,7 @@ CheckForFlip( tTriangle * tri, int nv, bool flip, bool useFuturePosn )
   {
     if( !PointsCCW( p0, p1, ptest ) || !PointsCCW( p0, ptest, p2 ) )
       return FLIP_ERROR;
-    if(1) std::cout << "calling Flip edge from cff" << std::endl;
+    if(0) std::cout << "calling Flip edge from cff" << std::endl;
     FlipEdge( tri, triop, nv, nvop );
     return FLIP_DONE;
   }
@@ -5691,7 +6644,7 @@ bool tMesh< tSubNode >::
 FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
          bool useFuturePosn )
 {
-  if (1) //DEBUG
+  if (0) //DEBUG
   {
     std::cout << "FlipEdge(...)..." << std::endl;
     std::cout << " with tri = #" << tri->getID() << " p0=" << tri->pPtr(0)->getID()  << " p1=" << tri->pPtr(1)->getID() << " p2=" << tri->pPtr(2)->getID() << std::endl;
@@ -5713,7 +6666,7 @@ FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
        tEdge::isFlowAllowed(na, nc) != tEdge::isFlowAllowed(nb, nd)
        );
 
-  if (1) {
+  if (0) {
     std::cout << " move=" << move << std::endl;
     std::cout << " na: " << na->getX() << " " << na->getY() << " " << na->getID() << " " << na->getBoundaryFlag() << std::endl;
     std::cout << " nb: " << nb->getX() << " " << nb->getY() << " " << nb->getID() << " " << nb->getBoundaryFlag() << std::endl;
@@ -5735,6 +6688,11 @@ FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
     assert( enodePtr1 != 0 && enodePtr2 != 0 );
   }
 
+  MarkGeometryChanged( na );
+  MarkGeometryChanged( nb );
+  MarkGeometryChanged( nc );
+  MarkGeometryChanged( nd );
+
   // does edg and edgop, tri and triop:
   ClearEdge( edg );
   // give edges' initialization routine nodes of tri in cw order:
@@ -5745,7 +6703,7 @@ FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
   {
     if( edg->FlowAllowed() )
     {
-      if (1) std::cout << " case flow allowed\n";
+      if (0) std::cout << " case flow allowed\n";
       edgeList.moveToActiveBack( enodePtr1 );
       edgeList.setNActiveNodes(edgeList.getActiveSize()+1);
       edgeList.moveToActiveBack( enodePtr2 );
@@ -5753,7 +6711,7 @@ FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
     }
     else
     {
-      if (1) std::cout << " case flow not allowed\n";
+      if (0) std::cout << " case flow not allowed\n";
       edgeList.moveToBack( enodePtr1 );
       edgeList.setNActiveNodes(edgeList.getActiveSize()-1);
       edgeList.moveToBack( enodePtr2 );
@@ -5876,6 +6834,9 @@ CheckLocallyDelaunay( double time )
  **     nodes that are the same node: add a check for this in FlipEdge so that
  **     it will report that an edge already exists and, I hope, the node in
  **     question will be deleted. -SL 9/2003
+ **   - NewTriCCW test of the triangles with moving vertices done in one
+ **     call to Predicates::orient2dBatch, and only those that fail it are
+ **     put on the list (10/2026)
  **
  \*****************************************************************************/
 template< class tSubNode >
@@ -5907,6 +6868,11 @@ CheckTriEdgeIntersect()
     flipped = false;
 
     // Make a list of triangles containing at least one moving vertex
+    // whose new vertex positions are not CCW. The NewTriCCW test is done
+    // for all of them in one batch; triangles that pass it would only be
+    // popped off the list below without any action.
+    std::vector< tTriangle * > movingTris;
+    std::vector< double > xy0, xy1, xy2;
     for( ct = triIter.FirstP(); !( triIter.AtEnd() ); ct = triIter.NextP() )
     {
       for( i=0; i<3; i++ )
@@ -5915,7 +6881,27 @@ CheckTriEdgeIntersect()
         //if( cn->isMobile() ) std::cout << "Triangle " << ct->getID() << " includes a moving node\n";
         if( cn->isMobile() ) break;
       }
-      if( i!=3 ) triptrList.insertAtBack( ct );
+      if( i!=3 )
+      {
+        movingTris.push_back( ct );
+        std::vector< double > * const xyv[3] = { &xy0, &xy1, &xy2 };
+        for( i=0; i<3; i++ )
+        {
+          cn = static_cast<tSubNode *>(ct->pPtr(i));
+          tArray< double > const xy =
+            cn->isMobile() ? cn->getNew2DCoords() : cn->get2DCoords();
+          xyv[i]->push_back( xy[0] );
+          xyv[i]->push_back( xy[1] );
+        }
+      }
+    }
+    if( !movingTris.empty() )
+    {
+      std::vector< double > det( movingTris.size() );
+      predicate.orient2dBatch( static_cast<int>( movingTris.size() ),
+                               &xy0[0], &xy1[0], &xy2[0], &det[0] );
+      for( size_t k=0; k<movingTris.size(); ++k )
+        if( !( det[k] > 0. ) ) triptrList.insertAtBack( movingTris[k] );
     }
     //for( ct = triIter.FirstP(); !( triIter.AtEnd() ); ct = triIter.NextP() )
     for( ct = tpIter.FirstP(); !(triptrList.isEmpty());
@@ -6066,7 +7052,12 @@ CheckTriEdgeIntersect()
 
   // Update coordinates of moving nodes. (UpdateCoords is virtual)
   for( cn = nodIter.FirstP(); !(nodIter.AtEnd()); cn = nodIter.NextP() )
+  {
+    const double oldx = cn->getX(), oldy = cn->getY();
     cn->UpdateCoords();//Nic, here is where x&y change
+    if( cn->getX() != oldx || cn->getY() != oldy )
+      MarkGeometryChanged( cn );
+  }
                        // re-add nodes that were deleted; add at new coords if within bounds,
                        // otherwise revert to old coords before adding:
   for( cn = tmpIter.FirstP(); !(tmpIter.AtEnd()); cn = tmpIter.NextP() )
@@ -6101,6 +7092,558 @@ CheckTriEdgeIntersect()
 }//end CheckTriEdgeIntersect()
 
 
+/*****************************************************************************\
+ **
+ **  tMesh::KineticMoveNodes
+ **
+ **  Kinetic update of the triangulation for moving nodes (option
+ **  OPT_KINETIC_MOVE), called by MoveNodes before CheckTriEdgeIntersect.
+ **
+ **  Each moving node is taken along a straight line from its current to
+ **  its future position, all of them together, as time t runs from 0 to
+ **  1. Two kinds of event are kept on a priority queue:
+ **   - flip: the first time an edge with a moving node among the four
+ **     vertices of its two triangles stops being Delaunay (the incircle
+ **     test turns positive). The edge is flipped with the node positions
+ **     at that time, when the quadrilateral is still convex, and the
+ **     edges and triangles around it get new events.
+ **   - collapse: the first time a triangle with a moving vertex becomes
+ **     degenerate. In a Delaunay mesh this only happens against the
+ **     boundary or an edge that may not be flipped (or after a missed
+ **     flip event), so the moving vertices of the triangle are stopped
+ **     where they are just before, and the events around them redone.
+ **  Events are processed in time order. Each triangle carries a version
+ **  stamp, so events queued before it changed are recognized and dropped.
+ **  Only triangles around the moving nodes are touched. If the cap on
+ **  the number of events is reached, the nodes still moving are stopped
+ **  where they are.
+ **
+ **  The mesh stays valid all the way to t=1, which is checked on the
+ **  triangles whose vertices, or the vertices across their edges, moved
+ **  relative to each other; elsewhere the motion is a translation, which
+ **  changes neither orientation nor Delaunay tests. Those triangles are
+ **  returned in checkTris for a last Delaunay check (some flip events may
+ **  have been missed or not done), in place of CheckTriEdgeIntersect and
+ **  CheckLocallyDelaunay sweeping all triangles with a moving vertex.
+ **  If it is valid, the nodes are moved: to their new coordinates, or,
+ **  for those stopped short, only that far. The latter keep their new
+ **  coordinates, and stoppedShort is set so that MoveNodes takes them
+ **  the rest of the way with CheckTriEdgeIntersect.
+ **
+ **      Inputs: checkTris -- (empty) list for the triangles to check
+ **      Outputs: stoppedShort -- whether any node was stopped short
+ **      Returns: true if the mesh is valid at the coordinates reached
+ **               (the nodes have then been moved), false if MoveNodes
+ **               should fall back on CheckTriEdgeIntersect
+ **      Data members updated: Mesh elements (by FlipEdge), coords of
+ **                            moving nodes
+ **      Called by: MoveNodes
+ **      Calls: ScheduleKineticFlip, ScheduleKineticCollapse, FlipEdge
+ **      Created: 10/2026
+ **
+ \*****************************************************************************/
+template< class tSubNode >
+bool tMesh< tSubNode >::
+KineticMoveNodes( tPtrList< tTriangle > &checkTris, bool &stoppedShort )
+{
+  nodeListIter_t nodIter( nodeList );
+  triListIter_t triIter( triList );
+  tSubNode *cn;
+  tTriangle *ct;
+  int i, maxNodeID = -1, maxTriID = -1;
+
+  stoppedShort = false;
+  for( cn = nodIter.FirstP(); !( nodIter.AtEnd() ); cn = nodIter.NextP() )
+    if( cn->getID() > maxNodeID ) maxNodeID = cn->getID();
+  for( ct = triIter.FirstP(); !( triIter.AtEnd() ); ct = triIter.NextP() )
+    if( ct->getID() > maxTriID ) maxTriID = ct->getID();
+
+  // Motion of each node, by ID: position at t = (x,y) + t * (dx,dy)
+  std::vector< double > motion( 4*(maxNodeID+1), 0. );
+  std::vector< tSubNode * > movers;
+  for( cn = nodIter.FirstP(); !( nodIter.AtEnd() ); cn = nodIter.NextP() )
+  {
+    double * const m = &motion[4*cn->getID()];
+    m[0] = cn->getX();
+    m[1] = cn->getY();
+    if( cn->isMobile() )
+    {
+      const tArray< double > xy = cn->FuturePosn();
+      m[2] = xy[0] - m[0];
+      m[3] = xy[1] - m[1];
+      if( m[2] != 0. || m[3] != 0. ) movers.push_back( cn );
+    }
+  }
+  if( movers.empty() ) return true;
+  std::vector< double > const motion0( motion );
+  std::vector< char > stopped( maxNodeID+1, 0 );
+
+  // Triangles around the moving nodes
+  std::vector< unsigned > stamp( maxTriID+1, 0 );
+  std::vector< char > around( maxTriID+1, 0 );
+  std::vector< tTriangle * > tris;
+  for( size_t k=0; k<movers.size(); ++k )
+  {
+    tSpkIter spokIter( movers[k] );
+    for( tEdge *ce = spokIter.FirstP(); !( spokIter.AtEnd() );
+         ce = spokIter.NextP() )
+    {
+      ct = ce->TriWithEdgePtr();
+      if( ct != 0 && !around[ct->getID()] )
+      {
+        around[ct->getID()] = 1;
+        tris.push_back( ct );
+      }
+    }
+  }
+
+  // Queue their first events, once per edge
+  kineticQueue_t events( kineticEventLater );
+  for( size_t k=0; k<tris.size(); ++k )
+  {
+    ct = tris[k];
+    ScheduleKineticCollapse( ct, 0., motion, stamp, events );
+    for( i=0; i<3; i++ )
+    {
+      tTriangle const * const nbr = ct->tPtr(i);
+      if( nbr != 0 && around[nbr->getID()] && nbr->getID() < ct->getID() )
+        continue;
+      ScheduleKineticFlip( ct, i, 0., motion, stamp, events );
+    }
+  }
+
+  // Process the events in time order. The cap only guards against
+  // cycling on degenerate input; if it is reached, the nodes are stopped
+  // where they are.
+  const size_t maxEvents = 100*movers.size() + 1000;
+  size_t nevents = 0, nflips = 0, nstops = 0;
+  double tnow = 0.;  // time of the last event processed
+  while( !events.empty() && nevents < maxEvents )
+  {
+    const tKineticEvent ev = events.top();
+    events.pop();
+    ct = ev.tri;
+    tTriangle * const triop = ev.triop;
+    if( stamp[ct->getID()] != ev.stamp ) continue;  // stale
+    if( ev.type == kKineticFlip &&
+        ( ct->tPtr( ev.nv ) != triop || stamp[triop->getID()] != ev.stampop ) )
+      continue;
+    ++nevents;
+
+    if( ev.type == kKineticCollapse )
+    {
+      // Stop the triangle's moving vertices just before it collapses and
+      // redo the events of all triangles around them
+      const double tstop = ( ev.tsafe > tnow ) ? ev.tsafe : tnow;
+      tris.clear();
+      for( i=0; i<3; i++ )
+      {
+        cn = static_cast< tSubNode * >( ev.tri->pPtr(i) );
+        double * const m = &motion[4*cn->getID()];
+        if( m[2] == 0. && m[3] == 0. ) continue;
+        m[0] += tstop * m[2];
+        m[1] += tstop * m[3];
+        m[2] = m[3] = 0.;
+        stopped[cn->getID()] = 1;
+        ++nstops;
+        tSpkIter spokIter( cn );
+        for( tEdge *ce = spokIter.FirstP(); !( spokIter.AtEnd() );
+             ce = spokIter.NextP() )
+          if( ( ct = ce->TriWithEdgePtr() ) != 0 )
+          {
+            ++stamp[ct->getID()];
+            tris.push_back( ct );
+          }
+      }
+      for( size_t k=0; k<tris.size(); ++k )
+      {
+        ScheduleKineticCollapse( tris[k], tstop, motion, stamp, events );
+        for( i=0; i<3; i++ )
+          ScheduleKineticFlip( tris[k], i, tstop, motion, stamp, events );
+      }
+      tnow = tstop;
+      continue;
+    }
+
+    // Flip only if the edge is really non-Delaunay at this time and the
+    // two new triangles would be CCW (as CheckForFlip does)
+    const int nvop = triop->nVOp( ct );
+    int id[4];
+    double p[4][2];
+    for( i=0; i<3; i++ ) id[i] = ct->pPtr( (ev.nv+i)%3 )->getID();
+    id[3] = triop->pPtr( nvop )->getID();
+    for( i=0; i<4; i++ )
+    {
+      double const * const m = &motion[4*id[i]];
+      p[i][0] = m[0] + ev.t * m[2];
+      p[i][1] = m[1] + ev.t * m[3];
+    }
+    tnow = ev.t;
+    if( predicate.incircle( p[0], p[1], p[2], p[3] ) <= 0. ) continue;
+    if( predicate.orient2d( p[0], p[1], p[3] ) <= 0. ||
+        predicate.orient2d( p[0], p[3], p[2] ) <= 0. ) continue;
+    if( !FlipEdge( ct, triop, ev.nv, nvop ) ) continue;
+    ++nflips;
+    ++stamp[ct->getID()];
+    ++stamp[triop->getID()];
+
+    // The two new triangles, the flipped edge and the four around them
+    ScheduleKineticCollapse( ct, tnow, motion, stamp, events );
+    ScheduleKineticCollapse( triop, tnow, motion, stamp, events );
+    for( i=0; i<3; i++ )
+      ScheduleKineticFlip( ct, i, tnow, motion, stamp, events );
+    for( i=0; i<3; i++ )
+      if( triop->tPtr(i) != ct )
+        ScheduleKineticFlip( triop, i, tnow, motion, stamp, events );
+  }
+  if( !events.empty() )
+    for( size_t k=0; k<movers.size(); ++k )
+    {
+      double * const m = &motion[4*movers[k]->getID()];
+      if( m[2] == 0. && m[3] == 0. ) continue;
+      m[0] += tnow * m[2];
+      m[1] += tnow * m[3];
+      stopped[movers[k]->getID()] = 1;
+      ++nstops;
+    }
+
+  // Triangles with relative motion around them, and a check that they
+  // are CCW at the new coordinates
+  std::vector< char > const &moved = stopped;
+  std::vector< char > checked( maxTriID+1, 0 );
+  std::vector< double > xy0, xy1, xy2;
+  tris.clear();
+  for( size_t k=0; k<movers.size(); ++k )
+  {
+    tSpkIter spokIter( movers[k] );
+    for( tEdge *ce = spokIter.FirstP(); !( spokIter.AtEnd() );
+         ce = spokIter.NextP() )
+    {
+      ct = ce->TriWithEdgePtr();
+      if( ct == 0 || checked[ct->getID()] ) continue;
+      checked[ct->getID()] = 1;
+      double const * const d = &motion0[4*ct->pPtr(0)->getID()+2];
+      bool relative = false;
+      for( i=0; i<3 && !relative; i++ )
+      {
+        const int id = ct->pPtr(i)->getID();
+        tTriangle const * const nbr = ct->tPtr(i);
+        const int idop = nbr ? nbr->pPtr( nbr->nVOp( ct ) )->getID() : id;
+        relative = moved[id] || moved[idop] ||
+          motion0[4*id+2] != d[0] || motion0[4*id+3] != d[1] ||
+          motion0[4*idop+2] != d[0] || motion0[4*idop+3] != d[1];
+      }
+      if( !relative ) continue;
+      tris.push_back( ct );
+      std::vector< double > * const xyv[3] = { &xy0, &xy1, &xy2 };
+      for( i=0; i<3; i++ )
+      {
+        cn = static_cast< tSubNode * >( ct->pPtr(i) );
+        if( stopped[cn->getID()] )
+        {
+          double const * const m = &motion[4*cn->getID()];
+          xyv[i]->push_back( m[0] );
+          xyv[i]->push_back( m[1] );
+        }
+        else
+        {
+          const tArray< double > xy = cn->FuturePosn();
+          xyv[i]->push_back( xy[0] );
+          xyv[i]->push_back( xy[1] );
+        }
+      }
+    }
+  }
+  bool valid = true;
+  if( !tris.empty() )
+  {
+    std::vector< double > det( tris.size() );
+    predicate.orient2dBatch( static_cast<int>( tris.size() ),
+                             &xy0[0], &xy1[0], &xy2[0], &det[0] );
+    for( size_t k=0; k<tris.size(); ++k )
+    {
+      if( !( det[k] > 0. ) ) valid = false;
+      checkTris.insertAtBack( tris[k] );
+    }
+  }
+
+  // Move the nodes: to their new coordinates, or, for those stopped
+  // short, that far, keeping their new coordinates for MoveNodes to take
+  // them the rest of the way
+  if( valid )
+    for( size_t k=0; k<movers.size(); ++k )
+    {
+      cn = movers[k];
+      if( stopped[cn->getID()] )
+      {
+        double const * const m = &motion[4*cn->getID()];
+        cn->set2DCoords( m[0], m[1] );
+        stoppedShort = true;
+      }
+      else
+        cn->UpdateCoords();
+      MarkGeometryChanged( cn );
+    }
+
+  if(0) //DEBUG
+    std::cout << "KineticMoveNodes: " << movers.size() << " moving nodes, "
+              << nevents << " events, " << nflips << " flips, "
+              << nstops << " nodes stopped, " << events.size()
+              << " events left, " << tris.size() << " triangles to check"
+              << ( valid ? "" : ", NOT VALID" ) << std::endl;
+  return valid;
+}
+
+/*****************************************************************************\
+ **
+ **  tMesh::ScheduleKineticFlip, ScheduleKineticCollapse and helpers
+ **
+ **  ScheduleKineticFlip queues the next time after t at which the edge of
+ **  tri opposite vertex nv stops being Delaunay, if that happens by t=1.
+ **  Edges on the boundary or that may not be flipped are skipped.
+ **  ScheduleKineticCollapse queues the next time tri becomes degenerate.
+ **
+ **  KineticInCircle is the incircle test of tri's vertices nv, nv+1,
+ **  nv+2 (id[0..2], CCW) against the opposite vertex id[3], and
+ **  KineticOrient the orientation of a triangle, with each node at its
+ **  position at time t. The incircle test is a polynomial of degree up
+ **  to four in t; KineticFlipTime finds its roots between t and 1
+ **  (PolynomialRoots), looks at the exact test once between each two of
+ **  them to find the first stretch where it is positive, and narrows the
+ **  start of that stretch by bisection; the time returned is the end of
+ **  the bracket where the test is positive (2 if none). The orientation is a quadratic, whose roots KineticCollapseTime
+ **  uses to bracket the collapse; tsafe is the start of the bracket,
+ **  where the triangle is still CCW.
+ **
+ \*****************************************************************************/
+template< class tSubNode >
+bool tMesh< tSubNode >::
+kineticEventLater( tKineticEvent const &a, tKineticEvent const &b )
+{
+  return a.t > b.t;
+}
+
+template< class tSubNode >
+double tMesh< tSubNode >::
+KineticInCircle( int const id[4], double t,
+                 std::vector< double > const &motion )
+{
+  double p[4][2];
+  for( int i=0; i<4; i++ )
+  {
+    double const * const m = &motion[4*id[i]];
+    p[i][0] = m[0] + t * m[2];
+    p[i][1] = m[1] + t * m[3];
+  }
+  return predicate.incircle( p[0], p[1], p[2], p[3] );
+}
+
+template< class tSubNode >
+double tMesh< tSubNode >::
+KineticFlipTime( int const id[4], double t,
+                 std::vector< double > const &motion )
+{
+  const int kBisections = 40; // narrowing of the bracket found
+  int i, j, k;
+  bool moving = false;  // relative to each other
+  double const * const m0 = &motion[4*id[0]];
+  for( i=1; i<4; i++ )
+    if( motion[4*id[i]+2] != m0[2] || motion[4*id[i]+3] != m0[3] )
+      moving = true;
+  if( !moving ) return 2.;  // the test stays what it is now
+
+  // The test as a polynomial in t: the determinant of the rows
+  // (x, y, x^2+y^2) of the first three points relative to the fourth,
+  // each entry a polynomial (coefficients by power of t)
+  double row[3][3][5];
+  double const * const m3 = &motion[4*id[3]];
+  for( i=0; i<3; i++ )
+  {
+    double const * const m = &motion[4*id[i]];
+    const double x0 = m[0]-m3[0], dx = m[2]-m3[2];
+    const double y0 = m[1]-m3[1], dy = m[3]-m3[3];
+    for( k=0; k<5; k++ ) row[i][0][k] = row[i][1][k] = row[i][2][k] = 0.;
+    row[i][0][0] = x0;  row[i][0][1] = dx;
+    row[i][1][0] = y0;  row[i][1][1] = dy;
+    row[i][2][0] = x0*x0 + y0*y0;
+    row[i][2][1] = 2.*( x0*dx + y0*dy );
+    row[i][2][2] = dx*dx + dy*dy;
+  }
+  static const int perm[6][3] =
+    { {0,1,2}, {1,2,0}, {2,0,1}, {0,2,1}, {1,0,2}, {2,1,0} };
+  double poly[5] = { 0., 0., 0., 0., 0. };
+  for( int s=0; s<6; s++ )
+  {
+    double const * const a = row[0][perm[s][0]];
+    double const * const b = row[1][perm[s][1]];
+    double const * const c = row[2][perm[s][2]];
+    const double sign = ( s<3 ) ? 1. : -1.;
+    for( i=0; i<3; i++ )
+      for( j=0; i+j<5 && j<3; j++ )
+        for( k=0; i+j+k<5 && k<3; k++ )
+          poly[i+j+k] += sign * a[i]*b[j]*c[k];
+  }
+
+  // Between its roots the test keeps its sign, so it is looked at
+  // (exactly) once inside each piece, and at t=1 for the last one; the
+  // first piece where it is positive brackets the event
+  double roots[4];
+  const int nroots = PolynomialRoots( poly, 4, t, 1., roots );
+  double tlo = t;
+  for( k=0; k<=nroots; k++ )
+  {
+    double thi = ( k==nroots ) ? 1. :
+      0.5*( ( k==0 ? t : roots[k-1] ) + roots[k] );
+    if( thi <= tlo ) continue;
+    if( KineticInCircle( id, thi, motion ) > 0. )
+    {
+      for( j=0; j<kBisections; j++ )
+      {
+        const double tmid = 0.5*(tlo+thi);
+        if( tmid <= tlo || tmid >= thi ) break;
+        if( KineticInCircle( id, tmid, motion ) > 0. ) thi = tmid;
+        else tlo = tmid;
+      }
+      return thi;
+    }
+    tlo = thi;
+  }
+  return 2.;
+}
+
+template< class tSubNode >
+double tMesh< tSubNode >::
+KineticOrient( int const id[3], double t,
+               std::vector< double > const &motion )
+{
+  double p[3][2];
+  for( int i=0; i<3; i++ )
+  {
+    double const * const m = &motion[4*id[i]];
+    p[i][0] = m[0] + t * m[2];
+    p[i][1] = m[1] + t * m[3];
+  }
+  return predicate.orient2d( p[0], p[1], p[2] );
+}
+
+template< class tSubNode >
+double tMesh< tSubNode >::
+KineticCollapseTime( int const id[3], double t,
+                     std::vector< double > const &motion, double &tsafe )
+{
+  const int kBisections = 40;
+  double const * const a = &motion[4*id[0]];
+  double const * const b = &motion[4*id[1]];
+  double const * const c = &motion[4*id[2]];
+  tsafe = t;
+  // orientation = A t^2 + B t + C, with u = a-c and v = b-c
+  const double u0x = a[0]-c[0], u0y = a[1]-c[1], dux = a[2]-c[2], duy = a[3]-c[3];
+  const double v0x = b[0]-c[0], v0y = b[1]-c[1], dvx = b[2]-c[2], dvy = b[3]-c[3];
+  if( dux==0. && duy==0. && dvx==0. && dvy==0. )
+    return 2.;  // no relative motion: the triangle stays what it is now
+  if( KineticOrient( id, t, motion ) <= 0. ) return t;
+
+  const double A = dux*dvy - duy*dvx;
+  const double B = u0x*dvy + dux*v0y - u0y*dvx - duy*v0x;
+  const double C = u0x*v0y - u0y*v0x;
+  double r[3];
+  int nr = 0;
+  if( A == 0. )
+  {
+    if( B != 0. ) r[nr++] = -C/B;
+  }
+  else
+  {
+    const double disc = B*B - 4.*A*C;
+    if( disc >= 0. )
+    {
+      const double q = -0.5*( B + ( B<0. ? -sqrt(disc) : sqrt(disc) ) );
+      r[0] = q/A;
+      r[1] = ( q != 0. ) ? C/q : r[0];
+      if( r[1] < r[0] ) { const double tmp = r[0]; r[0] = r[1]; r[1] = tmp; }
+      r[2] = 0.5*( r[0] + r[1] );  // in case both roots are very close
+      nr = 3;
+    }
+  }
+
+  // First point, after t, at which the triangle is found not to be CCW;
+  // t=1 is looked at too in case round-off hid the roots
+  double thi = 2.;
+  for( int k=0; k<nr && thi>1.; k++ )
+  {
+    if( r[k] < t || r[k] > 1. ) continue;
+    const double tr = r[k] + 1e-12 < 1. ? r[k] + 1e-12 : 1.;
+    if( KineticOrient( id, tr, motion ) <= 0. ) thi = tr;
+  }
+  if( thi > 1. && KineticOrient( id, 1., motion ) <= 0. ) thi = 1.;
+  if( thi > 1. ) return 2.;
+
+  double tlo = t;
+  for( int j=0; j<kBisections; j++ )
+  {
+    const double tmid = 0.5*(tlo+thi);
+    if( tmid <= tlo || tmid >= thi ) break;
+    if( KineticOrient( id, tmid, motion ) > 0. ) tlo = tmid;
+    else thi = tmid;
+  }
+  tsafe = tlo;
+  return thi;
+}
+
+template< class tSubNode >
+void tMesh< tSubNode >::
+ScheduleKineticFlip( tTriangle *tri, int nv, double t,
+                     std::vector< double > const &motion,
+                     std::vector< unsigned > const &stamp,
+                     kineticQueue_t &events )
+{
+  tTriangle * const triop = tri->tPtr(nv);
+  if( triop == 0 || !tri->ePtr( (nv+2)%3 )->isFlippable() ) return;
+
+  int id[4];
+  for( int i=0; i<3; i++ ) id[i] = tri->pPtr( (nv+i)%3 )->getID();
+  id[3] = triop->pPtr( triop->nVOp( tri ) )->getID();
+  const double te = KineticFlipTime( id, t, motion );
+  if( te > 1. ) return;
+
+  tKineticEvent ev;
+  ev.t = te;
+  ev.type = kKineticFlip;
+  ev.tri = tri;
+  ev.nv = nv;
+  ev.triop = triop;
+  ev.stamp = stamp[tri->getID()];
+  ev.stampop = stamp[triop->getID()];
+  ev.tsafe = t;
+  events.push( ev );
+}
+
+template< class tSubNode >
+void tMesh< tSubNode >::
+ScheduleKineticCollapse( tTriangle *tri, double t,
+                         std::vector< double > const &motion,
+                         std::vector< unsigned > const &stamp,
+                         kineticQueue_t &events )
+{
+  int id[3];
+  for( int i=0; i<3; i++ ) id[i] = tri->pPtr(i)->getID();
+  double tsafe;
+  const double te = KineticCollapseTime( id, t, motion, tsafe );
+  if( te > 1. ) return;
+
+  tKineticEvent ev;
+  ev.t = te;
+  ev.type = kKineticCollapse;
+  ev.tri = tri;
+  ev.nv = 0;
+  ev.triop = 0;
+  ev.stamp = stamp[tri->getID()];
+  ev.stampop = 0;
+  ev.tsafe = tsafe;
+  events.push( ev );
+}
+
+
 /*****************************************************************************\
  **
  **  tMesh::MoveNodes (formerly PreApply)
@@ -6120,12 +7663,16 @@ CheckTriEdgeIntersect()
  **      Called by:  called outside of tMesh by routines that compute
  **                  node movement (e.g., stream meandering, as implemented
  **                  by tStreamMeander)
- **      Calls: CheckTriEdgeIntersect, CheckLocallyDelaunay, UpdateMesh,
- **             LocateTriangle, tLNode::LayerInterpolation
+ **      Calls: KineticMoveNodes, CheckTriEdgeIntersect, CheckLocallyDelaunay,
+ **             UpdateMesh, LocateTriangle, tLNode::LayerInterpolation
  **      Created: SL
  **      Modifications:
  **       - added interpFlag parameter to make layer interpolation optional,
  **         so it needn't be called for tectonic motions (GT 4/00)
+ **       - with OPT_KINETIC_MOVE (experimental), KineticMoveNodes is
+ **         called first and, if it succeeds, replaces
+ **         CheckTriEdgeIntersect and CheckLocallyDelaunay, which are
+ **         then only used for nodes it stopped short (10/2026)
  **
  \*****************************************************************************/
 template< class tSubNode >
@@ -6153,10 +7700,27 @@ MoveNodes( double time, bool interpFlag )
     }
   }
 
-  //check for triangles with edges which intersect (an)other edge(s)
-  CheckTriEdgeIntersect(); //calls tLNode::UpdateCoords() for each node
-                           //resolve any remaining problems after points moved
-  CheckLocallyDelaunay( time );
+  //flip edges in the order the moving nodes break them; if that carries
+  //the mesh through, check the triangles that were deformed, and take
+  //any nodes that had to be stopped short the rest of the way as usual
+  tPtrList< tTriangle > kineticTris;
+  bool stoppedShort = false;
+  if( mbKineticMove && KineticMoveNodes( kineticTris, stoppedShort ) )
+  {
+    MakeDelaunay( kineticTris, time );
+    if( stoppedShort )
+    {
+      CheckTriEdgeIntersect();
+      CheckLocallyDelaunay( time );
+    }
+  }
+  else
+  {
+    //check for triangles with edges which intersect (an)other edge(s)
+    CheckTriEdgeIntersect(); //calls tLNode::UpdateCoords() for each node
+                             //resolve any remaining problems after points moved
+    CheckLocallyDelaunay( time );
+  }
   UpdateMesh(false);
   CheckMeshConsistency();  // TODO: remove this debugging call for release
   if (0) //DEBUG
@@ -6180,39 +7744,110 @@ MoveNodes( double time, bool interpFlag )
  **      Data members updated: Mesh elements & their geometry
  **      Called by:  called outside of tMesh by routines that handle
  **                  adaptive meshing
- **      Calls: AddNode, UpdateMesh, tNode::getVoronoiVertexXYZList
+ **      Calls: AddNodes, tNode::getVoronoiVertexXYZList
  **      Created: GT, for dynamic mesh updating, Feb 2000
+ **      Modifications:
+ **       - the list version densifies around several nodes in one bulk
+ **         insertion (AddNodes) with a single mesh update; Voronoi
+ **         vertices shared by two of the nodes are only added once
+ **         (see also DeferNearbyCentres)
  **
  \*****************************************************************************/
 template<class tSubNode>
 void tMesh< tSubNode >::
 AddNodesAround( tSubNode * centerNode, double time )
+{
+  assert( centerNode!=0 );
+
+  tPtrList< tSubNode > centerNodes;
+  centerNodes.insertAtBack( centerNode );
+  AddNodesAround( centerNodes, time );
+}
+
+template<class tSubNode>
+void tMesh< tSubNode >::
+AddNodesAround( tPtrList< tSubNode > &centerNodes, double time,
+                tPtrList< tSubNode > *added )
 {
   tList< Point3D > vvtxlist;  // List of V. vertex (x,y,z) coords at a node
   tListIter< Point3D > vtxiter( vvtxlist );
+  tList< tSubNode > newNodes; // New nodes to be added--passed to AddNodes
+  tPtrListIter< tSubNode > centerIter( centerNodes );
+  tSubNode *centerNode;
+
+  // Get a list of Voronoi vertex coords around each node and queue a new
+  // node at each (note: we get all the lists first because the vertices
+  // will change as soon as we add the first node)
+  for( centerNode=centerIter.FirstP(); !(centerIter.AtEnd());
+       centerNode=centerIter.NextP() )
+  {
+    centerNode->getVoronoiVertexXYZList( &vvtxlist );
+    tSubNode tmpnode = *centerNode;  // Properties are those of centerNode
+    Point3D *xyz;  // Coordinates of current vertex
 
-  assert( centerNode!=0 );
+    // Note that the call to getVoronoiVertexListXYZList will compute a z
+    // value at each vertex using plane (linear) interpolation.
+    for( xyz=vtxiter.FirstP(); !(vtxiter.AtEnd()); xyz=vtxiter.NextP() )
+    {
+      tmpnode.set3DCoords( xyz->x, xyz->y, xyz->z );  // Assign to tmpnode
+      newNodes.insertAtBack( tmpnode );
+    }
+  }
+  AddNodes( newNodes, kUpdateMesh, time, added );
+}
 
-  // Get a list of Voronoi vertex coords and add a new node at each
-  // (note: we get the list first because the vertices will change
-  // as soon as we add the first node)
-  centerNode->getVoronoiVertexXYZList( &vvtxlist );
-  tSubNode tmpnode = *centerNode;  // New node to be added--passed to AddNode
-  Point3D *xyz;  // Coordinates of current vertex
+/*****************************************************************************\
+ **
+ **  tMesh::DeferNearbyCentres
+ **
+ **  Of a list of nodes to densify around in one AddNodesAround call,
+ **  keeps in centres only those which are more than two spokes from every
+ **  node kept before them, and moves the others, in order, to the back of
+ **  deferred. The new nodes added around a node take Voronoi area from
+ **  the nodes up to two spokes away, so a node densified one at a time
+ **  after its neighbour would have been checked with this smaller area;
+ **  the caller checks the deferred nodes again after the insertion, so
+ **  that no node is densified on the strength of an area it no longer has.
+ **
+ **      Called by: tErosion::DensifyMesh, tStreamNet::DensifyMeshDrArea
+ **      Created: 10/2026
+ **
+ \*****************************************************************************/
+template<class tSubNode>
+void tMesh< tSubNode >::
+DeferNearbyCentres( tPtrList< tSubNode > &centres,
+                    tPtrList< tSubNode > &deferred ) const
+{
+  std::set< tNode const * > near;  // within two spokes of a kept node
+  tPtrList< tSubNode > kept;
+  tPtrListIter< tSubNode > centerIter( centres );
+  tSubNode *centerNode;
 
-  // Here we add a new node at each vertex. Note that the call to
-  // getVoronoiVertexListXYZList will compute a z value at each vertex
-  // using plane (linear) interpolation.
-  for( xyz=vtxiter.FirstP(); !(vtxiter.AtEnd()); xyz=vtxiter.NextP() )
+  for( centerNode=centerIter.FirstP(); !(centerIter.AtEnd());
+       centerNode=centerIter.NextP() )
   {
-    //std::cout << "COORDS: x " << xyz->x << " y " << xyz->y << " z " << xyz->z << std::endl;
-    tmpnode.set3DCoords( xyz->x, xyz->y, xyz->z );  // Assign to tmpnode
-                                                    //cn->TellAll();
-                                                    //std::cout << "Before addition\n";
-    AddNode( tmpnode, kNoUpdateMesh, time );  // Add the node
+    if( near.count( centerNode ) )
+    {
+      deferred.insertAtBack( centerNode );
+      continue;
+    }
+    kept.insertAtBack( centerNode );
+    near.insert( centerNode );
+    tSpkIter sI( centerNode );
+    for( tEdge *ce=sI.FirstP(); !(sI.AtEnd()); ce=sI.NextP() )
+    {
+      tNode *nbr = ce->getDestinationPtrNC();
+      near.insert( nbr );
+      tSpkIter sI2( nbr );
+      for( tEdge *ce2=sI2.FirstP(); !(sI2.AtEnd()); ce2=sI2.NextP() )
+        near.insert( ce2->getDestinationPtr() );
+    }
   }
-  UpdateMesh();
-
+  centres.Flush();
+  tPtrListIter< tSubNode > keptIter( kept );
+  for( centerNode=keptIter.FirstP(); !(keptIter.AtEnd());
+       centerNode=keptIter.NextP() )
+    centres.insertAtBack( centerNode );
 }
 
 
@@ -6468,6 +8103,7 @@ SetmiNextTriID(int n_)
  **
  **  Set IDs in a canonical ordering independent of the list ordering
  **  As well, set tNode.edg to the spoke with the lowest destination node ID
+ **  (the next UpdateMesh is then a full one)
  **
  **  AD, April-May 2003 - moved to tMesh March 2004
  \*************************************************************************/
@@ -6569,6 +8205,9 @@ void tMesh<tSubNode>::RenumberIDCanonically()
       RTri[i]->setID(i);
     SetmiNextTriID( RTri.getSize() );
   }
+  // Spoke order, edge pairing and vertex order have changed, so a local
+  // geometry update would no longer reproduce a full one to the last bit.
+  InvalidateGeometry();
 }
 
 // qsort comparison function for canonical nodes ordering
@@ -6619,6 +8258,26 @@ int tMesh<tSubNode>::orderREdge( const void *a_, const void *b_ )
   abort();
 }
 
+// qsort comparison function for bulk insertion order (see AddNodes)
+template< class tSubNode >
+int tMesh<tSubNode>::orderInsertion( const void *a_, const void *b_ )
+{
+  const tInsertionKey *K1 = static_cast<tInsertionKey const *>(a_);
+  const tInsertionKey *K2 = static_cast<tInsertionKey const *>(b_);
+
+  if (K1->round < K2->round) return -1;
+  if (K1->round > K2->round) return 1;
+  if (K1->key < K2->key) return -1;
+  if (K1->key > K2->key) return 1;
+  if (K1->x < K2->x) return -1;
+  if (K1->x > K2->x) return 1;
+  if (K1->y < K2->y) return -1;
+  if (K1->y > K2->y) return 1;
+  if (K1->index < K2->index) return -1;
+  if (K1->index > K2->index) return 1;
+  return 0;
+}
+
 // qsort comparison function for canonical triangles ordering
 template< class tSubNode >
 int tMesh<tSubNode>::orderRTriangle( const void *a_, const void *b_ )
@@ -6638,6 +8297,257 @@ int tMesh<tSubNode>::orderRTriangle( const void *a_, const void *b_ )
   abort();
 }
 
+/*************************************************************************\
+ **
+ **  tMesh::ReorderHilbert
+ **
+ **  Puts the node, edge and triangle lists in the order of a Hilbert
+ **  curve over the domain, then resets IDs in the new list order.
+ **  Insertions and moveToActiveBack otherwise leave the lists in
+ **  whatever order the mesh was built and modified in, so that the
+ **  neighbours reached in a spoke loop were last touched far back in the
+ **  list walk. In Hilbert order they are mostly a few places away, so
+ **  they are still in cache.
+ **
+ **  The edges are also moved: they are copied into fresh storage in the
+ **  new order (tList::relocateInOrder) and every pointer to an edge --
+ **  spokes, complements, triangle edges, node edg and flow edges (via
+ **  tNode::setEdgePtrsFromVector) -- is redirected, so that walking the
+ **  edge list walks memory in order. Nodes and triangles are pointed to
+ **  from outside the mesh (stream network, stratigraphy and storm grids),
+ **  so they are only relinked; their list nodes stay where they are. The
+ **  active/boundary partitions of the node and edge lists are kept, as is
+ **  the pairing of each edge with its complement. Edges are placed by
+ **  their midpoints and triangles by their centroids.
+ **
+ **  For debugging, the share of edges whose two ends lie within kNearGap
+ **  places of each other on the node list, before and after, can be
+ **  reported as a measure of the locality gained.
+ **
+ **  Calls: HilbertIndex, tList::relinkInOrder, tList::relocateInOrder,
+ **         ResetNodeID, ResetTriangleID
+ **  Created: 10/2026
+ \*************************************************************************/
+template< class tSubNode >
+void tMesh<tSubNode>::ReorderHilbert()
+{
+  const int kHilbertOrder = 16; // Hilbert grid is 2^16 cells on a side
+  const int kNearGap = 32; // "near" on the list: a few nodes' worth of cache
+  const int nn = nodeList.getSize();
+  const int ne = edgeList.getSize();
+  const int nt = triList.getSize();
+  if( nn == 0 ) return;
+  nodeListIter_t niter( nodeList );
+  edgeListIter_t eiter( edgeList );
+  triListIter_t titer( triList );
+  tSubNode *cn;
+  tEdge *ce;
+  tTriangle *ct;
+  int i;
+
+  // Bounding box of the mesh, and locality before reordering
+  double xmin = 0., xmax = 0., ymin = 0., ymax = 0.;
+  for( cn = niter.FirstP(), i = 0; !(niter.AtEnd()); cn = niter.NextP(), ++i )
+  {
+    if( i == 0 || cn->getX() < xmin ) xmin = cn->getX();
+    if( i == 0 || cn->getX() > xmax ) xmax = cn->getX();
+    if( i == 0 || cn->getY() < ymin ) ymin = cn->getY();
+    if( i == 0 || cn->getY() > ymax ) ymax = cn->getY();
+  }
+  const double extent = ( xmax-xmin > ymax-ymin ) ? xmax-xmin : ymax-ymin;
+  const double scale = ( extent > 0.0 ) ?
+    ( ( 1u << kHilbertOrder ) - 1 ) / extent : 0.0;
+  ResetNodeID();
+  int nearBefore = 0;
+  if(0) //DEBUG
+    for( ce = eiter.FirstP(); !(eiter.AtEnd()); ce = eiter.NextP() )
+      if( abs( ce->getOriginPtr()->getID()
+               - ce->getDestinationPtr()->getID() ) <= kNearGap )
+        ++nearBefore;
+
+  // Keys are sorted with orderInsertion; "round" keeps the list
+  // partition (0 = active, 1 = boundary) and "index" the list position
+  std::vector< tInsertionKey > keys;
+  std::vector< void * > items;
+
+  // Nodes
+  keys.resize( nn );
+  items.resize( nn );
+  for( cn = niter.FirstP(), i = 0; !(niter.AtEnd()); cn = niter.NextP(), ++i )
+  {
+    keys[i].round = niter.IsActive() ? 0 : 1;
+    keys[i].x = cn->getX();
+    keys[i].y = cn->getY();
+    keys[i].index = i;
+    items[i] = niter.NodePtr();
+  }
+  SortHilbert( keys, xmin, ymin, scale, kHilbertOrder );
+  {
+    std::vector< nodeListNode_t * > order( nn );
+    for( i = 0; i < nn; ++i )
+      order[i] = static_cast< nodeListNode_t * >( items[keys[i].index] );
+    nodeList.relinkInOrder( &order[0] );
+  }
+
+  // Edges, in complementary pairs
+  keys.resize( ne/2 );
+  items.resize( ne/2 );
+  for( ce = eiter.FirstP(), i = 0; !(eiter.AtEnd()); ce = eiter.NextP(), ++i )
+  {
+    keys[i].round = eiter.IsActive() ? 0 : 1;
+    keys[i].x = 0.5 * ( ce->getOriginPtr()->getX()
+                        + ce->getDestinationPtr()->getX() );
+    keys[i].y = 0.5 * ( ce->getOriginPtr()->getY()
+                        + ce->getDestinationPtr()->getY() );
+    keys[i].index = i;
+    items[i] = eiter.NodePtr();
+    eiter.Next(); // skip complement
+  }
+  SortHilbert( keys, xmin, ymin, scale, kHilbertOrder );
+  if( ne > 0 )
+  {
+    // Number the edges in their new order, copy them into fresh storage
+    // in that order, and redirect every pointer to an edge by its ID
+    std::vector< edgeListNode_t * > order( ne ), fresh( ne );
+    std::vector< tEdge * > moved( ne );
+    for( i = 0; i < ne/2; ++i )
+    {
+      order[2*i] = static_cast< edgeListNode_t * >( items[keys[i].index] );
+      order[2*i+1] = order[2*i]->getNextNC();
+    }
+    for( i = 0; i < ne; ++i )
+      order[i]->getDataPtrNC()->setID( i );
+    edgeList.relocateInOrder( &order[0], &fresh[0] );
+    for( i = 0; i < ne; ++i )
+      moved[i] = fresh[i]->getDataPtrNC();
+    for( i = 0; i < ne; ++i )
+    {
+      ce = moved[i];
+      ce->setCCWEdg( moved[ce->getCCWEdg()->getID()] );
+      ce->setCWEdg( moved[ce->getCWEdg()->getID()] );
+      ce->setComplementEdge( moved[ce->getComplementEdge()->getID()] );
+    }
+    for( ct = titer.FirstP(); !(titer.AtEnd()); ct = titer.NextP() )
+      for( int k = 0; k < 3; ++k )
+        ct->setEPtr( k, moved[ct->ePtr(k)->getID()] );
+    for( cn = niter.FirstP(); !(niter.AtEnd()); cn = niter.NextP() )
+    {
+      tArray< int > ids = cn->getEdgePtrIndices();
+      std::vector< tEdge * > ptrs( ids.getSize() );
+      for( size_t k = 0; k < ids.getSize(); ++k )
+        ptrs[k] = ( ids[k] >= 0 ) ? moved[ids[k]] : 0;
+      cn->setEdgePtrsFromVector( ptrs );
+    }
+    for( i = 0; i < ne; ++i )
+      delete order[i];
+  }
+
+  // Triangles
+  keys.resize( nt );
+  items.resize( nt );
+  for( ct = titer.FirstP(), i = 0; !(titer.AtEnd()); ct = titer.NextP(), ++i )
+  {
+    keys[i].round = 0;
+    keys[i].x = ( ct->pPtr(0)->getX() + ct->pPtr(1)->getX()
+                  + ct->pPtr(2)->getX() ) / 3.0;
+    keys[i].y = ( ct->pPtr(0)->getY() + ct->pPtr(1)->getY()
+                  + ct->pPtr(2)->getY() ) / 3.0;
+    keys[i].index = i;
+    items[i] = titer.NodePtr();
+  }
+  SortHilbert( keys, xmin, ymin, scale, kHilbertOrder );
+  {
+    std::vector< triListNode_t * > order( nt );
+    for( i = 0; i < nt; ++i )
+      order[i] = static_cast< triListNode_t * >( items[keys[i].index] );
+    triList.relinkInOrder( &order[0] );
+  }
+
+  ResetNodeID();
+  SetmiNextEdgID( ne );
+  ResetTriangleID();
+  miNodesChangedSinceReorder = 0;
+  // Edge IDs have changed (see RenumberIDCanonically)
+  InvalidateGeometry();
+
+  if(0) //DEBUG
+  {
+    int nearAfter = 0;
+    for( ce = eiter.FirstP(); !(eiter.AtEnd()); ce = eiter.NextP() )
+      if( abs( ce->getOriginPtr()->getID()
+               - ce->getDestinationPtr()->getID() ) <= kNearGap )
+        ++nearAfter;
+    if( ne > 0 )
+      std::cout << "ReorderHilbert: edges with ends within " << kNearGap
+                << " list places: " << (100*nearBefore)/ne << "% -> "
+                << (100*nearAfter)/ne << "%" << std::endl;
+  }
+}
+
+// Fill in the Hilbert indices of keys (x,y already set) and sort them
+template< class tSubNode >
+void tMesh<tSubNode>::SortHilbert( std::vector< tInsertionKey > &keys,
+                                   double xmin, double ymin, double scale,
+                                   int order )
+{
+  if( keys.empty() ) return;
+  for( size_t i = 0; i < keys.size(); ++i )
+    keys[i].key =
+      HilbertIndex( static_cast<unsigned>( ( keys[i].x - xmin ) * scale ),
+                    static_cast<unsigned>( ( keys[i].y - ymin ) * scale ),
+                    order );
+  qsort( &keys[0], keys.size(), sizeof(keys[0]), orderInsertion );
+}
+
+/*************************************************************************\
+ **
+ **  tMesh::ReorderIfNecessary
+ **
+ **  Calls ReorderHilbert if the OPT_MESH_REORDER option is set and the
+ **  nodes added or deleted since the last reordering amount to more than
+ **  a tenth of the mesh, so that large topology changes (adaptive
+ **  meshing, meandering) do not slowly undo the ordering.
+ **
+ \*************************************************************************/
+template< class tSubNode >
+void tMesh<tSubNode>::ReorderIfNecessary()
+{
+  if( mbReorder && 10*miNodesChangedSinceReorder > nodeList.getSize() )
+    ReorderHilbert();
+}
+
+/*************************************************************************\
+ **
+ **  tMesh::AddMemoryFootprint
+ **
+ **  Adds to mf the memory held in the node, edge and triangle lists,
+ **  and what each node owns besides (layers, per-size arrays, trees;
+ **  see tLNode::AddMemoryFootprint), and sets the element counts.
+ **
+ **  Created: 10/2026
+ **
+ \*************************************************************************/
+template< class tSubNode >
+void tMesh<tSubNode>::AddMemoryFootprint( tMemoryFootprint &mf ) const
+{
+  const int nnodes = nodeList.getSize();
+  const int nedges = edgeList.getSize();
+  const int ntri = triList.getSize();
+  int i;
+  mf.nNodes = nnodes;
+  mf.nEdges = nedges;
+  mf.nTriangles = ntri;
+  for( i=0; i<nnodes; ++i )
+    mf.AddBlock( tMemoryFootprint::kNodes, sizeof( nodeListNode_t ) );
+  for( i=0; i<nedges; ++i )
+    mf.AddBlock( tMemoryFootprint::kEdges, sizeof( edgeListNode_t ) );
+  for( i=0; i<ntri; ++i )
+    mf.AddBlock( tMemoryFootprint::kTriangles, sizeof( triListNode_t ) );
+  nodeListNode_t const *ln = nodeList.getFirst();
+  for( i=0; i<nnodes; ++i, ln = ln->getNext() )
+    ln->getDataRef().AddMemoryFootprint( mf );
+}
+
 /*****************************************************************************\
  **
  **      InterveningTriangles: find triangles between one node and the next
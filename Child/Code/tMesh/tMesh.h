@@ -21,6 +21,16 @@
 **    - added default argument "interpFlag" to MoveNodes() in order
 **      to have nodes moved w/o interpolation (eg, for tectonic movement)
 **      (GT, 4/00)
+**    - added AddNodes for bulk insertion in Hilbert (BRIO) order, with
+**      LocateTriangle walks starting from the previous insertion
+**    - added ReorderHilbert to relink the element lists along a Hilbert
+**      curve (option OPT_MESH_REORDER)
+**    - added KineticMoveNodes: MoveNodes flips edges in the time order
+**      in which the moving nodes break them (experimental option
+**      OPT_KINETIC_MOVE, off by default)
+**    - CheckMeshConsistency can check only the elements changed since
+**      the last check, a random sample, or all of them in parallel
+**      (option OPT_CHECK_MESH_MODE)
 **
 **  $Id: tMesh.h,v 1.82 2008-07-07 16:18:58 childcvs Exp $
 */
@@ -36,6 +46,9 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
+#include <queue>
+#include <set>
 #include "../Classes.h"
 #include "../Definitions.h"
 #include "../tArray/tArray.h"
@@ -47,6 +60,7 @@
 #include "../tMeshList/tMeshList.h"
 #include "../MeshElements/meshElements.h"
 #include "../tLNode/tLNode.h"
+#include "../tMemoryFootprint/tMemoryFootprint.h"
 #include "../tListInputData/tListInputData.h"
 //#include "../tListOutputData/tListOutputData.h"
 #include "../globalFns.h"
@@ -106,6 +120,40 @@ typedef enum {
   kNoFlip,
   kFlip
 } kFlip_t;
+/* how UpdateMesh recomputes Voronoi geometry (OPT_MESH_GEOMETRY_UPDATE) */
+typedef enum {
+  kGeomUpdateLocal = 0,   // only around nodes touched since last update
+  kGeomUpdateFull = 1,    // whole mesh, every time
+  kGeomUpdateValidate = 2 // local, then checked against a full recompute
+} kGeomUpdate_t;
+/* how CheckMeshConsistency audits the mesh (OPT_CHECK_MESH_MODE) */
+typedef enum {
+  kCheckMeshFull = 0,        // every element, serially
+  kCheckMeshIncremental = 1, // elements around nodes changed since last check
+  kCheckMeshSampled = 2,     // CHECK_MESH_SAMPLE random elements of each kind
+  kCheckMeshParallel = 3     // every element, multithreaded
+} kCheckMesh_t;
+/* sort record for bulk node insertion (see tMesh::AddNodes) */
+typedef struct {
+  int round;            // BRIO round; smaller rounds are inserted first
+  unsigned long key;    // Hilbert index within the batch bounding box
+  double x, y;          // coordinates, to bring duplicates together
+  int index;            // position in the batch
+} tInsertionKey;
+/* event for kinetic node movement (see tMesh::KineticMoveNodes) */
+typedef enum {
+  kKineticFlip,         // an edge stops being Delaunay
+  kKineticCollapse      // a triangle becomes degenerate
+} kKineticEvent_t;
+typedef struct {
+  double t;             // time of the event, from 0 (old) to 1 (new coords)
+  kKineticEvent_t type;
+  tTriangle *tri;       // triangle, and its vertex opposite the edge to flip
+  int nv;
+  tTriangle *triop;     // triangle on the other side of the edge (flips)
+  unsigned stamp, stampop; // versions of tri and triop when queued
+  double tsafe;         // last time tri is known to be CCW (collapses)
+} tKineticEvent;
 
 
 /****************************/
@@ -131,6 +179,14 @@ class tMesh
    void MeshDensification( const tInputFile & );
    void MakeDelaunay( tPtrList< tTriangle > &, double time );
    void SplitNonFlippableEdge( tPtrList< tEdge > &, double time );
+   // per-element tests of CheckMeshConsistency; report prints the failure
+   bool CheckEdgeConsistency( tEdge *, bool report ) const;
+   bool CheckNodeConsistency( tNode *, bool boundaryCheckFlag,
+                              bool report ) const;
+   bool CheckTriConsistency( tTriangle *, bool report );
+   void SampleCheckElements( std::vector< tEdge * > &,
+                             std::vector< tNode * > &,
+                             std::vector< tTriangle * > & );
 public:
    // list types
    typedef tMeshList< tSubNode, tListNodeListable< tSubNode > > nodeList_t;
@@ -175,7 +231,8 @@ public:
    void setVoronoiVertices();
    void CalcVoronoiEdgeLengths();
    void CalcVAreas();
-   tTriangle *LocateTriangle( double, double, bool useFuturePosn=false );
+   tTriangle *LocateTriangle( double, double, bool useFuturePosn=false,
+                              tTriangle *startTri=0 );
    tTriangle *LocateNewTriangle( double, double );
    /*returns ptr to triangle which points to edge, or zero if none:*/
    tTriangle *TriWithEdgePtr( tEdge * ) const;
@@ -217,15 +274,25 @@ public:
    tSubNode* InsertNode( tSubNode*, double );
    //add a generic node at the referenced coordinates
    tSubNode *AddNodeAt( tArray< double > &, double time = 0.0 );
+   //add copies of a batch of nodes in Hilbert (BRIO) order; returns # added
+   int AddNodes( tList< tSubNode > &, kUpdateMesh_t updatemesh = kUpdateMesh,
+                 double time = 0.0, tPtrList< tSubNode > *added = 0 );
    tSubNode* AttachNode( tSubNode*, tTriangle* );
    edgeList_t * getEdgeList() { return &edgeList; }
    nodeList_t * getNodeList() { return &nodeList; }
+   // changes whenever a node is added or deleted (for caches of node ptrs)
+   unsigned long getNodeListVersion() const { return mlNodeListVersion; }
    triList_t * getTriList() { return &triList; }
    tEdge *getEdgeComplement( tEdge * ) const;
    /* Tests consistency of a user-defined mesh */
    void CheckMeshConsistency( bool boundaryCheckFlag=true );
    /* Updates mesh by comp'ing edg lengths & slopes & node Voronoi areas */
    void UpdateMesh( bool checkMeshConsistency = true );
+   /* record nodes whose position or connectivity changed (see UpdateMesh) */
+   void MarkGeometryChanged( tSubNode * );
+   void InvalidateGeometry(); // next UpdateMesh recomputes the whole mesh
+   /* renews the CHECK_MESH_SAMPLE budget of sampled checks, once a step */
+   void StartCheckMeshStep() { miCheckSampleLeft = miCheckMeshSample; }
    /* computes edge slopes as (Zorg-Zdest)/Length */
    //void CalcSlopes(); /* WHY is this commented out? */
    /*routines used to move points; MoveNodes is "master" function*/
@@ -237,6 +304,11 @@ public:
    //after the three above functions and in the order listed below.
    void CheckTriEdgeIntersect();
    void CheckLocallyDelaunay( double time );
+   //optional (experimental) replacement for the two above: flips the
+   //edges the moving nodes break, in time order, and lists the triangles
+   //to check after
+   bool KineticMoveNodes( tPtrList< tTriangle > &checkTris,
+                          bool &stoppedShort );
    //once 'newx' and 'newy' are set, this is the only function one needs to call
    //to execute the move; maybe should have a separate function for doing things
    //peculiar to channels, but now this is the only one.
@@ -244,6 +316,10 @@ public:
    /*end moving routines*/
 
    void AddNodesAround( tSubNode *, double time=0.0 );  // Local mesh densify
+   void AddNodesAround( tPtrList< tSubNode > &, double time=0.0,
+                        tPtrList< tSubNode > *added = 0 );
+   void DeferNearbyCentres( tPtrList< tSubNode > &centres,
+                            tPtrList< tSubNode > &deferred ) const;
 
    static bool IDTooLarge(int, int);
    void ResetNodeIDIfNecessary();
@@ -253,6 +329,9 @@ public:
    void ResetEdgeID(); // reset edge IDs in list order
    void ResetTriangleID(); // reset triangle IDs in list order
    void RenumberIDCanonically(); // reset IDs in canonical order
+   void ReorderHilbert(); // relink lists in Hilbert order, reset IDs
+   void ReorderIfNecessary(); // ReorderHilbert if option set and due
+   void AddMemoryFootprint( tMemoryFootprint & ) const; // memory held
    void SetmiNextNodeID(int);
    void SetmiNextEdgID(int);
    void SetmiNextTriID(int);
@@ -282,6 +361,38 @@ private:
    static int orderRNode(const void*, const void*);
    static int orderREdge(const void*, const void*);
    static int orderRTriangle(const void*, const void*);
+   static int orderInsertion(const void*, const void*);
+   static void SortHilbert( std::vector< tInsertionKey > &, double xmin,
+                            double ymin, double scale, int order );
+   typedef std::priority_queue< tKineticEvent, std::vector< tKineticEvent >,
+     bool (*)( tKineticEvent const &, tKineticEvent const & ) > kineticQueue_t;
+   static bool kineticEventLater( tKineticEvent const &,
+                                  tKineticEvent const & );
+   static double KineticInCircle( int const id[4], double t,
+                                  std::vector< double > const &motion );
+   static double KineticFlipTime( int const id[4], double t,
+                                  std::vector< double > const &motion );
+   static double KineticOrient( int const id[3], double t,
+                                std::vector< double > const &motion );
+   static double KineticCollapseTime( int const id[3], double t,
+                                      std::vector< double > const &motion,
+                                      double &tsafe );
+   void ScheduleKineticFlip( tTriangle *, int nv, double t,
+                             std::vector< double > const &motion,
+                             std::vector< unsigned > const &stamp,
+                             kineticQueue_t & );
+   void ScheduleKineticCollapse( tTriangle *, double t,
+                                 std::vector< double > const &motion,
+                                 std::vector< unsigned > const &stamp,
+                                 kineticQueue_t & );
+
+   void UpdateMeshFull();
+   bool UpdateMeshLocal();
+   void ValidateMeshGeometry();
+   void ForgetGeometryChange( tSubNode const * );
+   static void PurgeForgottenNodes( tPtrList< tSubNode > &,
+                                    std::set< tSubNode const * > & );
+   void RelinkCopiedElements( tMesh * );
 
 protected:
    nodeList_t nodeList; // list of nodes
@@ -296,7 +407,22 @@ protected:
    int miNextTriID;                    // next ID for added triangle
    bool layerflag;                 // flag indicating whether nodes have layers
    bool runCheckMeshConsistency;    // shall we run the tests ?
+   kCheckMesh_t miCheckMeshMode;    // full, incremental, sampled, parallel
+   int miCheckMeshSample;           // elements of each kind per step
+   int miCheckSampleLeft;           // of those, not yet checked this step
+   bool mbCheckMeshFull;            // next incremental check must be full
+   tPtrList< tSubNode > mCheckChangedNodes; // nodes changed since the check
+   std::set< tSubNode const * > mCheckForgotten; // deleted, still in it
+   tRand mCheckRand;                // random source for sampled checks
    tIDGenerator node_ID_generator;  // generates permanent IDs for nodes
+   kGeomUpdate_t miGeomUpdateMode;  // local, full or validated updates
+   bool mbGeomFullUpdate;           // geometry must be recomputed everywhere
+   tPtrList< tSubNode > mGeomChangedNodes; // nodes changed since UpdateMesh
+   std::set< tSubNode const * > mGeomForgotten; // deleted, still in it
+   bool mbReorder;                  // option for Hilbert-order lists
+   int miNodesChangedSinceReorder;  // nodes added or deleted since then
+   unsigned long mlNodeListVersion; // nodes added or deleted, ever
+   bool mbKineticMove;              // option for kinetic MoveNodes
 
    // Additions DAV 2016
    double maxXdomain;  // Maximum coordinates - used in the storm generator.
@@ -86,6 +86,8 @@ class tMeshList : public tList< NodeType, ListNodeType >
    int removeFromFront( NodeType & );
    inline void moveToBefore( ListNodeType*, ListNodeType* );
    inline void moveToAfter( ListNodeType*, ListNodeType* );
+   void relinkInOrder( ListNodeType * const * );
+   void relocateInOrder( ListNodeType * const *, ListNodeType ** );
    int InActiveList( ListNodeType const * );
    void Flush();
    int CheckConsistency( const char * );
@@ -570,6 +572,30 @@ moveToAfter( ListNodeType* mvnode,
     lastactive = mvnode;
 }
 
+/**************************************************************************\
+**
+**  tMeshList::relinkInOrder
+**  tMeshList::relocateInOrder
+**
+**  As in tList; the active items must come first in _order_.
+**
+\**************************************************************************/
+template< class NodeType, class ListNodeType >
+void tMeshList< NodeType, ListNodeType >::
+relinkInOrder( ListNodeType * const * order )
+{
+   tList< NodeType, ListNodeType >::relinkInOrder( order );
+   lastactive = ( nActiveNodes > 0 ) ? order[nActiveNodes-1] : 0;
+}
+
+template< class NodeType, class ListNodeType >
+void tMeshList< NodeType, ListNodeType >::
+relocateInOrder( ListNodeType * const * order, ListNodeType ** moved )
+{
+   tList< NodeType, ListNodeType >::relocateInOrder( order, moved );
+   lastactive = ( nActiveNodes > 0 ) ? moved[nActiveNodes-1] : 0;
+}
+
 /**************************************************************************\
 **
 **  tMeshList::Flush
@@ -14,6 +14,8 @@
  **       this now result in a large number of output files created
  **     - 7/03 AD added tOutputBase and tTSOutputImp
  **     - 8/03: AD Random number generator handling
+ **     - 10/26 mesh and node-field files optionally compressed
+ **       (OPT_COMPRESS_OUTPUT; see tFieldCodec)
  **
  **  $Id: tOutput.cpp,v 1.105 2008-07-07 16:18:58 childcvs Exp $
  */
@@ -32,6 +34,8 @@
 #include "../tStreamNet/tStreamNet.h" // For k2DKinematicWave and kHydrographPeakMethod
 #include "../tStratGrid/tStratGrid.h"
 #include "../tFloodplain/tFloodplain.h"
+#include "../tInSituAnalysis/tInSituAnalysis.h"
+#include "../tStratBinary/tStratBinary.h"
 
 
 /**************************************************************************/
@@ -42,6 +46,7 @@
  **
  ** Modifications:
  ** - 07/03 moved from tLOutput (AD)
+ ** - 10/26 added in-situ reducers (tInSituAnalysis), written to .insitu
  **
  */
 /**************************************************************************/
@@ -56,13 +61,17 @@ public:
 //     : volsofs(orig.volsofs), dvolsofs(orig.dvolsofs), tareaofs(orig.tareaofs), 
 //       vegcovofs(orig.vegcovofs), mdLastVolume(orig.mdLastVolume) {}
   tTSOutputImp( tMesh<tSubNode> * meshPtr, const tInputFile &infile );
-  void WriteTSOutput();
+  void WriteTSOutput( double time );
 private:
   std::ofstream volsofs;    // catchment volume
   std::ofstream dvolsofs;
   std::ofstream tareaofs;   // total voronoi area of catchment
   std::ofstream vegcovofs;  // Catchment vegetation cover %
+  std::ofstream insituofs;  // results of the in-situ reducers
   double mdLastVolume;
+  tInSituAnalysis insitu;   // reducers selected in INSITU_REDUCERS
+
+  void WriteInSituOutput( double time );
 };
 
 /**************************************************************************/
@@ -76,6 +85,8 @@ private:
 ** Modifications:
 **  - 6/03 added 3 x 10 files for stratigraphic sections (z,texture,facies)
 **    (QC)
+**  - 10/26 complete stratigraphy optionally written as one columnar
+**    binary file (OPT_STRAT_BINARY; see tStratBinary)
 */
 /**************************************************************************/
 template< class tSubNode >
@@ -120,6 +131,10 @@ private:
 
   tStratGrid *stratGrid; // pointer to stratigraphy grid
   tStreamNet *netPtr;
+
+  // Complete stratigraphy, kept from one output to the next
+  bool binaryStrat;      // OPT_STRAT_BINARY: write it as .stratbin
+  tStratBinary strat;
 };
 
 /*************************************************************************\
@@ -138,7 +153,9 @@ private:
 template< class tSubNode >
 tOutputBase<tSubNode>::tOutputBase( tMesh<tSubNode> * meshPtr,
 				    const tInputFile &infile ) :
-  m(meshPtr)
+  m(meshPtr),
+  compressOutput( infile.ReadBool( "OPT_COMPRESS_OUTPUT", false ) ),
+  selection( infile )
 {
   assert( meshPtr != 0 );
   infile.ReadItem( baseName, sizeof(baseName), "OUTFILENAME" );
@@ -181,6 +198,36 @@ void tOutputBase<tSubNode>::CreateAndOpenFile( std::ofstream *theOFStream,
   theOFStream->precision( 12 );
 }
 
+/*************************************************************************\
+ **
+ **  tOutputBase::CreateAndOpenFile
+ **
+ **  As above, for the mesh and node-field files: opens
+ **  <baseName><extension>, or <baseName><extension>.fz when
+ **  OPT_COMPRESS_OUTPUT is set (see tFieldCodec), to be written at the
+ **  interval given in OUTPUT_INTERVALS. A file given an interval of 0
+ **  is not created.
+ **
+\*************************************************************************/
+template< class tSubNode >
+void tOutputBase<tSubNode>::CreateAndOpenFile( tFieldOStream *theStream,
+					       const char *extension ) const
+{
+  const int interval = selection.getInterval( extension );
+  theStream->setInterval( interval );
+  if( interval == 0 )
+    return;
+
+  std::string fullName( baseName );
+  fullName += extension;
+  theStream->open( fullName.c_str(), compressOutput );
+
+  if( !theStream->good() )
+    ReportFatalError(
+		     "I can't create files for output. Storage space may be exhausted.");
+  theStream->precision( 12 );
+}
+
 /*************************************************************************\
  **
  **  tBaseOutput::WriteTimeNumberElements
@@ -194,6 +241,13 @@ void tOutputBase<tSubNode>::WriteTimeNumberElements( std::ofstream &fs,
   fs << ' ' << time << '\n' << n << '\n';
 }
 
+template< class tSubNode >
+void tOutputBase<tSubNode>::WriteTimeNumberElements( tFieldOStream &fs,
+						     double time, int n )
+{
+  fs << ' ' << time << '\n' << n << '\n';
+}
+
 /*************************************************************************\
  **
  **  Constructor
@@ -451,6 +505,11 @@ tLOutput<tSubNode>::tLOutput( tMesh<tSubNode> *meshPtr,
     Surfer = (opOpt = infile.ReadItem( opOpt, "SURFER", false)) != 0;
   }
   //XSurfer = infile.ReadBool( "SURFER", false);
+
+  // Node mask: IDs of the nodes written
+  if( this->selection.HasMask() )
+    this->CreateAndOpenFile( &maskofs, ".maskid" );
+  this->selection.ReportUnused();
 }
 
 /*************************************************************************\
@@ -523,48 +582,69 @@ void tLOutput<tSubNode>::WriteNodeData( double time )
   // *Counter that counts the number of write timesteps* 
   counter++;
 
+  // Nodes to write: with OUTPUT_MASK, those inside it, whose IDs are
+  // written to the .maskid file
+  int nActiveOut = nActiveNodes, nOut = nnodes;
+  if( this->selection.HasMask() )
+    {
+      typename tMesh< tSubNode >::tIdArrayNode_t RNode(*(this->m->getNodeList()));
+      inMask.assign( nnodes, 0 );
+      nActiveOut = nOut = 0;
+      for( int i=0; i<nnodes; ++i )
+	if( this->selection.InMask( RNode[i]->getX(), RNode[i]->getY() ) )
+	  {
+	    inMask[i] = 1;
+	    ++nOut;
+	    if( i<nActiveNodes ) ++nActiveOut;
+	  }
+      this->WriteTimeNumberElements( maskofs, time, nOut );
+      for( int i=0; i<nnodes; ++i )
+	if( inMask[i] ) maskofs << i << '\n';
+      maskofs << std::flush;
+    }
+
   // Write current time in each file
   this->WriteTimeNumberElements( randomofs, time, rand->numberRecords());
-  this->WriteTimeNumberElements( drareaofs, time, nActiveNodes);
-  this->WriteTimeNumberElements( netofs, time, nActiveNodes);
-  this->WriteTimeNumberElements( slpofs, time, nnodes);
-  this->WriteTimeNumberElements( qofs, time, nnodes);
-  this->WriteTimeNumberElements( pofs, time, nActiveNodes);
+  this->WriteTimeNumberElements( drareaofs, time, nActiveOut);
+  this->WriteTimeNumberElements( netofs, time, nActiveOut);
+  this->WriteTimeNumberElements( slpofs, time, nOut);
+  this->WriteTimeNumberElements( qofs, time, nOut);
+  this->WriteTimeNumberElements( pofs, time, nActiveOut);
   if(OptLayOutput)
     this->WriteTimeNumberElements( layofs, time, nActiveNodes);
-  this->WriteTimeNumberElements( texofs, time, nnodes);
+  this->WriteTimeNumberElements( texofs, time, nOut);
   if( surfofs.good() )
     this->WriteTimeNumberElements( surfofs, time, nActiveNodes);
 
-  this->WriteTimeNumberElements( tauofs, time, nnodes);
+  this->WriteTimeNumberElements( tauofs, time, nOut);
   if( vegofs.good() )
-    this->WriteTimeNumberElements( vegofs, time, nnodes);
+    this->WriteTimeNumberElements( vegofs, time, nOut);
   if( forestofs.good() )
-    this->WriteTimeNumberElements( forestofs, time, nnodes );
+    this->WriteTimeNumberElements( forestofs, time, nOut );
   if( flowdepofs.good() )
-    this->WriteTimeNumberElements( flowdepofs, time, nnodes);
+    this->WriteTimeNumberElements( flowdepofs, time, nOut);
   if( chanwidthofs.good() )
-    this->WriteTimeNumberElements( chanwidthofs, time, nnodes);
+    this->WriteTimeNumberElements( chanwidthofs, time, nOut);
   if( flowpathlenofs.good() )
-    this->WriteTimeNumberElements( flowpathlenofs, time, nnodes);
+    this->WriteTimeNumberElements( flowpathlenofs, time, nOut);
   if( qsofs.good() )
-    this->WriteTimeNumberElements( qsofs, time, nnodes);
+    this->WriteTimeNumberElements( qsofs, time, nOut);
   if( qsinofs.good() )
-    this->WriteTimeNumberElements( qsinofs, time, nnodes);
+    this->WriteTimeNumberElements( qsinofs, time, nOut);
   if( qsdinofs.good() )
-    this->WriteTimeNumberElements( qsdinofs, time, nnodes);
+    this->WriteTimeNumberElements( qsdinofs, time, nOut);
   if( dzdtofs.good() )
-    this->WriteTimeNumberElements( dzdtofs, time, nnodes);
+    this->WriteTimeNumberElements( dzdtofs, time, nOut);
   if( upofs.good() )
-    this->WriteTimeNumberElements( upofs, time, nnodes);
+    this->WriteTimeNumberElements( upofs, time, nOut);
   if( permIDofs.good() )
-    this->WriteTimeNumberElements( permIDofs, time, nnodes );
+    this->WriteTimeNumberElements( permIDofs, time, nOut );
   if( lsforceofs.good() ) 
-    this->WriteTimeNumberElements( lsforceofs, time, nnodes );
+    this->WriteTimeNumberElements( lsforceofs, time, nOut );
   if( qsubofs.good() ) 
-    this->WriteTimeNumberElements( qsubofs, time, nnodes ); 
+    this->WriteTimeNumberElements( qsubofs, time, nOut ); 
   if( publicflagofs.good() )
-    this->WriteTimeNumberElements( publicflagofs, time, nnodes );
+    this->WriteTimeNumberElements( publicflagofs, time, nOut );
 
   if(1)//DEBUG
     std::cout << "tLOutput::WriteNodeData 2\n" << std::flush;
@@ -612,6 +692,10 @@ void tLOutput<tSubNode>::WriteNodeData( double time )
   if( qsdinofs.good() ) qsdinofs << std::flush;
   if( upofs.good() ) upofs << std::flush;
   if( dzdtofs.good() ) dzdtofs << std::flush;
+  if( permIDofs.good() ) permIDofs << std::flush;
+  if( lsforceofs.good() ) lsforceofs << std::flush;
+  if( qsubofs.good() ) qsubofs << std::flush;
+  if( publicflagofs.good() ) publicflagofs << std::flush;
 
   if(OptLayOutput) layofs.close();
   if( surfofs.good() )
@@ -629,9 +713,9 @@ void tLOutput<tSubNode>::WriteNodeData( double time )
  **
 \*************************************************************************/
 template< class tSubNode >
-void tLOutput<tSubNode>::WriteTSOutput()
+void tLOutput<tSubNode>::WriteTSOutput( double time )
 {
-  if (TSOutput) TSOutput->WriteTSOutput();
+  if (TSOutput) TSOutput->WriteTSOutput( time );
 }
 
 
@@ -662,7 +746,8 @@ template< class tSubNode >
 tTSOutputImp<tSubNode>::tTSOutputImp( tMesh<tSubNode> *meshPtr,
 				      const tInputFile &infile ) :
   tOutputBase<tSubNode>( meshPtr, infile ),  // call base-class constructor
-  mdLastVolume(0.)
+  mdLastVolume(0.),
+  insitu( infile )
 {
   int opOpt;  // Optional modules: only output stuff when needed
 
@@ -673,6 +758,12 @@ tTSOutputImp<tSubNode>::tTSOutputImp( tMesh<tSubNode> *meshPtr,
   
   
   this->CreateAndOpenFile( &tareaofs, ".tarea" );
+
+  if( insitu.IsActive() )
+  {
+    this->CreateAndOpenFile( &insituofs, ".insitu" );
+    insitu.WriteHeader( insituofs );
+  }
 }
 
 /*************************************************************************\
@@ -683,9 +774,11 @@ tTSOutputImp<tSubNode>::tTSOutputImp( tMesh<tSubNode> *meshPtr,
  **  specified in the input file and which is stored in the data member
  **  baseName.
  **
+ **  Every INSITU_INTERVAL calls, it also runs the in-situ reducers.
+ **
 \*************************************************************************/
 template< class tSubNode >
-void tTSOutputImp<tSubNode>::WriteTSOutput()
+void tTSOutputImp<tSubNode>::WriteTSOutput( double time )
 {
   typename tMesh< tSubNode >::nodeListIter_t niter( this->m->getNodeList() ); // node list iterator
 
@@ -715,6 +808,30 @@ void tTSOutputImp<tSubNode>::WriteTSOutput()
 	cover += cn->getVegCover().getVeg()*cn->getVArea();
       vegcovofs << cover/area << std::endl;
     }
+
+  if( insitu.IsActive() && insitu.IsDue() )
+    WriteInSituOutput( time );
+}
+
+/*************************************************************************\
+ **
+ **  tTSOutputImp::WriteInSituOutput
+ **
+ **  Passes every interior node to the in-situ reducers and writes their
+ **  results as one line of the .insitu file.
+ **
+ **  Created: 10/2026
+\*************************************************************************/
+template< class tSubNode >
+void tTSOutputImp<tSubNode>::WriteInSituOutput( double time )
+{
+  typename tMesh< tSubNode >::nodeListIter_t niter( this->m->getNodeList() );
+
+  insitu.Begin( time );
+  for( tSubNode *cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
+    insitu.AddNode( cn->getPermID(), cn->getZ(), cn->getVArea(),
+                    cn->calcSlope(), cn->getDrArea(), cn->getUplift() );
+  insitu.End( insituofs );
 }
 
 /***********************************************************************\
@@ -727,7 +844,9 @@ template< class tSubNode >
 tStratOutputImp<tSubNode>::tStratOutputImp(tMesh<tSubNode> * meshPtr,
 					   const tInputFile &infile ) :
   tOutputBase<tSubNode>( meshPtr, infile ),  // call base-class constructor
-  stratGrid(0), netPtr(0)
+  stratGrid(0), netPtr(0),
+  binaryStrat( infile.ReadBool( "OPT_STRAT_BINARY", false ) ),
+  strat()
 {
   // Set direction of section
   {
@@ -880,58 +999,18 @@ void tStratOutputImp<tSubNode>::WriteSingleSection(double time,
 template< class tSubNode >
 void tStratOutputImp<tSubNode>::WriteCompleteStratigraphy(double time, int counter_)
 {
-	
-	// Open the file for writing map-view data
-  std::ofstream stratxyzofs;
-  std::ofstream stratofs;
-  std::ofstream lithoofs;
-  std::ofstream channelofs;
-  
-	// File 1, containing the seperate x,y,z locations
-#define MY_EXT ".stratxyz" 
-  char ext[sizeof(MY_EXT)+10];  // name of file to be created
-
-  sprintf( ext, "%s%d", MY_EXT, counter_ );
-#undef MY_EXT
-  this->CreateAndOpenFile( &stratxyzofs, ext );
-  
-  //File 2, containing the full stratigraphic matrix containing archaeology
-#define MY_EXT ".strat" 
-  char extb[sizeof(MY_EXT)+10];  // name of file to be created
-
-  sprintf( extb, "%s%d", MY_EXT, counter_ );
-#undef MY_EXT
-  this->CreateAndOpenFile( &stratofs, extb );
-  
-  
-  //File 3,containing the full stratigraphic matrix containing lithology
-#define MY_EXT ".litho" 
-  char extc[sizeof(MY_EXT)+10];  // name of file to be created
-
-  sprintf( extc, "%s%d", MY_EXT, counter_ );
-#undef MY_EXT
-  this->CreateAndOpenFile( &lithoofs, extc );  
-  
-  
-  //File 4, containing the channel locations
-#define MY_EXT ".channelmap" 
-  char extd[sizeof(MY_EXT)+10];  // name of file to be created
-
-  sprintf( extd, "%s%d", MY_EXT, counter_ );
-#undef MY_EXT
-  this->CreateAndOpenFile( &channelofs, extd );
-	
   const int imax = stratGrid->getImax();
   const int jmax = stratGrid->getJmax();
-  const int numCells = ((imax-2)*(jmax-2));
   tMatrix<tStratNode> const *StratNodeMatrix = stratGrid->getStratNodeMatrix();
   tMatrix<tTriangle*> const *StratConnect = stratGrid->getStratConnect();
-  
-  stratxyzofs<< time << '\n' << numCells << '\n'<< imax-1 << '\n' <<jmax-1 << '\n';
-  stratofs   << time << '\n' << numCells << '\n'<< imax-1 << '\n' <<jmax-1 << '\n';
-  lithoofs   << time << '\n' << numCells << '\n'<< imax-1 << '\n' <<jmax-1 << '\n';
-  channelofs << time << '\n' << numCells << '\n'<< imax-1 << '\n' <<jmax-1 << '\n';
-  
+
+  // Gather the columns into strat, which writes either the binary file
+  // or the four text files (see tStratBinary.h):
+  // .stratxyz, with the x,y,z location of each cell,
+  // .strat and .litho, with the full stratigraphic matrix,
+  // .channelmap, with the locations and drainage areas
+  strat.Clear( time, imax-1, jmax-1 );
+
   // Loop over the inner part of the StratGrid
   int i,j;
   for(j=1;j<jmax-1;j++){
@@ -939,10 +1018,7 @@ void tStratOutputImp<tSubNode>::WriteCompleteStratigraphy(double time, int count
 
       tStratNode const &sn = (*StratNodeMatrix)(i,j);
 
-      // File 1; Write the location of the node to the xyz file
-      stratxyzofs << sn.getX() << ' ' << sn.getY() << ' ' << sn.getZ() << '\n';
-      
-      // File 2; Write loaction and discharge info
+      // Interpolate the discharge value at the cell
       tTriangle *ct =   (*StratConnect)(i,j);									// fetch  Triangle
       const double sx = sn.getX();                						// i,j's  X-value
       const double sy = sn.getY();	        									// i,j's  Y-value
@@ -962,15 +1038,10 @@ void tStratOutputImp<tSubNode>::WriteCompleteStratigraphy(double time, int count
       const double drainage = PlaneFit(sx, sy, lnds[0]->get2DCoords(), lnds[1]->get2DCoords(),
 				     lnds[2]->get2DCoords(), tri_drainage );
 				     
-		  // Write File 2
-		  channelofs << sn.getX() << ' ' << sn.getY() << ' ' << sn.getZ() << ' '<< drainage/1000.0 <<'\n';		     
-				     
+      strat.AddColumn( sn.getX(), sn.getY(), sn.getZ(), drainage/1000.0 );
       
-      // Get the number of layers present at this stratnode location
+      // Add the layers present at this stratnode location
       const int numlayers = sn.getNumLayer();
-      stratofs << numlayers-1 << '\n';
-      lithoofs << numlayers-1 << '\n';
-      
       int l=1;
       while(l<numlayers){
         const double thickness = sn.getLayerDepth(l);
@@ -980,29 +1051,26 @@ void tStratOutputImp<tSubNode>::WriteCompleteStratigraphy(double time, int count
         //facies  = sn.getLayerFacies(l);
         //const double paleocurrent = sn.getPaleoCurrent(l);
 
-        stratofs << thickness << ' ' << texture<< ' '
-	       << lasttime << ' ' << depotime << '\n';
-	       
-	      lithoofs << thickness << ' ' << texture<< ' '
-	       << lasttime << ' ' << depotime << '\n';
-      
-
+        strat.AddLayer( thickness, texture, lasttime, depotime );
 
         l++;   // increment, loop down the layer list.
       }
       
     } //-i
   } //-j
-  
-  //stratxyzofs << flush;
-  //stratofs << flush;
-  
-  stratxyzofs.close();
-  stratofs.close();
-  lithoofs.close();
-  channelofs.close();
-  
- 
+
+  bool written;
+  if( binaryStrat ) {
+    char ext[sizeof(".stratbin")+10];
+    sprintf( ext, ".stratbin%d", counter_ );
+    written = strat.Write( ( std::string( this->baseName ) + ext ).c_str() );
+  }
+  else
+    written = strat.WriteText( this->baseName, counter_ );
+  if( !written )
+    ReportFatalError(
+		     "I can't create files for output. Storage space may be exhausted.");
+
   std::cout << "Output::Finished writing complete subsurface stratigraphy file...\n";
 
 } // end writing complete stratigraphy
@@ -31,6 +31,9 @@
  **    - 7/03: AD added tOutputBase and tTSOutputImp
  **    - 8/03: AD Random number generator handling
  **    - 8/10: SL added forestofs for output of forest/trees
+ **    - 10/26: mesh and node-field files written through tFieldOStream,
+ **      which compresses them with OPT_COMPRESS_OUTPUT
+ **    - 10/26: per-file output intervals and node mask (tOutputSelection)
  **
  **  $Id: tOutput.h,v 1.59 2008-07-07 16:18:58 childcvs Exp $
  */
@@ -43,6 +46,8 @@
 #include "../MeshElements/meshElements.h"
 #include "../tInputFile/tInputFile.h"
 #include "../tMesh/tMesh.h"
+#include "../tFieldCodec/tFieldCodec.h"
+#include "../tOutputSelection/tOutputSelection.h"
 class tStratGrid;
 class tFloodplain;
 class tStreamNet;
@@ -71,10 +76,14 @@ protected:
   enum{ kMaxNameSize = 80 };
   tMesh<tSubNode> * m;          // ptr to mesh (for access to nodes, etc)
   char baseName[kMaxNameSize];  // name of output files
+  bool compressOutput;          // OPT_COMPRESS_OUTPUT (see tFieldCodec)
+  tOutputSelection selection;   // OUTPUT_INTERVALS and OUTPUT_MASK
 
   void CreateAndOpenFile( std::ofstream * theOFStream, const char * extension ) const;
+  void CreateAndOpenFile( tFieldOStream * theStream, const char * extension ) const;
   // write time/number of element
   static void WriteTimeNumberElements( std::ofstream &, double, int );
+  static void WriteTimeNumberElements( tFieldOStream &, double, int );
 };
 
 /**************************************************************************/
@@ -104,11 +113,11 @@ public:
   void WriteOutput( double time );
 
 private:
-  std::ofstream nodeofs;             // output file for node data
-  std::ofstream edgofs;              // output file for edge data
-  std::ofstream triofs;              // output file for triangle data
-  std::ofstream zofs;                // output file for node "z" data
-  std::ofstream vaofs;               // output file for Voronoi areas
+  tFieldOStream nodeofs;             // output file for node data
+  tFieldOStream edgofs;              // output file for edge data
+  tFieldOStream triofs;              // output file for triangle data
+  tFieldOStream zofs;                // output file for node "z" data
+  tFieldOStream vaofs;               // output file for Voronoi areas
 
 protected:
   bool CanonicalNumbering;      // Output in canonical order
@@ -188,7 +197,7 @@ class tLOutput : public tOutput<tSubNode>
 public:
   tLOutput( tMesh<tSubNode> * meshPtr, const tInputFile &infile, tRand * );
    virtual ~tLOutput();
-   void WriteTSOutput();
+   void WriteTSOutput( double time );
    bool OptTSOutput() const;
   bool OptLayOutput; //nmg added 11/06, for writing layer information
   bool OptNewLayOutput; // stl added 8/10 for writing bulk density
@@ -199,29 +208,30 @@ protected:
    virtual void WriteNodeData( double time );
 private:
    std::ofstream randomofs;  // Random number generator state
-   std::ofstream drareaofs;  // Drainage areas
-   std::ofstream netofs;     // Downstream neighbor IDs
-   std::ofstream slpofs;     // Slopes in the direction of flow
-   std::ofstream qofs;       // Discharge (surface)
-   std::ofstream pofs;       // Precipitation
+   tFieldOStream drareaofs;  // Drainage areas
+   tFieldOStream netofs;     // Downstream neighbor IDs
+   tFieldOStream slpofs;     // Slopes in the direction of flow
+   tFieldOStream qofs;       // Discharge (surface)
+   tFieldOStream pofs;       // Precipitation
    std::ofstream layofs;     // Layer info
    std::ofstream surfofs;    // Surfer style x,y,z file with top layer properties in columns of triangular nodes
-   std::ofstream texofs;     // Texture info
-   std::ofstream vegofs;     // Vegetation cover %
-  std::ofstream forestofs;  // forest variables
-   std::ofstream flowdepofs; // Flow depth
-   std::ofstream chanwidthofs; // Channel width
-   std::ofstream flowpathlenofs;  // Flow path length
-   std::ofstream tauofs;     // Shear stress
-   std::ofstream qsofs;      // Sed flux
-   std::ofstream upofs;      // Uplift rate
-   std::ofstream qsinofs;   // incoming sediment flux
-   std::ofstream qsdinofs;   // incoming sediment flux
-   std::ofstream dzdtofs;    // fluvial erosion rate at a point 
-   std::ofstream permIDofs;  // File with permanent ID numbers
-  std::ofstream lsforceofs; // net downslope force for landsliding
-  std::ofstream qsubofs; // subsurface discharge
-  std::ofstream publicflagofs; // public flag used in landsliding (or whatever)
+   tFieldOStream texofs;     // Texture info
+   tFieldOStream vegofs;     // Vegetation cover %
+  tFieldOStream forestofs;  // forest variables
+   tFieldOStream flowdepofs; // Flow depth
+   tFieldOStream chanwidthofs; // Channel width
+   tFieldOStream flowpathlenofs;  // Flow path length
+   tFieldOStream tauofs;     // Shear stress
+   tFieldOStream qsofs;      // Sed flux
+   tFieldOStream upofs;      // Uplift rate
+   tFieldOStream qsinofs;   // incoming sediment flux
+   tFieldOStream qsdinofs;   // incoming sediment flux
+   tFieldOStream dzdtofs;    // fluvial erosion rate at a point 
+   tFieldOStream permIDofs;  // File with permanent ID numbers
+  tFieldOStream lsforceofs; // net downslope force for landsliding
+  tFieldOStream qsubofs; // subsurface discharge
+  tFieldOStream publicflagofs; // public flag used in landsliding (or whatever)
+  tFieldOStream maskofs;    // IDs of the nodes in OUTPUT_MASK
 
   tTSOutputImp<tSubNode> *TSOutput;  // Time Series output
   tStratOutputImp<tSubNode> *stratOutput;
@@ -229,7 +239,10 @@ private:
 
   int counter;
   bool Surfer; // Output for Surfer Graphic Package
+  std::vector<char> inMask; // by node ID, with OUTPUT_MASK; else empty
 
+  bool InMask( tSubNode const *cn ) const
+  { return inMask.empty() || inMask[cn->getID()]; }
   inline void WriteActiveNodeData( tSubNode * );
   inline void WriteAllNodeData( tSubNode * );
 };
@@ -258,6 +271,8 @@ private:
 //   that's one thing when there are only a few layers, but with chemical
 //   weathering, there will be about 200 layers; replaced with list iterator,
 //   accessed through the recently added tLNode::getLayersRefNC().
+//   (Now read through tLNode::getLayersRef(), so that writing output
+//   does not unshare layer lists; see tSharedList. 10/2026)
 // - Added output of new tLayer::bulkDensity; just put it on the line
 //   after erodibility; hope that doesn't screw up too many Matlab functions.
 
@@ -278,17 +293,21 @@ inline void tLOutput<tSubNode>::WriteActiveNodeData( tSubNode *cn )
 	      << cn->getLayerCtime(i) << ' ' << cn->getLayerRtime(i) << '\n';
   }
 
-  pofs << cn->getPreci() << '\n';
-  drareaofs << cn->getDrArea() << '\n';
-  if( cn->getDownstrmNbr() )
-    netofs << cn->getDownstrmNbr()->getID() << '\n';
+  if( InMask( cn ) )
+    {
+      pofs << cn->getPreci() << '\n';
+      drareaofs << cn->getDrArea() << '\n';
+      if( cn->getDownstrmNbr() )
+	netofs << cn->getDownstrmNbr()->getID() << '\n';
+    }
 
   if(OptLayOutput){
     layofs << ' ' << cn->getNumLayer() << '\n';
     // write out data for each layer:
-    tListIter< tLayer > lI( cn->getLayersRefNC() );
-    for( tLayer *lP=lI.FirstP(); !lI.AtEnd(); lP=lI.NextP() )
+    for( tListNodeBasic< tLayer > const *ln =
+	   cn->getLayersRef().getFirst(); ln != 0; ln = ln->getNext() )
       {
+	tLayer const *lP = ln->getDataPtr();
 	layofs << lP->getCtime() << ' ' << lP->getRtime() << ' '
 	       << lP->getEtime() << '\n'
 	       << lP->getDepth() << ' ' << lP->getErody() << ' ';
@@ -322,6 +341,8 @@ inline void tLOutput<tSubNode>::WriteAllNodeData( tSubNode *cn )
   if(0) //DEBUG
     std::cout << "WriteAllNodeData for node " << cn->getPermID() << std::endl;
   
+  if( !InMask( cn ) )
+    return;
   
   slpofs << (cn->getBoundaryFlag() == kNonBoundary ? cn->calcSlope():0.) << '\n';
 
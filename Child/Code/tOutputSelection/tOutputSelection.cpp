@@ -0,0 +1,139 @@
+/***************************************************************************/
+/**
+**  @file tOutputSelection.cpp
+**  @brief Functions for tOutputSelection (see tOutputSelection.h).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#include <iostream>
+#include <sstream>
+
+#include "tOutputSelection.h"
+#include "../errors/errors.h"
+
+/**************************************************************************\
+**
+**  tOutputSelection constructor
+**
+**  Reads OUTPUT_INTERVALS and OUTPUT_MASK, if present.
+**
+\**************************************************************************/
+tOutputSelection::tOutputSelection( const tInputFile &infile ) :
+  intervals(), maskX(), maskY()
+{
+  if( infile.Contain( "OUTPUT_INTERVALS" ) )
+  {
+    std::string list = infile.ReadString( "OUTPUT_INTERVALS" );
+    for( size_t i=0; i<list.size(); ++i )
+      if( list[i] == ',' ) list[i] = ' ';
+    std::istringstream items( list );
+    std::string extension;
+    while( items >> extension )
+    {
+      tInterval interval;
+      if( !( items >> interval.every ) || interval.every < 0 )
+      {
+        std::cerr << "OUTPUT_INTERVALS: '" << extension
+                  << "' must be followed by a number of outputs (0 or more).\n";
+        ReportFatalError( "Bad entry in OUTPUT_INTERVALS." );
+      }
+      if( extension[0] == '.' )
+        extension.erase( 0, 1 );
+      interval.used = false;
+      intervals[extension] = interval;
+    }
+  }
+
+  if( infile.Contain( "OUTPUT_MASK" ) )
+  {
+    std::istringstream items( infile.ReadString( "OUTPUT_MASK" ) );
+    std::vector< double > xy;
+    double value;
+    while( items >> value )
+      xy.push_back( value );
+    if( !items.eof() || xy.size() % 2 != 0 || xy.size() == 2 ||
+        xy.size() == 0 )
+      ReportFatalError( "OUTPUT_MASK must be a box (xmin ymin xmax ymax) "
+                        "or a polygon of three or more x y vertices." );
+    if( xy.size() == 4 )
+    {
+      const double xmin = xy[0], ymin = xy[1], xmax = xy[2], ymax = xy[3];
+      if( xmin >= xmax || ymin >= ymax )
+        ReportFatalError( "OUTPUT_MASK box must be xmin ymin xmax ymax." );
+      maskX.push_back( xmin ); maskY.push_back( ymin );
+      maskX.push_back( xmax ); maskY.push_back( ymin );
+      maskX.push_back( xmax ); maskY.push_back( ymax );
+      maskX.push_back( xmin ); maskY.push_back( ymax );
+    }
+    else
+      for( size_t i=0; i<xy.size(); i+=2 )
+      {
+        maskX.push_back( xy[i] );
+        maskY.push_back( xy[i+1] );
+      }
+  }
+}
+
+/**************************************************************************\
+**
+**  tOutputSelection::getInterval
+**
+**  Returns how often (in outputs) to write the file with the given
+**  extension, e.g. ".q": 1 unless it is listed in OUTPUT_INTERVALS.
+**
+\**************************************************************************/
+int tOutputSelection::getInterval( const char *extension ) const
+{
+  if( extension[0] == '.' )
+    ++extension;
+  std::map< std::string, tInterval >::const_iterator i =
+    intervals.find( extension );
+  if( i == intervals.end() )
+    return 1;
+  i->second.used = true;
+  return i->second.every;
+}
+
+/**************************************************************************\
+**
+**  tOutputSelection::ReportUnused
+**
+**  Warns of extensions in OUTPUT_INTERVALS for which no file has been
+**  opened, usually a misspelling or a file that the options chosen do
+**  not write.
+**
+\**************************************************************************/
+void tOutputSelection::ReportUnused() const
+{
+  std::map< std::string, tInterval >::const_iterator i;
+  for( i = intervals.begin(); i != intervals.end(); ++i )
+    if( !i->second.used )
+    {
+      std::cerr << "OUTPUT_INTERVALS: no output file ." << i->first
+                << " is written in this run.\n";
+      ReportWarning( "Unused entry in OUTPUT_INTERVALS." );
+    }
+}
+
+/**************************************************************************\
+**
+**  tOutputSelection::InMask
+**
+**  Tells whether (x,y) is inside the mask (even-odd rule; a box is
+**  treated as a polygon of four vertices). Always true without a mask.
+**
+\**************************************************************************/
+bool tOutputSelection::InMask( double x, double y ) const
+{
+  if( maskX.empty() ) return true;
+  bool inside = false;
+  const size_t n = maskX.size();
+  for( size_t i=0, j=n-1; i<n; j=i++ )
+    if( ( maskY[i] > y ) != ( maskY[j] > y ) &&
+        x < ( maskX[j] - maskX[i] ) * ( y - maskY[i] ) /
+            ( maskY[j] - maskY[i] ) + maskX[i] )
+      inside = !inside;
+  return inside;
+}
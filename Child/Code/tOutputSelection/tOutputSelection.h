@@ -0,0 +1,61 @@
+//-*-c++-*-
+
+/***************************************************************************/
+/**
+**  @file tOutputSelection.h
+**  @brief Header for tOutputSelection, which says which of the mesh and
+**         node-field files are written at each output time, and for
+**         which nodes.
+**
+**  By default every file is written at every output time, for every
+**  node. Two optional input items change this:
+**
+**  OUTPUT_INTERVALS lists pairs of a file extension (without the dot)
+**  and a number n, separated by spaces or commas, e.g. "q 5, tx 0, tau 0":
+**  the file is then written at every n-th output time only, starting
+**  with the first, or not at all if n is 0. Files not listed are
+**  written every time.
+**
+**  OUTPUT_MASK restricts the node-field files written by tLOutput (not
+**  the mesh files) to the nodes inside a box, given as "xmin ymin xmax
+**  ymax", or inside a polygon, given as three or more "x y" vertices.
+**  The IDs of the nodes written are then written to <name>.maskid.
+**
+**  The output classes ask for the interval of each file as they open it
+**  (see tFieldOStream::setInterval), and for each node whether it is
+**  inside the mask.
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#ifndef TOUTPUTSELECTION_H
+#define TOUTPUTSELECTION_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "../tInputFile/tInputFile.h"
+
+class tOutputSelection
+{
+public:
+  explicit tOutputSelection( const tInputFile & );
+
+  int getInterval( const char *extension ) const;
+  void ReportUnused() const;
+
+  bool HasMask() const { return !maskX.empty(); }
+  bool InMask( double x, double y ) const;
+
+private:
+  struct tInterval
+  {
+    int every;          // write every n-th output; 0 = never
+    mutable bool used;  // some output file has this extension
+  };
+  std::map< std::string, tInterval > intervals;  // by extension, no dot
+  std::vector< double > maskX, maskY;  // polygon vertices (box: 4 corners)
+};
+
+#endif
@@ -0,0 +1,108 @@
+/**************************************************************************/
+/**
+**  tOutputSelection_test.cpp: checks the output intervals and masks read
+**  by tOutputSelection, and that tFieldOStream keeps only every n-th
+**  output when given an interval.
+**
+**  Created 10/2026
+*/
+/**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../tOutputSelection.h"
+#include "../../tFieldCodec/tFieldCodec.h"
+
+#define CHECK(name, cond) { \
+  fprintf (stdout, "\033[32m%s... \033[39m", name); \
+  if (cond) \
+    fprintf (stdout, "\033[32mPASS\033[39m\n"); \
+  else { \
+    fprintf (stdout, "\033[31mFAIL\033[39m\n"); \
+    exit (EXIT_FAILURE); \
+  } \
+}
+
+static void
+WriteInputFile (const char *fileName, const char *intervals,
+                const char *mask)
+{
+  std::ofstream ofs (fileName);
+
+  ofs << "OUTFILENAME: name of the run\nsel_test\n";
+  if (intervals)
+    ofs << "OUTPUT_INTERVALS: files written less often\n" << intervals << '\n';
+  if (mask)
+    ofs << "OUTPUT_MASK: nodes written\n" << mask << '\n';
+}
+
+/* Writes outputs 0 to nOutputs-1, each a single line holding its number,
+   with the given interval, and returns the text written. */
+static std::string
+WriteOutputs (int interval, int nOutputs)
+{
+  tFieldOStream ofs;
+  std::ostringstream contents;
+  int i;
+
+  ofs.open ("sel_test.q", false);
+  ofs.setInterval (interval);
+  for (i=0; i<nOutputs; ++i)
+    ofs << i << '\n' << std::flush;
+  ofs.close ();
+
+  std::ifstream ifs ("sel_test.q");
+  contents << ifs.rdbuf ();
+  return contents.str ();
+}
+
+int
+main (void)
+{
+  {
+    WriteInputFile ("sel_test_none.in", 0, 0);
+    tInputFile infile ("sel_test_none.in");
+    tOutputSelection selection (infile);
+
+    CHECK ("Default interval", selection.getInterval (".z") == 1);
+    CHECK ("No mask", !selection.HasMask () && selection.InMask (1e9, -1e9));
+  }
+
+  {
+    WriteInputFile ("sel_test_box.in", "q 2, .tx 0  tau,3",
+                    "0 0 10 5");
+    tInputFile infile ("sel_test_box.in");
+    tOutputSelection selection (infile);
+
+    CHECK ("Intervals", selection.getInterval (".q") == 2
+           && selection.getInterval ("tx") == 0
+           && selection.getInterval (".tau") == 3
+           && selection.getInterval (".z") == 1);
+    CHECK ("Box mask", selection.HasMask ()
+           && selection.InMask (5., 2.5) && selection.InMask (0.1, 4.9)
+           && !selection.InMask (-0.1, 2.5) && !selection.InMask (5., 5.1)
+           && !selection.InMask (10.1, 1.));
+  }
+
+  {
+    /* a triangle with its right angle at the origin */
+    WriteInputFile ("sel_test_poly.in", 0, "0 0  10 0  0 10");
+    tInputFile infile ("sel_test_poly.in");
+    tOutputSelection selection (infile);
+
+    CHECK ("Polygon mask", selection.InMask (1., 1.)
+           && selection.InMask (4.9, 4.9) && !selection.InMask (5.1, 5.1)
+           && !selection.InMask (-1., 1.) && !selection.InMask (1., -1.));
+  }
+
+  CHECK ("Every output", WriteOutputs (1, 5) == "0\n1\n2\n3\n4\n");
+  CHECK ("Every 2nd output", WriteOutputs (2, 5) == "0\n2\n4\n");
+  CHECK ("Every 3rd output", WriteOutputs (3, 7) == "0\n3\n6\n");
+  CHECK ("No output", WriteOutputs (0, 5) == "");
+
+  return EXIT_SUCCESS;
+}
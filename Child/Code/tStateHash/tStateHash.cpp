@@ -0,0 +1,237 @@
+/***************************************************************************/
+/**
+**  @file tStateHash.cpp
+**  @brief Functions for tStateHash and tStateHashLog (see tStateHash.h).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string.h>
+
+#include "tStateHash.h"
+#include "../errors/errors.h"
+
+namespace
+{
+  inline unsigned Rotl( unsigned x, int r )
+  {
+    return ( x << r ) | ( x >> ( 32 - r ) );
+  }
+
+  // MurmurHash3 step for one 32-bit word
+  inline unsigned Mix( unsigned h, unsigned k )
+  {
+    k *= 0xcc9e2d51u;
+    k = Rotl( k, 15 );
+    k *= 0x1b873593u;
+    h ^= k;
+    h = Rotl( h, 13 );
+    return h * 5 + 0xe6546b64u;
+  }
+
+  // MurmurHash3 finalizer
+  inline unsigned Finish( unsigned h, unsigned n )
+  {
+    h ^= n * 4;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+  }
+
+  // fields of a line of a .hash file
+  void Split( std::string const &line, std::vector< std::string > &fields )
+  {
+    std::istringstream items( line );
+    std::string field;
+    while( items >> field )
+      fields.push_back( field );
+  }
+}
+
+/**************************************************************************\
+**
+**  tStateHash functions
+**
+\**************************************************************************/
+tStateHash::tStateHash() :
+  h1( 0x9747b28cu ), h2( 0x3c6ef372u ), nWords( 0 )
+{}
+
+void tStateHash::Add( unsigned word )
+{
+  h1 = Mix( h1, word );
+  h2 = Mix( h2, word ^ 0x5bd1e995u );
+  ++nWords;
+}
+
+void tStateHash::Add( long value )
+{
+  Add( static_cast< unsigned >( value ) );
+  Add( static_cast< unsigned >( ( value >> 16 ) >> 16 ) );
+}
+
+void tStateHash::Add( double value )
+{
+  unsigned words[2];
+  memcpy( words, &value, sizeof(words) );
+  Add( words[0] );
+  Add( words[1] );
+}
+
+void tStateHash::Add( std::vector< double > const &values )
+{
+  for( size_t i=0; i<values.size(); ++i )
+    Add( values[i] );
+}
+
+std::string tStateHash::Digest() const
+{
+  std::ostringstream digest;
+  digest << std::hex << std::setfill( '0' )
+         << std::setw( 8 ) << Finish( h1, nWords )
+         << std::setw( 8 ) << Finish( h2, nWords );
+  return digest.str();
+}
+
+/**************************************************************************\
+**
+**  tStateHashLog::Requested
+**
+**  Tells whether the input file asks for state hashes, i.e. whether it
+**  has STATE_HASH_INTERVAL greater than 0.
+**
+\**************************************************************************/
+bool tStateHashLog::Requested( const tInputFile &infile )
+{
+  return infile.Contain( "STATE_HASH_INTERVAL" ) &&
+    infile.ReadInt( "STATE_HASH_INTERVAL" ) > 0;
+}
+
+/**************************************************************************\
+**
+**  tStateHashLog constructor
+**
+**  Reads STATE_HASH_INTERVAL and STATE_HASH_GOLDEN, reads in the golden
+**  file, if any, and opens <name>.hash. The golden file is read first,
+**  so that it may be the .hash file that this run is to write.
+**
+\**************************************************************************/
+tStateHashLog::tStateHashLog( const tInputFile &infile ) :
+  interval( infile.ReadInt( "STATE_HASH_INTERVAL" ) ),
+  nextGolden( 0 )
+{
+  if( interval <= 0 )
+    ReportFatalError( "STATE_HASH_INTERVAL must be 1 or more." );
+
+  if( infile.Contain( "STATE_HASH_GOLDEN" ) )
+  {
+    goldenName = infile.ReadString( "STATE_HASH_GOLDEN" );
+    std::ifstream goldenifs( goldenName.c_str() );
+    if( !goldenifs.good() )
+    {
+      std::cerr << "STATE_HASH_GOLDEN: cannot open '" << goldenName << "'\n";
+      ReportFatalError( "Cannot open the golden state hash file." );
+    }
+    std::string line;
+    while( std::getline( goldenifs, line ) )
+      if( !line.empty() && line[0] != '#' )
+        golden.push_back( line );
+  }
+
+  const std::string name = infile.ReadString( "OUTFILENAME" ) + ".hash";
+  logofs.open( name.c_str() );
+  if( !logofs.good() )
+    ReportFatalError( "Unable to open state hash file." );
+  logofs << "# storm time phase";
+  for( int p=0; p<kNumParts; ++p )
+    logofs << ' ' << PartName( static_cast< tPart_t >( p ) );
+  logofs << '\n';
+}
+
+const char *tStateHashLog::PartName( tPart_t p )
+{
+  switch( p )
+  {
+    case kCoords: return "coords";
+    case kElevation: return "elevation";
+    case kFlow: return "flow";
+    case kLayers: return "layers";
+    case kRand: return "rng";
+    default: break;
+  }
+  return "?";
+}
+
+/**************************************************************************\
+**
+**  tStateHashLog::Record
+**
+**  Writes the line for one checkpoint and, with a golden file, compares
+**  it with the next line of that file. The run stops at the first line
+**  which differs: if the storm or phase differs, the two runs did not
+**  take the same checkpoints (different STATE_HASH_INTERVAL or options);
+**  otherwise the time or the parts of the state which differ are named.
+**  A golden file shorter than the run is warned of once, after which no
+**  more lines are compared.
+**
+\**************************************************************************/
+void tStateHashLog::Record( long storm, double time, const char *phase,
+                            tStateHash const digests[kNumParts] )
+{
+  std::ostringstream line;
+  line << storm << ' ' << std::setprecision( 17 ) << time << ' ' << phase;
+  for( int p=0; p<kNumParts; ++p )
+    line << ' ' << digests[p].Digest();
+  logofs << line.str() << std::endl;
+
+  if( nextGolden > golden.size() )
+    return;
+  if( nextGolden == golden.size() )
+  {
+    if( !goldenName.empty() )
+    {
+      std::cerr << "STATE_HASH_GOLDEN: '" << goldenName
+                << "' ends before storm " << storm << ", " << phase << '\n';
+      ReportWarning( "No more state hashes to compare with." );
+    }
+    ++nextGolden;
+    return;
+  }
+
+  std::vector< std::string > ours, theirs;
+  Split( line.str(), ours );
+  Split( golden[nextGolden++], theirs );
+  if( theirs.size() != ours.size() ||
+      theirs[0] != ours[0] || theirs[2] != ours[2] )
+  {
+    std::cerr << "STATE_HASH_GOLDEN: checkpoint at storm " << storm << ", "
+              << phase << " is '" << golden[nextGolden-1] << "' in '"
+              << goldenName << "'\n";
+    ReportFatalError( "State hash checkpoints differ from the golden file "
+                      "(different STATE_HASH_INTERVAL or options?)." );
+  }
+
+  std::string differ;
+  if( theirs[1] != ours[1] )
+    differ = "time";
+  for( int p=0; p<kNumParts; ++p )
+    if( theirs[3+p] != ours[3+p] )
+    {
+      if( !differ.empty() ) differ += ", ";
+      differ += PartName( static_cast< tPart_t >( p ) );
+    }
+  if( !differ.empty() )
+  {
+    std::cerr << "STATE_HASH_GOLDEN: state differs from '" << goldenName
+              << "' at storm " << storm << ", " << phase << " (time "
+              << std::setprecision( 17 ) << time << "): " << differ << '\n';
+    ReportFatalError( "State differs from the golden state hash file." );
+  }
+}
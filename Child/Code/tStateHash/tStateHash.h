@@ -0,0 +1,115 @@
+//-*-c++-*-
+
+/***************************************************************************/
+/**
+**  @file tStateHash.h
+**  @brief Header for tStateHash, a digest of part of the model state, and
+**         tStateHashLog, which records the digests of a run at fixed
+**         points and, optionally, checks them against an earlier run.
+**
+**  Comparing the text output of two runs tells whether they agree only
+**  to the precision of the text, and takes a while for a large mesh.
+**  With STATE_HASH_INTERVAL n > 0, childInterface instead takes a 64-bit
+**  digest of each of
+**
+**    - coords:    the x, y and boundary code of each node;
+**    - elevation: the elevation of each node;
+**    - flow:      the downstream neighbour, drainage area and discharge
+**                 of each active node;
+**    - layers:    the layer stack of each node (see tLayer::Pack);
+**    - rng:       the state of the model's random number generator;
+**
+**  with the nodes in order of permanent ID, before the first storm
+**  ("initial") and then at every n-th storm after each of its phases
+**  ("storm", "hydrology", "hillslope", "fluvial", "channels", "mesh",
+**  "uplift" and "compaction", the mesh and compaction phases only with
+**  the options that have them; see childInterface::RunOneStorm), and
+**  writes them to <name>.hash, one line per phase. Every number is
+**  hashed bit for bit, so two runs give the same digests only if they
+**  hold exactly the same state, on a machine of the same byte order.
+**
+**  With STATE_HASH_GOLDEN set to the .hash file of an earlier run, each
+**  line is also checked against the same line of that file, and the run
+**  stops at the first which differs, naming the storm, the phase and the
+**  parts of the state which differ.
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#ifndef TSTATEHASH_H
+#define TSTATEHASH_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../tInputFile/tInputFile.h"
+
+/**************************************************************************/
+/**
+** @class tStateHash
+**
+** Streaming hash of a sequence of numbers: two 32-bit MurmurHash3 lanes
+** with different seeds, which together make a 64-bit digest. The digest
+** depends on the order in which the numbers are added.
+*/
+/**************************************************************************/
+class tStateHash
+{
+public:
+  tStateHash();
+
+  void Add( unsigned );
+  void Add( int value ) { Add( static_cast< unsigned >( value ) ); }
+  void Add( long );     // as two words, so the same for 32 and 64-bit long
+  void Add( double );   // bit for bit, as two words
+  void Add( std::vector< double > const & );
+
+  std::string Digest() const;   // 16 hex digits
+
+private:
+  unsigned h1, h2;      // the two lanes
+  unsigned nWords;      // words added (mod 2^32)
+};
+
+/**************************************************************************/
+/**
+** @class tStateHashLog
+**
+** Writes the digests taken at each checkpoint to <name>.hash and, with a
+** golden file, compares them with those of the earlier run.
+*/
+/**************************************************************************/
+class tStateHashLog
+{
+  tStateHashLog( const tStateHashLog & );
+  tStateHashLog &operator=( const tStateHashLog & );
+public:
+  // parts of the state digested separately
+  typedef enum {
+    kCoords = 0,
+    kElevation,
+    kFlow,
+    kLayers,
+    kRand,
+    kNumParts
+  } tPart_t;
+
+  explicit tStateHashLog( const tInputFile & );
+
+  static bool Requested( const tInputFile & );  // STATE_HASH_INTERVAL > 0
+  static const char *PartName( tPart_t );
+
+  bool Due( long storm ) const { return storm % interval == 0; }
+  void Record( long storm, double time, const char *phase,
+               tStateHash const digests[kNumParts] );
+
+private:
+  int interval;                       // checkpoint every n-th storm
+  std::ofstream logofs;               // <name>.hash
+  std::string goldenName;
+  std::vector< std::string > golden;  // lines of the golden file
+  size_t nextGolden;                  // next line of it to compare
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**************************************************************************/
+/**
+**  tStateHash_test.cpp: takes the digests of a small made-up model state
+**  at a few checkpoints, as childInterface does, and checks them against
+**  a golden .hash file (state_hash_golden.hash), so that a change to the
+**  hash, or to the format of the .hash file, is caught.
+**
+**  Usage: tStateHash_test <golden file> [differ]
+**
+**  With "differ", one elevation is changed by the smallest amount a
+**  double allows, which the comparison with the golden file must report
+**  as a fatal error naming the elevation (the test then expects its
+**  message).
+**
+**  The state is made with exact arithmetic only, so the golden file
+**  holds for any machine of the same (little-endian) byte order.
+**
+**  Created 10/2026
+*/
+/**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../tStateHash.h"
+
+#define CHECK(name, cond) { \
+  fprintf (stdout, "\033[32m%s... \033[39m", name); \
+  if (cond) \
+    fprintf (stdout, "\033[32mPASS\033[39m\n"); \
+  else { \
+    fprintf (stdout, "\033[31mFAIL\033[39m\n"); \
+    exit (EXIT_FAILURE); \
+  } \
+}
+
+static const int kSide = 8;   /* nodes on a side of the grid */
+
+/* Digests of the state of a kSide x kSide grid of nodes after the given
+   storm, in the order of tStateHashLog::tPart_t. */
+static void
+TakeDigests (long storm, bool perturb, tStateHash digests[])
+{
+  std::vector< double > layer (3);
+  int i, j;
+
+  for (j=0; j<kSide; ++j)
+    for (i=0; i<kSide; ++i) {
+      const int id = j*kSide + i;
+      const bool boundary = i==0 || j==0 || i==kSide-1 || j==kSide-1;
+      double z = 0.25*i + 0.125*j - 0.0625*storm*(i%3);
+
+      if (perturb && storm==2 && id==27)
+        z += z * 2.220446049250313e-16;
+      digests[tStateHashLog::kCoords].Add (100.*i + 50.*(j%2));
+      digests[tStateHashLog::kCoords].Add (86.5*j);
+      digests[tStateHashLog::kCoords].Add (boundary ? 2 : 0);
+      digests[tStateHashLog::kElevation].Add (z);
+      if (!boundary) {
+        digests[tStateHashLog::kFlow].Add (id - 1);
+        digests[tStateHashLog::kFlow].Add (1e4 * (i+1));
+        digests[tStateHashLog::kFlow].Add (0.5 * (i+1) * (storm+1));
+      }
+      layer[0] = 1. + 0.5*storm;     /* thickness, time, texture */
+      layer[1] = -1024. * storm;
+      layer[2] = 0.75;
+      digests[tStateHashLog::kLayers].Add (layer);
+    }
+  digests[tStateHashLog::kRand].Add (-1234567L - storm);
+}
+
+static void
+Checkpoint (tStateHashLog &log, long storm, double time, const char *phase,
+            bool perturb)
+{
+  tStateHash digests[tStateHashLog::kNumParts];
+
+  TakeDigests (storm, perturb, digests);
+  log.Record (storm, time, phase, digests);
+}
+
+int
+main (int argc, char *argv[])
+{
+  bool perturb;
+
+  if (argc < 2) {
+    fprintf (stderr, "ERROR: Incorrect number of arguments (%d).\n", argc);
+    exit (EXIT_FAILURE);
+  }
+  perturb = argc > 2 && strcmp (argv[2], "differ") == 0;
+
+  {
+    tStateHash a, b, c, empty;
+
+    a.Add (1.5); a.Add (2.5);
+    b.Add (1.5); b.Add (2.5);
+    c.Add (2.5); c.Add (1.5);
+    CHECK ("Digest length", a.Digest ().size () == 16);
+    CHECK ("Same values, same digest", a.Digest () == b.Digest ());
+    CHECK ("Order matters", a.Digest () != c.Digest ());
+    CHECK ("Empty differs", a.Digest () != empty.Digest ());
+  }
+
+  {
+    std::ofstream ofs ("state_test.in");
+    ofs << "OUTFILENAME: name of the run\nstate_test\n"
+        << "STATE_HASH_INTERVAL: storms between checkpoints\n1\n"
+        << "STATE_HASH_GOLDEN: digests of an earlier run\n" << argv[1] << '\n';
+  }
+  tInputFile infile ("state_test.in");
+  CHECK ("Requested", tStateHashLog::Requested (infile));
+
+  tStateHashLog log (infile);
+  Checkpoint (log, 0, 0., "initial", perturb);
+  for (long storm=1; storm<=3; ++storm) {
+    Checkpoint (log, storm, 0.125*storm, "storm", perturb);
+    Checkpoint (log, storm, 0.125*storm, "fluvial", perturb);
+  }
+  if (perturb) {
+    fprintf (stdout, "A changed elevation went unnoticed\n");
+    return EXIT_FAILURE;
+  }
+  CHECK ("Matches golden file", true);
+
+  return EXIT_SUCCESS;
+}
@@ -167,7 +167,10 @@ tStorm::tStorm( const tInputFile &infile, tRand *rand_,
 
 
 tStorm::tStorm( const tStorm& orig )
-   :  stormfile(),
+   :  optOroPrecip(orig.optOroPrecip),
+      optSpatialPrecip(orig.optSpatialPrecip),
+      miStormType(orig.miStormType),
+      stormfile(),
       rand(orig.rand),
       p_ts(orig.p_ts),
       stdur_ts(orig.stdur_ts),
@@ -176,7 +179,22 @@ tStorm::tStorm( const tStorm& orig )
       stdur(orig.stdur),
       istdur(orig.istdur),
       endtm(orig.endtm),
-      optVariable(orig.optVariable)
+      SpeedX(orig.SpeedX),
+      SpeedY(orig.SpeedY),
+      source0(orig.source0),
+      tauc(orig.tauc),
+      tauf(orig.tauf),
+      BasicP(orig.BasicP),
+      initialqc(orig.initialqc),
+      initialqs(orig.initialqs),
+      avrge(orig.avrge),
+      subEgeNum(orig.subEgeNum),
+      optVariable(orig.optVariable),
+      stormcenterpoint_a(orig.stormcenterpoint_a),
+      stormcenterpoint_b(orig.stormcenterpoint_b),
+      stormradius(orig.stormradius),
+      minRadius(orig.minRadius),
+      maxRadius(orig.maxRadius)
 {}
 /**************************************************************************\
 **
@@ -191,7 +209,7 @@ tStorm::tStorm( const tStorm& orig )
 void tStorm::TurnOnOutput( const tInputFile& infile )
 {
      // If variable storms used, create a file for writing them
-  if( !stormfile.good() && optVariable )
+  if( !stormfile.is_open() && optVariable )
    {
       char fname[87];
 #define THEEXT ".storm"
@@ -207,7 +225,7 @@ void tStorm::TurnOnOutput( const tInputFile& infile )
 
 void tStorm::TurnOffOutput()
 {
-  if( stormfile.good() )
+  if( stormfile.is_open() )
     stormfile.close();
 }
 
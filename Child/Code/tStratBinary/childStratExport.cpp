@@ -0,0 +1,50 @@
+/**************************************************************************/
+/**
+**  childStratExport.cpp: writes the text stratigraphy files (.stratxyz,
+**  .strat, .litho and .channelmap) from a binary stratigraphy file
+**  written with OPT_STRAT_BINARY (see tStratBinary).
+**
+**  Usage: childStratExport <name>.stratbin<n> [<output name>]
+**
+**  The text files are <output name>.stratxyz<n> and so on; the output
+**  name defaults to <name>.
+**
+**  Created 10/2026
+*/
+/**************************************************************************/
+
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include "tStratBinary.h"
+
+int main( int argc, char **argv )
+{
+  if( argc != 2 && argc != 3 )
+  {
+    std::cerr << "Usage: " << argv[0]
+              << " <name>.stratbin<n> [<output name>]" << std::endl;
+    return 1;
+  }
+  const std::string fileName( argv[1] );
+  const std::string::size_type dot = fileName.rfind( ".stratbin" );
+  if( dot == std::string::npos )
+  {
+    std::cerr << argv[0] << ": '" << fileName
+              << "' does not end in .stratbin<n>" << std::endl;
+    return 1;
+  }
+  const int counter = atoi( fileName.c_str() + dot + 9 );
+  const std::string baseName = argc == 3 ? argv[2] : fileName.substr( 0, dot );
+
+  tStratBinary strat;
+  if( !strat.Read( fileName.c_str() ) )
+    return 1;
+  if( !strat.WriteText( baseName.c_str(), counter ) )
+    return 1;
+  std::cout << "Wrote " << strat.getNumCells() << " cells and "
+            << strat.getNumLayers() << " layers at time " << strat.time
+            << " to " << baseName << ".stratxyz" << counter << " etc."
+            << std::endl;
+  return 0;
+}
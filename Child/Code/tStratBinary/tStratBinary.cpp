@@ -0,0 +1,290 @@
+/***************************************************************************/
+/**
+**  @file tStratBinary.cpp
+**  @brief Functions for tStratBinary (see tStratBinary.h).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include "tStratBinary.h"
+#include "../errors/errors.h"
+
+namespace
+{
+  const char kMagic[8] = { 'C','H','S','T','R','A','T','B' };
+  const int kVersion = 1;
+  const int kVersionSwapped = 0x01000000;  // kVersion read in the other order
+
+  template< class T >
+  void WriteArray( std::ofstream &ofs, std::vector< T > const &v )
+  {
+    if( !v.empty() )
+      ofs.write( reinterpret_cast< const char * >( &v[0] ),
+                 v.size() * sizeof( T ) );
+  }
+
+  template< class T >
+  void ReadArray( std::ifstream &ifs, std::vector< T > &v, int n )
+  {
+    v.resize( n );
+    if( n > 0 )
+      ifs.read( reinterpret_cast< char * >( &v[0] ), n * sizeof( T ) );
+  }
+
+  template< class T >
+  void WriteValue( std::ofstream &ofs, T const &value )
+  {
+    ofs.write( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+  }
+
+  template< class T >
+  void ReadValue( std::ifstream &ifs, T &value )
+  {
+    ifs.read( reinterpret_cast< char * >( &value ), sizeof( T ) );
+  }
+}
+
+tStratBinary::tStratBinary() :
+  time( 0. ), ni( 0 ), nj( 0 ),
+  x(), y(), z(), drainage(), offset( 1, 0 ),
+  thickness(), texture(), rtime(), ctime()
+{}
+
+/**************************************************************************\
+**
+**  tStratBinary::Clear
+**
+**  Empties the arrays (keeping their memory, as the next output has
+**  about as many cells and layers) and sets the time and grid size.
+**
+\**************************************************************************/
+void tStratBinary::Clear( double time_, int ni_, int nj_ )
+{
+  time = time_;
+  ni = ni_;
+  nj = nj_;
+  x.clear(); y.clear(); z.clear(); drainage.clear();
+  offset.assign( 1, 0 );
+  thickness.clear(); texture.clear(); rtime.clear(); ctime.clear();
+}
+
+/**************************************************************************\
+**
+**  tStratBinary::AddColumn, AddLayer
+**
+**  Add a cell, then each of its layers from the top down.
+**
+\**************************************************************************/
+void tStratBinary::AddColumn( double x_, double y_, double z_,
+                              double drainage_ )
+{
+  x.push_back( x_ );
+  y.push_back( y_ );
+  z.push_back( z_ );
+  drainage.push_back( drainage_ );
+  offset.push_back( offset.back() );
+}
+
+void tStratBinary::AddLayer( double thickness_, double texture_,
+                             double rtime_, double ctime_ )
+{
+  thickness.push_back( thickness_ );
+  texture.push_back( texture_ );
+  rtime.push_back( rtime_ );
+  ctime.push_back( ctime_ );
+  ++offset.back();
+}
+
+/**************************************************************************\
+**
+**  tStratBinary::Write
+**
+**  Writes the header and the arrays to fileName. Returns false if the
+**  file cannot be created or written.
+**
+\**************************************************************************/
+bool tStratBinary::Write( const char *fileName ) const
+{
+  std::ofstream ofs( fileName, std::ios::out | std::ios::binary );
+  if( !ofs.good() )
+    return false;
+  const int nCells = getNumCells();
+  const int nLayers = getNumLayers();
+  ofs.write( kMagic, sizeof( kMagic ) );
+  WriteValue( ofs, kVersion );
+  WriteValue( ofs, nCells );
+  WriteValue( ofs, ni );
+  WriteValue( ofs, nj );
+  WriteValue( ofs, time );
+  WriteValue( ofs, nLayers );
+  WriteArray( ofs, x );
+  WriteArray( ofs, y );
+  WriteArray( ofs, z );
+  WriteArray( ofs, drainage );
+  WriteArray( ofs, offset );
+  WriteArray( ofs, thickness );
+  WriteArray( ofs, texture );
+  WriteArray( ofs, rtime );
+  WriteArray( ofs, ctime );
+  return ofs.good();
+}
+
+/**************************************************************************\
+**
+**  tStratBinary::Read
+**
+**  Reads a file written by Write. Returns false, with a message, if it
+**  cannot be opened or is not such a file. A file which is one but whose
+**  header and offset table do not agree with its size and with each
+**  other (cut short or corrupt) is a fatal error, found before any of
+**  the arrays are read.
+**
+\**************************************************************************/
+bool tStratBinary::Read( const char *fileName )
+{
+  std::ifstream ifs( fileName, std::ios::in | std::ios::binary );
+  if( !ifs.good() )
+  {
+    std::cerr << "tStratBinary: unable to open '" << fileName << "'.\n";
+    return false;
+  }
+  char magic[sizeof( kMagic )];
+  int version = 0;
+  ifs.read( magic, sizeof( magic ) );
+  ReadValue( ifs, version );
+  if( !ifs.good() || memcmp( magic, kMagic, sizeof( kMagic ) ) != 0 )
+  {
+    std::cerr << "tStratBinary: '" << fileName
+              << "' is not a binary stratigraphy file.\n";
+    return false;
+  }
+  if( version != kVersion )
+  {
+    if( version == kVersionSwapped )
+      std::cerr << "tStratBinary: '" << fileName << "' was written on a "
+                << "machine of the other byte order.\n";
+    else
+      std::cerr << "tStratBinary: '" << fileName << "' has version "
+                << version << "; this reader knows version " << kVersion
+                << ".\n";
+    return false;
+  }
+  int nCells = 0, nLayers = 0;
+  ReadValue( ifs, nCells );
+  ReadValue( ifs, ni );
+  ReadValue( ifs, nj );
+  ReadValue( ifs, time );
+  ReadValue( ifs, nLayers );
+  if( !ifs.good() || nCells < 0 || nLayers < 0 )
+  {
+    std::cerr << "tStratBinary: bad header in '" << fileName << "'.\n";
+    ReportFatalError( "Corrupt binary stratigraphy file." );
+  }
+
+  // The header gives the size of the file (in double, as the counts
+  // may be corrupt and overflow an int)
+  const std::streampos dataStart = ifs.tellg();
+  ifs.seekg( 0, std::ios::end );
+  const double fileSize = static_cast< double >( ifs.tellg() );
+  const double expectedSize = static_cast< double >( dataStart )
+    + 4. * nCells * sizeof( double ) + ( nCells + 1. ) * sizeof( int )
+    + 4. * nLayers * sizeof( double );
+  if( fileSize != expectedSize )
+  {
+    std::cerr << "tStratBinary: '" << fileName << "' has " << fileSize
+              << " bytes; its header gives " << nCells << " cells and "
+              << nLayers << " layers, or " << expectedSize << " bytes.\n";
+    ReportFatalError( "Binary stratigraphy file is cut short or corrupt." );
+  }
+  ifs.seekg( dataStart );
+
+  ReadArray( ifs, x, nCells );
+  ReadArray( ifs, y, nCells );
+  ReadArray( ifs, z, nCells );
+  ReadArray( ifs, drainage, nCells );
+  ReadArray( ifs, offset, nCells+1 );
+  if( !ifs.good() )
+  {
+    std::cerr << "tStratBinary: error reading '" << fileName << "'.\n";
+    ReportFatalError( "Unable to read binary stratigraphy file." );
+  }
+  // Cell c's layers are offset[c] to offset[c+1]-1, within 0..nLayers-1
+  for( int c = 0; c <= nCells; ++c )
+    if( ( c == 0 && offset[c] != 0 )
+        || ( c > 0 && offset[c] < offset[c-1] )
+        || ( c == nCells && offset[c] != nLayers ) )
+    {
+      std::cerr << "tStratBinary: '" << fileName << "' has layer offset "
+                << offset[c] << " for cell " << c << ".\n";
+      ReportFatalError( "Binary stratigraphy file has a corrupt offset table." );
+    }
+  ReadArray( ifs, thickness, nLayers );
+  ReadArray( ifs, texture, nLayers );
+  ReadArray( ifs, rtime, nLayers );
+  ReadArray( ifs, ctime, nLayers );
+  if( !ifs.good() )
+  {
+    std::cerr << "tStratBinary: error reading '" << fileName << "'.\n";
+    ReportFatalError( "Unable to read binary stratigraphy file." );
+  }
+  return true;
+}
+
+/**************************************************************************\
+**
+**  tStratBinary::WriteText
+**
+**  Writes baseName.stratxyz<counter>, .strat<counter>, .litho<counter>
+**  and .channelmap<counter> as tStratOutputImp writes them when
+**  OPT_STRAT_BINARY is off. (The .strat and .litho files have always
+**  held the same values.) Returns false if a file cannot be created.
+**
+\**************************************************************************/
+bool tStratBinary::WriteText( const char *baseName, int counter ) const
+{
+  static const char *extension[4] =
+    { ".stratxyz", ".strat", ".litho", ".channelmap" };
+  std::ofstream ofs[4];
+  for( int f = 0; f < 4; ++f )
+  {
+    char ext[32];
+    sprintf( ext, "%s%d", extension[f], counter );
+    std::string fileName( baseName );
+    fileName += ext;
+    ofs[f].open( fileName.c_str() );
+    if( !ofs[f].good() )
+    {
+      std::cerr << "tStratBinary: unable to create '" << fileName
+                << "'.\n";
+      return false;
+    }
+    ofs[f].precision( 12 );
+    ofs[f] << time << '\n' << getNumCells() << '\n' << ni << '\n'
+           << nj << '\n';
+  }
+  std::ofstream &stratxyzofs = ofs[0], &stratofs = ofs[1],
+    &lithoofs = ofs[2], &channelofs = ofs[3];
+  for( int c = 0; c < getNumCells(); ++c )
+  {
+    stratxyzofs << x[c] << ' ' << y[c] << ' ' << z[c] << '\n';
+    channelofs << x[c] << ' ' << y[c] << ' ' << z[c] << ' '
+               << drainage[c] << '\n';
+    stratofs << offset[c+1] - offset[c] << '\n';
+    lithoofs << offset[c+1] - offset[c] << '\n';
+    for( int l = offset[c]; l < offset[c+1]; ++l )
+    {
+      stratofs << thickness[l] << ' ' << texture[l] << ' '
+               << rtime[l] << ' ' << ctime[l] << '\n';
+      lithoofs << thickness[l] << ' ' << texture[l] << ' '
+               << rtime[l] << ' ' << ctime[l] << '\n';
+    }
+  }
+  return true;
+}
@@ -0,0 +1,72 @@
+//-*-c++-*-
+
+/***************************************************************************/
+/**
+**  @file tStratBinary.h
+**  @brief Header for tStratBinary, the columnar binary form of the
+**         complete stratigraphy written with the strat grid.
+**
+**  The complete stratigraphy used to be written as four text files per
+**  output (.stratxyz, .strat, .litho and .channelmap), a line per cell
+**  and per layer. With OPT_STRAT_BINARY, tStratOutputImp gathers the
+**  same values into a tStratBinary instead, one array per attribute,
+**  and writes them to a single file, OUTFILENAME.stratbin<n>, with one
+**  large write per array. The layers of all the cells are stored one
+**  after the other, and a table of offsets gives where the layers of
+**  each cell start.
+**
+**  Layout (native byte order; the version number tells a reader when
+**  the file comes from a machine of the other order):
+**    char[8]   "CHSTRATB"
+**    int       version (1)
+**    int       nCells, ni, nj   (cells are i = 1..ni-1 within j = 1..nj-1,
+**                                i varying fastest; ni, nj as in the
+**                                text files' headers)
+**    double    time
+**    int       nLayers          (total, all cells)
+**    double    x[nCells], y[nCells], z[nCells]
+**    double    drainage[nCells] (drainage area / 1000, as in .channelmap)
+**    int       offset[nCells+1] (layers of cell c are offset[c] to
+**                                offset[c+1]-1; the surface layer is
+**                                left out, as in the text files)
+**    double    thickness[nLayers], texture[nLayers],
+**              rtime[nLayers], ctime[nLayers]
+**
+**  WriteText writes the four text files from the arrays, exactly as
+**  tStratOutputImp would have written them, so that scripts that read
+**  them keep working (see the childStratExport program).
+**
+**  Created 10/2026
+*/
+/***************************************************************************/
+
+#ifndef TSTRATBINARY_H
+#define TSTRATBINARY_H
+
+#include <vector>
+
+class tStratBinary
+{
+public:
+  tStratBinary();
+
+  void Clear( double time, int ni, int nj );
+  void AddColumn( double x, double y, double z, double drainage );
+  void AddLayer( double thickness, double texture,
+                 double rtime, double ctime );
+
+  bool Write( const char *fileName ) const;
+  bool Read( const char *fileName );
+  bool WriteText( const char *baseName, int counter ) const;
+
+  int getNumCells() const { return static_cast<int>( x.size() ); }
+  int getNumLayers() const { return static_cast<int>( thickness.size() ); }
+
+  double time;
+  int ni, nj;
+  std::vector< double > x, y, z, drainage;      // one per cell
+  std::vector< int > offset;                    // nCells+1
+  std::vector< double > thickness, texture, rtime, ctime;  // one per layer
+};
+
+#endif
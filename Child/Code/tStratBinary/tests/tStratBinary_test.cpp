@@ -0,0 +1,107 @@
+/**************************************************************************/
+/**
+**  tStratBinary_test.cpp: writes a small stratigraphy with
+**  tStratBinary::Write, reads it back with tStratBinary::Read and checks
+**  that every array comes back the same, then exports it as text.
+**
+**  Usage: tStratBinary_test [truncated]
+**
+**  With "truncated", the file is cut short before it is read, which
+**  Read must report as a fatal error (the test then expects its
+**  message).
+**
+**  Created 10/2026
+*/
+/**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <string>
+
+#include "../tStratBinary.h"
+
+#define CHECK(name, cond) { \
+  fprintf (stdout, "\033[32m%s... \033[39m", name); \
+  if (cond) \
+    fprintf (stdout, "\033[32mPASS\033[39m\n"); \
+  else { \
+    fprintf (stdout, "\033[31mFAIL\033[39m\n"); \
+    exit (EXIT_FAILURE); \
+  } \
+}
+
+/* Three cells: two layers, none, then three. */
+static void
+MakeStrat (tStratBinary &strat)
+{
+  strat.Clear (1500.5, 3, 3);
+  strat.AddColumn (0.5, 1.5, 10.25, 0.001);
+  strat.AddLayer (0.1, 0.25, 100., 1500.);
+  strat.AddLayer (2.5, 1., -1e-300, 1e300);
+  strat.AddColumn (1.5, 1.5, -3., 12.);
+  strat.AddColumn (2.5, 1.5, 0., 1e6);
+  strat.AddLayer (1., 0., 0., 0.);
+  strat.AddLayer (1e-12, 0.5, 750., 751.);
+  strat.AddLayer (7., 0.75, 1., 2.);
+}
+
+static bool
+SameStrat (tStratBinary const &a, tStratBinary const &b)
+{
+  return a.time == b.time && a.ni == b.ni && a.nj == b.nj
+    && a.x == b.x && a.y == b.y && a.z == b.z && a.drainage == b.drainage
+    && a.offset == b.offset && a.thickness == b.thickness
+    && a.texture == b.texture && a.rtime == b.rtime && a.ctime == b.ctime;
+}
+
+static long
+FileSize (const char *fileName)
+{
+  std::ifstream ifs (fileName, std::ios::in | std::ios::binary);
+
+  if (!ifs.good ())
+    return -1;
+  ifs.seekg (0, std::ios::end);
+  return static_cast<long> (ifs.tellg ());
+}
+
+int
+main (int argc, char *argv[])
+{
+  tStratBinary strat, copy;
+
+  MakeStrat (strat);
+  CHECK ("Columns", strat.getNumCells () == 3 && strat.getNumLayers () == 5);
+  CHECK ("Write", strat.Write ("strat_test.stratbin1"));
+
+  if (argc > 1 && strcmp (argv[1], "truncated") == 0) {
+    const long size = FileSize ("strat_test.stratbin1");
+    std::string contents (size - 8, '\0');
+    {
+      std::ifstream ifs ("strat_test.stratbin1",
+                         std::ios::in | std::ios::binary);
+      ifs.read (&contents[0], contents.size ());
+    }
+    {
+      std::ofstream ofs ("strat_test_cut.stratbin1",
+                         std::ios::out | std::ios::binary);
+      ofs.write (contents.data (), contents.size ());
+    }
+    copy.Read ("strat_test_cut.stratbin1");   /* must not return */
+    fprintf (stdout, "Read accepted a truncated file\n");
+    return EXIT_FAILURE;
+  }
+
+  CHECK ("Read", copy.Read ("strat_test.stratbin1"));
+  CHECK ("Round trip", SameStrat (strat, copy));
+  CHECK ("Reject a missing file", !copy.Read ("strat_test_missing"));
+  CHECK ("Write text", copy.WriteText ("strat_test", 1));
+  CHECK ("Text files", FileSize ("strat_test.stratxyz1") > 0
+         && FileSize ("strat_test.strat1") > 0
+         && FileSize ("strat_test.litho1") > 0
+         && FileSize ("strat_test.channelmap1") > 0);
+
+  return EXIT_SUCCESS;
+}
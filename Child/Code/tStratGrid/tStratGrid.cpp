@@ -23,6 +23,7 @@
 #include "tStratGrid.h"
 #include "../tLNode/tLNode.h"
 #include "../tMesh/tMesh.h"
+#include "../tMemoryFootprint/tMemoryFootprint.h"
 
 #include <iostream>
 
@@ -249,6 +250,37 @@ tStratGrid::~tStratGrid()
   delete StratConnect;
 }
 
+/**************************************************************************\
+**
+**  tStratGrid::AddMemoryFootprint
+**
+**  Adds to mf the memory held by the grid: its node and connectivity
+**  matrices, the layers of each node, and the time-slice arrays.
+**
+**  Created: 10/2026
+**
+\**************************************************************************/
+void tStratGrid::AddMemoryFootprint( tMemoryFootprint &mf ) const
+{
+  const int nr = StratNodeMatrix->getNumRows();
+  const int nc = StratNodeMatrix->getNumCols();
+  mf.AddBlock( tMemoryFootprint::kStratGrid, sizeof( tStratGrid ) );
+  mf.AddBlock( tMemoryFootprint::kStratGrid, sizeof( *StratNodeMatrix ) );
+  mf.AddBlock( tMemoryFootprint::kStratGrid, nr*nc*sizeof( tStratNode ) );
+  for( int i=0; i<nr; ++i )
+    for( int j=0; j<nc; ++j )
+      (*StratNodeMatrix)( i, j ).AddMemoryFootprint( mf );
+  mf.AddBlock( tMemoryFootprint::kStratGrid, sizeof( *StratConnect ) );
+  mf.AddBlock( tMemoryFootprint::kStratGrid,
+               StratConnect->getNumRows()*StratConnect->getNumCols()
+               * sizeof( tTriangle * ) );
+  mf.AddArray( tMemoryFootprint::kStratGrid, section );
+  mf.AddArray( tMemoryFootprint::kStratGrid, surface );
+  mf.AddArray( tMemoryFootprint::kStratGrid, subsurface );
+  mf.AddArray( tMemoryFootprint::kStratGrid, subsurface_mbelt );
+  mf.AddArray( tMemoryFootprint::kStratGrid, outputTime );
+}
+
 // SET SECTION BASE
 // This is a debug function, records the elevations of the stratgrid nodes
 // at the beginning of a simulation.
@@ -1219,6 +1251,18 @@ tStratNode::~tStratNode()
 
 
 
+// Adds the layers of the node to mf (see tMemoryFootprint)
+void tStratNode::AddMemoryFootprint( tMemoryFootprint &mf ) const
+{
+  for( tListNodeBasic< tLayer > const *ln = layerlist.getFirst(); ln != 0;
+       ln = ln->getNext() )
+  {
+    mf.AddBlock( tMemoryFootprint::kStratGrid,
+                 sizeof( tListNodeBasic< tLayer > ) );
+    mf.AddArray( tMemoryFootprint::kStratGrid, ln->getDataRef().getDgrade() );
+  }
+}
+
 //"set" and "get" functions for the coordinates:
 void tStratNode::setX( double val ) {x = val;}
 void tStratNode::setY( double val ) {y = val;}
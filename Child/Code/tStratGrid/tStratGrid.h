@@ -28,6 +28,7 @@ class tTriangle;
 
 class tLayer;
 class tLNode;
+class tMemoryFootprint;
 // necessary to get tLayer::tSed_t
 #include "../tLNode/tLNode.h"
 
@@ -135,6 +136,7 @@ public:
     ClosestNode = n_;
   }
   tLNode* getClosestNode();
+  void AddMemoryFootprint( tMemoryFootprint & ) const; // layers held
 
 #ifndef NDEBUG
   void TellAll();
@@ -227,6 +229,7 @@ public:
   void updateConnect();
   double CalculateMeanderCurrent(tTriangle *, double, double) const;
   double CompassAngle(tLNode *,tLNode *) const;
+  void AddMemoryFootprint( tMemoryFootprint & ) const; // memory held
 
 protected:			          // can be accessed by friend classes
 
@@ -1270,22 +1270,25 @@ void tStreamMeander::MakeChanBorder( )
 **
 **  For meandering nodes with placement coords set, check whether
 **  a new node should be dropped. Checks to see whether 3D bank coords
-**  were set in MakeChanBorder. If so, adds new node if it is within bounds
-**  (i.e., can be found by LocateTriangle). That's it.
+**  were set in MakeChanBorder. If so, queues a new node there if it is
+**  within bounds (i.e., can be found by LocateTriangle); the queued
+**  nodes are added in one batch (tMesh::AddNodes). A node out of bounds
+**  keeps its bank coords, to be tried again next time. That's it.
 **
 **  Parameters:
 **  Called by:      Migrate
 **  Created:        8/18/97 SL
 **  Updated:        1/98 SL; 2/98 SL; 11/03 SL (major change)
+**                  bank nodes added in one bulk insertion
 **
 \***************************************************************************/
 void tStreamMeander::AddChanBorder(double time)
 {
    if (0) //DEBUG
        std::cout << "AddChanBorder()" << std::endl;
-   bool change = false; //haven't added any nodes yet
    const tArray< double > zeroArr(4);
    tLNode channode;
+   tList< tLNode > bankNodes; // new nodes, added together below
 
    int i;
    tPtrList< tLNode > *cr;
@@ -1304,13 +1307,13 @@ void tStreamMeander::AddChanBorder(double time)
             if (0) //DEBUG
                 std::cout << "node " << cn->getID()
                      << " ready to drop new node" << std::endl;
-            //just make sure new node will be in a triangle
+            //just make sure new node will be in a triangle; if not,
+            //keep the bank coords and try again next time
             tTriangle* ct = meshPtr->LocateTriangle( oldpos[0], oldpos[1] );
             if( ct != NULL )
             {
                //***NG: HERE IS WHERE YOU CAN FIND A DEPOSIT THICKNESS
                //TO ADD TO THE NEW NODE***
-               channode.set3DCoords( oldpos[0], oldpos[1], oldpos[2] );
                tArray< double > xyz(3);
                for( int k=0; k<3; ++k ) xyz[k] = oldpos[k];
                // Make sure the banknode is not lower than the node it
@@ -1327,18 +1330,15 @@ void tStreamMeander::AddChanBorder(double time)
                //xyz[2]-cn->getZ() if this depth is positive
                //The texture of this deposit would be
                //the surface texture of cn.  Use erodep.
-               tLNode* nnPtr = meshPtr->AddNode( channode, kNoUpdateMesh, time );
-               if( nnPtr != NULL ){
-		          if(0)//DEBUG
-		             std::cout<<"ACB pt "<<nnPtr->getID()<<" added at "<<xyz[0]<<", "<<xyz[1]<<", "<<xyz[2]<<std::endl;
-		          change = true; //flag to update mesh
-               }
+               bankNodes.insertAtBack( channode );
                cn->setXYZD( zeroArr );
             }
          }
       }
    }
-   if( change )
+   // add the bank nodes and update the mesh if any went in
+   if( bankNodes.getSize() > 0 &&
+       meshPtr->AddNodes( bankNodes, kNoUpdateMesh, time ) > 0 )
    {
       meshPtr->UpdateMesh();
       if (1){ //DEBUG
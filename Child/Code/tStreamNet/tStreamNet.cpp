@@ -37,6 +37,26 @@ tStreamNet::kChannelType_t tStreamNet::IntToChannelType( int c ){
   }
 }
 
+tStreamNet::kMFDWeight_t tStreamNet::IntToMFDWeight( int c ){
+  switch(c){
+    case 0: return kMFDNone;
+    case 1: return kMFDSteepest;
+    case 2: return kMFDQuinn;
+    case 3: return kMFDFreeman;
+    case 4: return kMFDKinWave;
+    default:
+      std::cout << "You asked for multiple flow direction option " << c
+      << " but there is no such thing.\n"
+      "Available options are:\n"
+      " 0. None (single steepest-descent direction)\n"
+      " 1. D8-like: all flow along the steepest direction\n"
+      " 2. Slope x Voronoi edge width (Quinn et al., 1991)\n"
+      " 3. Slope^MFD_SLOPE_EXP x Voronoi edge width (after Freeman, 1991)\n"
+      " 4. Sqrt of slope x Voronoi edge width (kinematic wave)\n";
+      ReportFatalError( "Unrecognized multiple flow direction option.\n" );
+  }
+}
+
 /**************************************************************************\
  **  Functions for class tStreamNet here:
  \**************************************************************************/
@@ -130,7 +150,13 @@ mpParkerChannels(0)
     mdHydrgrphShapeFac = infile.ReadItem( mdHydrgrphShapeFac, "HYDROSHAPEFAC" );
   }
   
-  //    optMultipleFlowDirections = infile.ReadBool( "OPT_MULTIPLE_FLOW_DIR", false );
+  miMFDWeights =
+    IntToMFDWeight( infile.ReadInt( "OPT_MULTIPLE_FLOW_DIR", false ) );
+  if( miMFDWeights == kMFDFreeman )
+    mdMFDExponent = infile.ReadItem( mdMFDExponent, "MFD_SLOPE_EXP" );
+  else mdMFDExponent = 1.0;
+  mbBasinParallel = infile.ReadBool( "OPT_BASIN_PARALLEL", false );
+  miNumBasins = 0;
   
   // Get the initial rainfall rate from the storm object, and read in option
   // for stochastic variation in rainfall
@@ -204,6 +230,8 @@ mpParkerChannels(0)
     mdMeshAdaptMaxVArea = infile.ReadItem( mdMeshAdaptMaxVArea,
                                           "MESHADAPTAREA_MAXVAREA" );
   }
+  else
+    mdMeshAdaptMinArea = mdMeshAdaptMaxVArea = 0.0;
   
   // Initialize the network by calculating slopes, flow directions,
   // drainage areas, and discharge
@@ -250,32 +278,19 @@ mdMeshAdaptMinArea(orig.mdMeshAdaptMinArea),  // Dr area threshold for densifyin
 mdMeshAdaptMaxVArea(orig.mdMeshAdaptMaxVArea), // Max voronoi area for nodes above threshold
 mdHydrgrphShapeFac(orig.mdHydrgrphShapeFac),  // "Fhs" for hydrograph peak method
 mdFlowVelocity(orig.mdFlowVelocity),      // Runoff velocity for computing travel time
-optVariableTransmissivity(orig.optVariableTransmissivity) // option for soil depth-dependent transmissivity
+optVariableTransmissivity(orig.optVariableTransmissivity), // option for soil depth-dependent transmissivity
+miMFDWeights(orig.miMFDWeights), // option for flow routing via MFD algorithm
+mdMFDExponent(orig.mdMFDExponent), // slope exponent for Freeman MFD weights
+mbBasinParallel(orig.mbBasinParallel), // option for basin-parallel erosion
+miNumBasins(0)
 {
   if( orig.mpParkerChannels )
     mpParkerChannels = new tParkerChannels( *orig.mpParkerChannels );  // -> tParkerChannels object
   
-  // kluge: re-do network routing
-  // Initialize the network by calculating slopes, flow directions,
-  // drainage areas, and discharge
-  CalcSlopes();  // TODO: should be in tMesh
-  //   tMesh<tLNode>::nodeListIter_t nI( meshPtr->getNodeList() );
-  //   tSpkIter sI;
-  //   tEdge* ce;
-  //   int i=0;
-  //   for( tLNode* cn = nI.FirstP(); nI.IsActive(); cn = nI.NextP() )
-  //     {
-  //       sI.Reset( cn );
-  //       for( ce=sI.FirstP(); 
-  // 	   !sI.AtEnd() && ce->getDestinationPtr()->getID() != flowDest[i]; 
-  // 	   ce=sI.NextP() );
-  //       cn->setFlowEdg( ce );
-  //       ++i;
-  //     }
-  InitFlowDirs(); // TODO: should all be done in call to updatenet
-  FlowDirs();
+  // The mesh copy keeps each node's flow edge, drainage area and
+  // discharge (see tMesh::RelinkCopiedElements), so the network needs
+  // no re-routing here
   CheckNetConsistency();
-  MakeFlow( 0.0 );
 }
 
 //necessary?
@@ -318,6 +333,22 @@ bool tStreamNet::getFillLakesOpt() const {return filllakes;}
 
 double tStreamNet::getRainRate() const {return rainrate;}
 
+bool tStreamNet::getBasinParallelOpt() const {return mbBasinParallel;}
+
+double tStreamNet::getMeshAdaptMinArea() const {return mdMeshAdaptMinArea;}
+
+double tStreamNet::getMeshAdaptMaxVArea() const {return mdMeshAdaptMaxVArea;}
+
+int tStreamNet::getNumBasins() const {return miNumBasins;}
+
+int tStreamNet::getBasinByRank( int k ) const {return mBasinRank[k];}
+
+int tStreamNet::getBasinSize( int b ) const
+{return mBasinFirst[b+1] - mBasinFirst[b];}
+
+tLNode * const *tStreamNet::getBasinNodes( int b ) const
+{return mBasinNodes.getArrayPtr() + mBasinFirst[b];}
+
 double tStreamNet::getTransmissivity() const {return trans;}
 
 double tStreamNet::getInfilt() const {return infilt;}
@@ -910,15 +941,21 @@ void tStreamNet::ShowMeanderNeighbours(int debugID) const
 void tStreamNet::CalcSlopes()
 {
   assert( meshPtr != 0 );
-  tEdge *curedg;
-  tMesh< tLNode >::edgeListIter_t i( meshPtr->getEdgeList() );
   
   if (0) //DEBUG
     std::cout << "CalcSlopes()...";
   
-  // Loop through each pair of edges on the list
-  for( curedg = i.FirstP(); !( i.AtEnd() ); curedg = i.NextP() )
+  BuildEdgePairIndex();
+  const int npairs = static_cast<int>( mEdgePairIndex.getSize() );
+  
+  // Loop through each pair of edges; pairs are independent, so they can
+  // be processed by several threads at once
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for( int k=0; k<npairs; ++k )
   {
+    tEdge *curedg = mEdgePairIndex[k];
     // Make sure edge is valid, and length is nonzero
     assert( curedg != 0 );
     assert( curedg->getLength() > 0 );
@@ -929,11 +966,9 @@ void tStreamNet::CalcSlopes()
     / curedg->getLength();
     curedg->setSlope( slp );
     
-    // Advance to the edge's complement, and assign it -slp
-    curedg = i.NextP();
-    assert( !( i.AtEnd() ) );
+    // Assign -slp to the edge's complement
+    curedg = curedg->getComplementEdge();
     curedg->setSlope( -slp );
-    //curedg->setLength( length );
     assert( curedg->getLength() > 0 );
   }
   if (0) //DEBUG
@@ -941,6 +976,47 @@ void tStreamNet::CalcSlopes()
 }
 
 
+/****************************************************************************\
+ **
+ **  tStreamNet::BuildEdgePairIndex
+ **  tStreamNet::BuildActiveNodeIndex
+ **
+ **  Fill mEdgePairIndex with the first edge of each complementary pair,
+ **  and mActiveNodeIndex with the active (non-boundary) nodes, in list
+ **  order. The linked lists cannot be split among threads, so CalcSlopes
+ **  and FlowDirs walk them once here and then loop over the arrays.
+ **  The arrays are only reallocated when the mesh size changes.
+ **
+ \****************************************************************************/
+void tStreamNet::BuildEdgePairIndex()
+{
+  tMesh< tLNode >::edgeListIter_t i( meshPtr->getEdgeList() );
+  const size_t npairs = meshPtr->getEdgeList()->getSize() / 2;
+  if( mEdgePairIndex.getSize() != npairs )
+    mEdgePairIndex.setSize( npairs );
+  size_t k = 0;
+  for( tEdge *curedg = i.FirstP(); !( i.AtEnd() ); curedg = i.NextP() )
+  {
+    mEdgePairIndex[k++] = curedg;
+    i.Next();   // skip the complement
+    assert( !( i.AtEnd() ) );
+  }
+  assert( k == npairs );
+}
+
+void tStreamNet::BuildActiveNodeIndex()
+{
+  tMesh< tLNode >::nodeListIter_t i( meshPtr->getNodeList() );
+  const size_t nactive = meshPtr->getNodeList()->getActiveSize();
+  if( mActiveNodeIndex.getSize() != nactive )
+    mActiveNodeIndex.setSize( nactive );
+  size_t k = 0;
+  for( tLNode *cn = i.FirstP(); i.IsActive(); cn = i.NextP() )
+    mActiveNodeIndex[k++] = cn;
+  assert( k == nactive );
+}
+
+
 /****************************************************************************\
  **
  **  tStreamNet::InitFlowDirs
@@ -1166,7 +1242,6 @@ void tStreamNet::ReInitFlowDirs()
 #define kMaxSpokes 100
 void tStreamNet::FlowDirs()
 {
-  tMesh< tLNode >::nodeListIter_t i( meshPtr->getNodeList() );  // gets nodes from the list
   double slp=0;                          // steepest slope found so far
   double meanderslp = 0;		// steepest meander slope found so far
   double selectslope;			// value of the selected slope
@@ -1180,10 +1255,19 @@ void tStreamNet::FlowDirs()
   
   int ctr;
   
+  // Each node only sets its own flow edge and flood status, so the
+  // active nodes can be handled by several threads at once
+  BuildActiveNodeIndex();
+  const int nactive = static_cast<int>( mActiveNodeIndex.getSize() );
+  
   // Find the connected edge with the steepest slope
-  curnode = i.FirstP();
-  while( i.IsActive() )  // DO for each non-boundary (active) node   = LOOP OVER NODES !
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) \
+  private(slp,meanderslp,selectslope,curnode,firstedg,curedg,nbredg,meanderedg,ctr)
+#endif
+  for( int k=0; k<nactive; ++k )  // DO for each non-boundary (active) node   = LOOP OVER NODES !
   {
+    curnode = mActiveNodeIndex[k];
     selectslope = 0.0;
     curnode->setFloodStatus( tLNode::kNotFlooded );  // Init flood status flag
     firstedg =  curnode->getFlowEdg();
@@ -1468,8 +1552,6 @@ void tStreamNet::FlowDirs()
           }
         }
         
-        curnode = i.NextP();                // Continue with the next node on the active list
-        
       } // end of node loop
       
       if (0) //DEBUG
@@ -1544,46 +1626,361 @@ void tStreamNet::DrainAreaVoronoi()
  **  tStreamNet::DrainAreaVoronoiMFD
  **
  **  Computes drainage area for each node by summing the Voronoi areas of all
- **  nodes that drain to it, using the following algorithm:
+ **  nodes that drain to it, partitioning the area leaving each node among
+ **  its downslope neighbors (multiple flow directions; see BuildMFDRouting
+ **  for the partitioning rules):
  **
- **    Reset drainage area for all active nodes to zero
- **    FOR each active node
- **      Cascade downstream, partitioning the area at each step downstream
- **         among the downslope neighbors, until an outlet or sink is reached
- **    IF there is an inlet, add its associated drainage area to all nodes
- **         downstream
+ **    Build the routing (receivers, fractions, upstream-to-downstream order)
+ **    Set drainage area of each active node to its own Voronoi area
+ **    IF there is an inlet, add its associated drainage area at the inlet
+ **    FOR each active node, from upstream to downstream
+ **      Pass its drainage area on to its receivers, by fraction
  **
- **  Note that each node's drainage area includes its own Voronoi area.
+ **  As in DrainAreaVoronoi, area is not passed into boundary or sink
+ **  nodes, and sink nodes are left with zero drainage area.
  **
- **    Calls: RouteFlowAreaMultipleFlowDirections, tLNode::setDrArea
+ **    Calls: BuildMFDRouting, tLNode::setDrArea, tLNode::AddDrArea
  **    Modifies:  node drainage area
  **
  \*****************************************************************************/
-// void tStreamNet::DrainAreaVoronoiMFD()
-// {
-//    if (0) //DEBUG
-//      std::cout << "DrainAreaVoronoiMFD()..." << std::endl;
-
-//    tLNode * curnode;
-//    tMesh< tLNode >::nodeListIter_t nodIter( meshPtr->getNodeList() );
-
-//    // Reset drainage areas to zero
-//    for( curnode = nodIter.FirstP(); nodIter.IsActive();
-//         curnode = nodIter.NextP() )
-//        curnode->setDrArea( 0. );
+void tStreamNet::DrainAreaVoronoiMFD()
+{
+  if (0) //DEBUG
+    std::cout << "DrainAreaVoronoiMFD()..." << std::endl;
+  
+  BuildMFDRouting( miMFDWeights, true );
+  const int nactive = static_cast<int>( mMFDNodes.getSize() );
+  tLNode * curnode;
+  int p, k, j;
+  
+  // Start each node off with its own Voronoi area
+  for( p=0; p<nactive; ++p )
+  {
+    curnode = mMFDNodes[p];
+    curnode->setDrArea( curnode->getFloodStatus() == tLNode::kSink ?
+                        0. : curnode->getVArea() );
+  }
+  if( inlet.innode != 0
+      && inlet.innode->getBoundaryFlag() == kNonBoundary
+      && inlet.innode->getFloodStatus() != tLNode::kSink )
+    inlet.innode->AddDrArea( inlet.inDrArea );
+  
+  // Send the area downstream in a single upstream-to-downstream pass
+  for( k=0; k<nactive; ++k )
+  {
+    p = mMFDOrder[k];
+    curnode = mMFDNodes[p];
+    if( curnode->getFloodStatus() == tLNode::kSink ) continue;
+    const double area = curnode->getDrArea();
+    for( j=mMFDFirst[p]; j<mMFDFirst[p+1]; ++j )
+    {
+      tLNode *dn = mMFDRecv[j];
+      if( dn->getBoundaryFlag() == kNonBoundary &&
+          dn->getFloodStatus() != tLNode::kSink )
+        dn->AddDrArea( area * mMFDFrac[j] );
+    }
+  }
+  
+  if (0) //DEBUG
+    std::cout << "DrainAreaVoronoiMFD() finished" << std::endl;
+}
 
-//    // send voronoi area for each node to the node at the other end of the
-//    // flowedge and downstream
-//    for( curnode = nodIter.FirstP(); nodIter.IsActive();
-//         curnode = nodIter.NextP() )
-//      RouteFlowAreaMultipleDirections( curnode, curnode->getVArea() );
 
-//    if( inlet.innode != 0 )
-//       RouteFlowAreaMultipleDirections( inlet.innode, inlet.inDrArea );
+/*****************************************************************************\
+ **
+ **  tStreamNet::BuildMFDRouting
+ **
+ **  Builds the cached multiple-flow-direction routing shared by
+ **  DrainAreaVoronoiMFD and RouteFlowKinWave. For each active node it
+ **  stores the receiving nodes and the fraction of outflow sent to each,
+ **  and it finds an upstream-to-downstream (topological) order of the
+ **  active nodes, so that a routing pass is one loop over mMFDOrder that
+ **  touches each link once.
+ **
+ **  The weight of a downhill, flow-allowed spoke with slope S and Voronoi
+ **  edge width W depends on the option chosen:
+ **    kMFDSteepest: all flow along the flow edge (D8-like)
+ **    kMFDQuinn:    S W (Quinn et al., 1991; also Darcy subsurface flow)
+ **    kMFDFreeman:  S^p W, with p = mdMFDExponent (after Freeman, 1991)
+ **    kMFDKinWave:  S^0.5 W (surface kinematic wave)
+ **  Flooded nodes, and nodes without a downhill spoke, send everything
+ **  along their flow edge; sink nodes get no links. For those nodes
+ **  mMFDSum is zero; otherwise it holds the unnormalized sum of weights,
+ **  which RouteFlowKinWave needs for the flow depth.
+ **    With optThroughLakes, flow passes through lakes along the flow edges
+ **  of flooded nodes, so those links count in the ordering. Each lake node
+ **  is given the level of the node its flow edges lead out to, and a node
+ **  only sends flow into a lake if it lies above that level; this keeps
+ **  lake outlets (and other low nodes) from draining back into the lake.
+ **  Without it (kinematic wave, where lakes do not pass surface flow on),
+ **  only the downhill links of unflooded nodes constrain the order.
+ **  Either way the ordering links descend in elevation or water level,
+ **  so there is no cycle to break in practice.
+ **
+ **  The order is found with Kahn's algorithm. Should the links still
+ **  contain a cycle, it is broken by releasing the first blocked node in
+ **  list order.
+ **
+ **    Assumes: slopes, flow edges and flood status are up to date
+ **    Called by: DrainAreaVoronoiMFD, RouteFlowKinWave, FlowPathLength,
+ **               RouteFlowHydrographPeak
+ **
+ \*****************************************************************************/
+void tStreamNet::BuildMFDRouting( kMFDWeight_t weights, bool optThroughLakes )
+{
+  tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() );
+  const int nactive = meshPtr->getNodeList()->getActiveSize();
+  const size_t nedges = meshPtr->getEdgeList()->getSize();
+  tLNode *cn;
+  int p, j;
+  
+  // Resize the arrays when the mesh has changed
+  if( mMFDNodes.getSize() != static_cast<size_t>(nactive) )
+  {
+    mMFDNodes.setSize( nactive );
+    mMFDOrder.setSize( nactive );
+    mMFDFirst.setSize( nactive+1 );
+    mMFDSum.setSize( nactive );
+    mMFDLevel.setSize( nactive );
+    mMFDInDegree.setSize( nactive );
+  }
+  if( mMFDRecv.getSize() != nedges )
+  {
+    mMFDRecv.setSize( nedges );
+    mMFDFrac.setSize( nedges );
+  }
+  
+  // Map node IDs to positions on the active part of the list
+  int maxid = 0;
+  for( cn=ni.FirstP(); !( ni.AtEnd() ); cn=ni.NextP() )
+    if( cn->getID() > maxid ) maxid = cn->getID();
+  if( mMFDIndexByID.getSize() != static_cast<size_t>(maxid+1) )
+    mMFDIndexByID.setSize( maxid+1 );
+  p = 0;
+  for( cn=ni.FirstP(); !( ni.AtEnd() ); cn=ni.NextP() )
+  {
+    if( ni.IsActive() )
+    {
+      mMFDNodes[p] = cn;
+      mMFDIndexByID[cn->getID()] = p++;
+    }
+    else mMFDIndexByID[cn->getID()] = -1;
+  }
+  
+  // Find the level of each node: its elevation, or for lake nodes the
+  // elevation of the node where their flow edges leave the lake.
+  // mMFDInDegree flags nodes done, mMFDOrder stacks the nodes of a path.
+  if( optThroughLakes )
+  {
+    for( p=0; p<nactive; ++p )
+      mMFDInDegree[p] = 0;
+    for( p=0; p<nactive; ++p )
+    {
+      if( mMFDInDegree[p] ) continue;
+      tLNode *en = mMFDNodes[p];
+      int q = p, nstack = 0;
+      while( q >= 0 && !mMFDInDegree[q] && nstack < nactive )
+      {
+        mMFDOrder[nstack++] = q;
+        if( en->getFloodStatus() != tLNode::kFlooded ) break;
+        en = en->getDownstrmNbr();
+        q = mMFDIndexByID[en->getID()];
+      }
+      const double level =
+        ( q >= 0 && mMFDInDegree[q] ) ? mMFDLevel[q] : en->getZ();
+      while( nstack > 0 )
+      {
+        q = mMFDOrder[--nstack];
+        mMFDLevel[q] = level;
+        mMFDInDegree[q] = 1;
+      }
+    }
+  }
+  
+  // Find receivers and weights. A node has at most one link per spoke,
+  // so there are never more links than directed edges.
+  int nlinks = 0;
+  for( p=0; p<nactive; ++p )
+  {
+    cn = mMFDNodes[p];
+    mMFDFirst[p] = nlinks;
+    mMFDSum[p] = 0.0;
+    if( weights != kMFDSteepest &&
+        cn->getFloodStatus() == tLNode::kNotFlooded )
+    {
+      tEdge *ce = cn->getEdg();
+      do
+      {
+        tLNode *dn = static_cast<tLNode *>(ce->getDestinationPtrNC());
+        if( cn->getZ() > dn->getZ() && ce->FlowAllowed() &&
+            ( !optThroughLakes ||
+              dn->getFloodStatus() != tLNode::kFlooded ||
+              cn->getZ() > mMFDLevel[mMFDIndexByID[dn->getID()]] ) )
+        {
+          double w;
+          switch( weights )
+          {
+            case kMFDQuinn:
+              w = ce->getSlope() * ce->getVEdgLen();
+              break;
+            case kMFDFreeman:
+              w = pow( ce->getSlope(), mdMFDExponent ) * ce->getVEdgLen();
+              break;
+            default:
+              w = sqrt( ce->getSlope() ) * ce->getVEdgLen();
+              break;
+          }
+          mMFDRecv[nlinks] = dn;
+          mMFDFrac[nlinks] = w;
+          mMFDSum[p] += w;
+          ++nlinks;
+        }
+        ce = ce->getCCWEdg();
+      }
+      while( ce != cn->getEdg() );
+      if( mMFDSum[p] > 0.0 )
+      {
+        for( j=mMFDFirst[p]; j<nlinks; ++j )
+          mMFDFrac[j] /= mMFDSum[p];
+      }
+      else
+      {
+        nlinks = mMFDFirst[p];
+        mMFDSum[p] = 0.0;
+      }
+    }
+    if( nlinks == mMFDFirst[p] &&
+        cn->getFloodStatus() != tLNode::kSink )
+    { // single direction: along the flow edge
+      mMFDRecv[nlinks] = cn->getDownstrmNbr();
+      mMFDFrac[nlinks] = 1.0;
+      ++nlinks;
+    }
+  }
+  mMFDFirst[nactive] = nlinks;
+  assert( static_cast<size_t>(nlinks) <= nedges );
+  
+  // Topological sort: count the links coming into each active node,
+  // then repeatedly take nodes that have no unprocessed donors left
+  for( p=0; p<nactive; ++p )
+    mMFDInDegree[p] = 0;
+  for( p=0; p<nactive; ++p )
+    if( optThroughLakes || mMFDSum[p] > 0.0 )
+      for( j=mMFDFirst[p]; j<mMFDFirst[p+1]; ++j )
+      {
+        const int q = mMFDIndexByID[mMFDRecv[j]->getID()];
+        if( q >= 0 ) ++mMFDInDegree[q];
+      }
+  int head = 0, tail = 0, blocked = 0;
+  for( p=0; p<nactive; ++p )
+    if( mMFDInDegree[p] == 0 ) mMFDOrder[tail++] = p;
+  while( head < nactive )
+  {
+    if( head == tail )
+    { // all remaining nodes are on or below a cycle: release one
+      while( mMFDInDegree[blocked] <= 0 ) ++blocked;
+      if(0) //DEBUG
+        std::cout << "BuildMFDRouting: breaking cycle at node "
+        << mMFDNodes[blocked]->getID() << std::endl;
+      mMFDInDegree[blocked] = 0;
+      mMFDOrder[tail++] = blocked;
+    }
+    p = mMFDOrder[head++];
+    if( optThroughLakes || mMFDSum[p] > 0.0 )
+      for( j=mMFDFirst[p]; j<mMFDFirst[p+1]; ++j )
+      {
+        const int q = mMFDIndexByID[mMFDRecv[j]->getID()];
+        if( q >= 0 && --mMFDInDegree[q] == 0 )
+          mMFDOrder[tail++] = q;
+      }
+  }
+  assert( tail == nactive );
+}
 
-//    if (0) //DEBUG
-//      std::cout << "DrainAreaVoronoiMFD() finished" << std::endl;
-// }
+/*****************************************************************************\
+ **
+ **  tStreamNet::LabelBasins
+ **
+ **  Splits the active nodes into outlet basins: sets of nodes whose flow
+ **  edges lead to the same outlet, which is either a node draining to the
+ **  boundary or a sink. No flow edge crosses from one basin into another,
+ **  so detachment-limited erosion can sub-step each basin on its own time
+ **  step, and basins can be eroded concurrently (see
+ **  tErosion::ErodeDetachLim).
+ **
+ **  The nodes of each basin are stored together in mBasinNodes, upstream
+ **  first. Basins are numbered in the order their outlets are met going
+ **  up the network, and mBasinRank lists them from largest to smallest
+ **  (ties by number), so a dynamic schedule deals out the big basins
+ **  first. Both orders depend only on the mesh and node list, so results
+ **  do not depend on the number of threads.
+ **
+ **    Assumes: flow edges and lakes are up to date (called by MakeFlow)
+ **    Calls: BuildMFDRouting
+ **
+ \*****************************************************************************/
+void tStreamNet::LabelBasins()
+{
+  BuildMFDRouting( kMFDSteepest, true );
+  const int nactive = static_cast<int>( mMFDNodes.getSize() );
+  int k, p, b;
+  
+  if( mBasinOfNode.getSize() != static_cast<size_t>(nactive) )
+  {
+    mBasinOfNode.setSize( nactive );
+    mBasinFirst.setSize( nactive+1 );
+    mBasinNodes.setSize( nactive );
+    mBasinRank.setSize( nactive );
+  }
+  
+  // Label from the outlets up: a node takes the basin of its receiver, or
+  // starts a new one if it drains off the mesh or has no receiver.
+  for( p=0; p<nactive; ++p ) mBasinOfNode[p] = -1;
+  miNumBasins = 0;
+  for( k=nactive-1; k>=0; --k )
+  {
+    p = mMFDOrder[k];
+    int q = -1;
+    if( mMFDFirst[p+1] > mMFDFirst[p] )
+      q = mMFDIndexByID[mMFDRecv[mMFDFirst[p]]->getID()];
+    mBasinOfNode[p] =
+      ( q >= 0 && mBasinOfNode[q] >= 0 ) ? mBasinOfNode[q] : miNumBasins++;
+  }
+  
+  // Group the nodes by basin, keeping the upstream-to-downstream order
+  // (mBasinRank serves as the fill cursor here)
+  for( b=0; b<=miNumBasins; ++b ) mBasinFirst[b] = 0;
+  for( p=0; p<nactive; ++p ) ++mBasinFirst[mBasinOfNode[p]+1];
+  for( b=0; b<miNumBasins; ++b )
+  {
+    mBasinFirst[b+1] += mBasinFirst[b];
+    mBasinRank[b] = mBasinFirst[b];
+  }
+  for( k=0; k<nactive; ++k )
+  {
+    p = mMFDOrder[k];
+    mBasinNodes[mBasinRank[mBasinOfNode[p]]++] = mMFDNodes[p];
+  }
+  
+  // Rank basins by decreasing size with a counting sort, which is stable
+  // in basin number (mMFDInDegree counts basins of each size)
+  for( k=0; k<nactive; ++k ) mMFDInDegree[k] = 0;
+  for( b=0; b<miNumBasins; ++b ) ++mMFDInDegree[getBasinSize( b )-1];
+  int offset = 0;
+  for( k=nactive-1; k>=0; --k )
+  {
+    const int count = mMFDInDegree[k];
+    mMFDInDegree[k] = offset;
+    offset += count;
+  }
+  for( b=0; b<miNumBasins; ++b )
+    mBasinRank[mMFDInDegree[getBasinSize( b )-1]++] = b;
+  
+  if(0) //DEBUG
+    std::cout << "LabelBasins: " << miNumBasins << " basins, largest "
+    << ( miNumBasins>0 ? getBasinSize( mBasinRank[0] ) : 0 ) << " nodes"
+    << std::endl;
+}
 
 /*****************************************************************************\
  **
@@ -1592,6 +1989,11 @@ void tStreamNet::DrainAreaVoronoi()
  **  Computes the longest flow path length from divide to a node, for each
  **  node on the mesh. This is used to approximate peak discharge.
  **
+ **  The nodes are visited in the upstream-to-downstream order found by
+ **  BuildMFDRouting (single flow direction), which takes one pass over the
+ **  network rather than the repeated passes of SortNodesByNetOrder.
+ **  (RouteFlowHydrographPeak does the same sweep itself.)
+ **
  \*****************************************************************************/
 void tStreamNet::FlowPathLength()
 {
@@ -1599,25 +2001,24 @@ void tStreamNet::FlowPathLength()
   tLNode * curnode,    // Pointer to the current node
   * downstreamNode;  // Pointer to current node's downstream neighbor
   double localPathLength;  // Potential flow path length to downstream nbr
+  int k;
   
-  // Get list of nodes and node iterator
-  tMesh< tLNode >::nodeListIter_t nodeIter( meshPtr->getNodeList() );
-  
-  // Sort nodes in upstream-to-downstream order
-  SortNodesByNetOrder( false );
+  // Find the upstream-to-downstream order of the nodes
+  BuildMFDRouting( kMFDSteepest, true );
+  const int nactive = static_cast<int>( mMFDNodes.getSize() );
   
   // Reset all flow path lengths to zero
-  for( curnode = nodeIter.FirstP(); nodeIter.IsActive();
-      curnode = nodeIter.NextP() )
-    curnode->setFlowPathLength( 0.0 );
+  for( k=0; k<nactive; ++k )
+    mMFDNodes[k]->setFlowPathLength( 0.0 );
   
   // Work through all active nodes, from upstream to downstream, setting
   // the flow path length of each node's downstream neighbor to the
   // maximum of (a) the current node's flow path length plus the length of
   // the flow edge, or (b) the downstream node's existing flow path length.
-  for( curnode = nodeIter.FirstP(); nodeIter.IsActive();
-      curnode = nodeIter.NextP() )
+  for( k=0; k<nactive; ++k )
   {
+    curnode = mMFDNodes[mMFDOrder[k]];
+    
     // Compute "local" flow path length to the downstream neighbor --
     // equal to flow path length at the current node plus the length of
     // the edge connecting current node to its downstream neighbor
@@ -1641,35 +2042,52 @@ void tStreamNet::FlowPathLength()
  **
  **  tStreamNet::RouteFlowHydrographPeak
  **
+ **  Computes peak discharge at each node with the hydrograph peak method:
+ **  the travel time from the divide is the longest flow path length
+ **  divided by the flow velocity, and the peak discharge is
+ **    Qp = R A Tr / ( Fhs ( Tr + Tt ) )
+ **  with runoff rate R, drainage area A, storm duration Tr, travel time Tt
+ **  and hydrograph shape factor Fhs. With orographic precipitation, each
+ **  node's local peak discharge is added to that coming from upstream.
+ **
+ **  Flow path length, travel time and discharge are all found in a single
+ **  upstream-to-downstream sweep (see BuildMFDRouting): when a node is
+ **  reached, all of its upstream neighbors have already passed on their
+ **  flow path length (and discharge), so its values are final.
  **
+ **  Modifies: node flow path length and discharge
  **
  \*****************************************************************************/
 void tStreamNet::RouteFlowHydrographPeak()
 {
   // Local variables
-  tLNode * curnode;
+  tLNode * curnode,    // Pointer to the current node
+  * downstreamNode;  // Pointer to current node's downstream neighbor
   double runoff = rainrate - infilt;
   double stormdur = stormPtr->getStormDuration();
   double travelTime,  // Travel time from divide to this point
-  Qp;               // Peak discharge
+  Qp,               // Peak discharge
+  localPathLength;  // Potential flow path length to downstream nbr
+  int k;
   
   assert( runoff >= 0.0 );
   
-  // Get iterator for list of nodes
-  tMesh< tLNode >::nodeListIter_t nodeIter( meshPtr->getNodeList() );
-  
-  
- for( curnode=nodeIter.FirstP(); nodeIter.IsActive(); curnode=nodeIter.NextP() )  
-     {
-       curnode->setDischarge( 0.0 );
-     }
-	 
-    SortNodesByNetOrder( true );   //Sort nodes uphill-to-downhill
+  // Find the upstream-to-downstream order of the nodes
+  BuildMFDRouting( kMFDSteepest, true );
+  const int nactive = static_cast<int>( mMFDNodes.getSize() );
   
+  for( k=0; k<nactive; ++k )
+  {
+    mMFDNodes[k]->setDischarge( 0.0 );
+    mMFDNodes[k]->setFlowPathLength( 0.0 );
+  }
   
-  // Set peak discharge for each node
-  for( curnode=nodeIter.FirstP(); nodeIter.IsActive(); curnode=nodeIter.NextP() )
+  // Set peak discharge for each node, and pass flow path length (and
+  // discharge) on downstream
+  for( k=0; k<nactive; ++k )
   {
+    curnode = mMFDNodes[mMFDOrder[k]];
+    downstreamNode = curnode->getDownstrmNbr();
     travelTime = curnode->getFlowPathLength() / mdFlowVelocity;
 
 
@@ -1679,7 +2097,7 @@ if (stormPtr->optOroPrecip)
 	Qp = ( (curnode->getPreci() - infilt )* curnode->getVArea() * stormdur ) /
 	( mdHydrgrphShapeFac * ( stormdur + travelTime ) );
 	   curnode->AddDischarge(Qp);
-	   curnode->getDownstrmNbr()->AddDischarge( curnode->getQ() );
+	   downstreamNode->AddDischarge( curnode->getQ() );
 }
 else
 {
@@ -1692,6 +2110,11 @@ else
 
 //////////////////////////////////////////////////////////////////////////////////	 
 
+    // Longest flow path to the downstream neighbor (see FlowPathLength)
+    localPathLength = curnode->getFlowPathLength()
+    + ( curnode->getFlowEdg() )->getLength();
+    if( localPathLength > downstreamNode->getFlowPathLength() )
+      downstreamNode->setFlowPathLength( localPathLength );
   }
   
 }
@@ -1733,62 +2156,6 @@ void tStreamNet::RouteFlowArea( tLNode *curnode, double addedArea )
     std::cout << "RouteFlowArea() finished" << std::endl;
 }
 
-/*****************************************************************************\
- **
- **  tStreamNet::RouteFlowAreaMultipleDirections
- **
- **  Starting with the current node, this routine increments
- **  the drainage area of the node and each node downstream by some portion
- **  of _addedArea_.
- **  
- **  Instead of usine tLNode::getDownstrmNbr() as an iterator for adding area 
- **  to successive downstream _single_ neighbors, use recursion of this function
- **  to send area downstream to _multiple_ neighbors. If there isn't at least one
- **  downslope neighbor, then lake filling has produced a flowedge, so send area
- **  to the single flowedge destination. Not sure this is the most efficient way to 
- **  do this in terms of CPU time, but it's simple to code!
- **  From Quinn et al., 1991.
- **  SL, 2010
- \*****************************************************************************/
-// void tStreamNet::RouteFlowAreaMultipleDirections( tLNode *curnode, double addedArea )
-// {
-//   if( curnode->getBoundaryFlag() == kNonBoundary &&
-//       curnode->getFloodStatus() != tLNode::kSink )
-//     {
-//       curnode->AddDrArea( addedArea );
-//       tSpkIter sI( curnode );
-//       double totalSlopeLengthProd=0.0;
-//       tPtrList<tLNode> downhillNbrs;
-//       tList<double> downhillSlopeLengthProds;
-//       for( tEdge *ce = sI.FirstP(); !sI.AtEnd(); ce = sI.NextP() )
-// 	if( ce->getSlope() > 0.0 && 
-// 	    ce->getDestinationPtr()->getBoundaryFlag() != kClosedBoundary )
-// 	  { // downhill to non-boundary or open boundary:
-// 	    const double edgeSlopeLengthProd = ce->getSlope() * ce->getVEdgLen();
-// 	    totalSlopeLengthProd += edgeSlopeLengthProd;
-// 	    downhillSlopeLengthProds.insertAtBack( edgeSlopeLengthProd );
-// 	    tLNode *dn = static_cast<tLNode*>( ce->getDestinationPtrNC() );
-// 	    downhillNbrs.insertAtBack( dn );
-// 	  }
-//       if( !downhillNbrs.isEmpty() )
-// 	{
-// 	  tLNode *dn=0;
-// 	  while( ( dn = downhillNbrs.removeFromFront() ) )
-// 	    {
-// 	      double localSlopeLengthProd=0.0;
-// 	      downhillSlopeLengthProds.removeFromFront( localSlopeLengthProd );
-// 	      RouteFlowAreaMultipleDirections( dn, 
-// 					       addedArea * localSlopeLengthProd 
-// 					       / totalSlopeLengthProd );
-// 	    }
-// 	}
-//       else // if no downslope neighbors, then there's still a flowedge,
-// 	// so send all the area to that node:
-// 	RouteFlowAreaMultipleDirections( curnode->getDownstrmNbr(), addedArea );
-//     }
-// }
-
-
 /*****************************************************************************\
  **
  **  tStreamNet::RouteRunoff
@@ -1891,10 +2258,10 @@ void tStreamNet::MakeFlow( double tm )
     }
   }
   
-  //    if( !optMultipleFlowDirections )
-  DrainAreaVoronoi();
-  //    else
-  //      DrainAreaVoronoiMFD();
+  if( miMFDWeights == kMFDNone )
+    DrainAreaVoronoi();
+  else
+    DrainAreaVoronoiMFD();
   
   
   // If a hydrologic parameter varies through time, update it here
@@ -1915,8 +2282,7 @@ void tStreamNet::MakeFlow( double tm )
       FlowBucket();       //   capacity; any excess contributes to runoff.
       break;
     case kHydrographPeakMethod:
-      FlowPathLength();
-      RouteFlowHydrographPeak();
+      RouteFlowHydrographPeak();  // also finds flow path lengths
       break;
     case k2DKinematicWave:
     case kSubSurf2DKinematicWave:
@@ -1927,6 +2293,9 @@ void tStreamNet::MakeFlow( double tm )
       break;
   }
   
+  // Group nodes by outlet basin for basin-parallel erosion
+  if( mbBasinParallel ) LabelBasins();
+  
   if (0) //DEBUG
     std::cout << "MakeFlow() finished" << std::endl;
 }
@@ -3128,12 +3497,15 @@ void tStreamNet::FindChanGeom()
  **    m = 0, so 1/(m+1) = 1 = mdKinWaveExp, and Kr is the inverse of the
  **    saturated hydraulic conductivity, assumed equal to the infiltration 
  **    rate.
+ **  Modified to take the node order, receivers and the flow partitioning
+ **    from BuildMFDRouting, so that each spoke is visited once per call
+ **    (instead of sorting the node list and summing over the spokes twice
+ **    at each node).
  **
  \**************************************************************************/
 void tStreamNet::RouteFlowKinWave( double rainrate_ )
 {
   tLNode * cn;
-  tEdge * ce;
   tMesh< tLNode >::nodeListIter_t niter( meshPtr->getNodeList() );
   double sum;                         // Sum used in to apportion flow
   double runoff = rainrate_;
@@ -3155,12 +3527,20 @@ void tStreamNet::RouteFlowKinWave( double rainrate_ )
       cn->setSubSurfaceDischarge( 0.0 );
   }
   
-  // Sort nodes uphill-to-downhill
-  SortNodesByNetOrder( true );
+  // Find receivers, flow partitioning and upstream-to-downstream order.
+  // Flow is apportioned among downhill neighbors according to slope and
+  // Voronoi edge width: sqrt of slope for surface flow, slope for
+  // subsurface (Darcy) flow.
+  BuildMFDRouting( miOptFlowgen == k2DKinematicWave ? kMFDKinWave : kMFDQuinn,
+                   false );
+  const int nactive = static_cast<int>( mMFDNodes.getSize() );
   
   // Route flow and compute water depths
-  for( cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
+  for( int k=0; k<nactive; ++k )
   {
+    const int p = mMFDOrder[k];
+    cn = mMFDNodes[p];
+    
     // Add local runoff to total incoming discharge
     if( miOptFlowgen == k2DKinematicWave )
       cn->AddDischarge( runoff * cn->getVArea() );
@@ -3169,25 +3549,8 @@ void tStreamNet::RouteFlowKinWave( double rainrate_ )
     
     if( cn->getFloodStatus() == tLNode::kNotFlooded )
     {
-      // Flow is apportioned among downhill neighbors according to
-      // slope and Voronoi edge width, so first we perform the summation
-      // of the product of Voronoi edge width and sqrt of slope in each dir
-      //if( cn->getQ()>50000.0 ) cn->TellAll();
-      sum = 0.0;
-      ce = cn->getEdg();
-      do
-      {
-        if( cn->getZ() > ce->getDestinationPtr()->getZ() &&
-           ce->FlowAllowed() )
-        {
-          if( miOptFlowgen == k2DKinematicWave )
-            sum += ce->getVEdgLen() * sqrt( ce->getSlope() );
-          else if( miOptFlowgen == kSubSurf2DKinematicWave )
-            sum += ce->getVEdgLen() * ce->getSlope();
-        }
-        ce = ce->getCCWEdg();
-      }
-      while( ce!=cn->getEdg() );
+      // sum of the product of Voronoi edge width and (sqrt of) slope
+      sum = mMFDSum[p];
       
       //std::cout << "Q: " << cn->getQ() << " sum: " << sum << " DEPTH: " << cn->getHydrDepth() << std::endl;
       //          assert( cn->getQ()>0.0 );
@@ -3195,22 +3558,14 @@ void tStreamNet::RouteFlowKinWave( double rainrate_ )
       if( sum>0.0 )
       {
         // Route flow downhill
-        ce = cn->getEdg();
-        do
+        for( int j=mMFDFirst[p]; j<mMFDFirst[p+1]; ++j )
         {
-          tLNode * dn = static_cast<tLNode *>(ce->getDestinationPtrNC());
-          if( cn->getZ() > dn->getZ() && ce->FlowAllowed() )
-          {
-            if( miOptFlowgen == k2DKinematicWave )
-              dn->AddDischarge( cn->getQ()
-                               * (sqrt(ce->getSlope())*ce->getVEdgLen())/sum );
-            else if( miOptFlowgen == kSubSurf2DKinematicWave )
-              dn->addSubSurfaceDischarge( cn->getSubSurfaceDischarge()
-                                         * ce->getSlope() * ce->getVEdgLen() / sum );
-          }
-          ce = ce->getCCWEdg();
+          if( miOptFlowgen == k2DKinematicWave )
+            mMFDRecv[j]->AddDischarge( cn->getQ() * mMFDFrac[j] );
+          else if( miOptFlowgen == kSubSurf2DKinematicWave )
+            mMFDRecv[j]->addSubSurfaceDischarge( cn->getSubSurfaceDischarge()
+                                                * mMFDFrac[j] );
         }
-        while( ce!=cn->getEdg() );
         // Compute the flow depth
         if( miOptFlowgen == k2DKinematicWave )
           cn->setHydrDepth( pow( cn->getQ() * mdKinWaveRough / sum,
@@ -3268,21 +3623,41 @@ void tStreamNet::RouteFlowKinWave( double rainrate_ )
  **      Calls: tMesh::AddNodesAround
  **      Created: GT 2/2000
  **      Modifications:
+ **       - nodes are checked in passes; the nodes flagged in a pass are
+ **         densified in one bulk insertion, and the next pass checks the
+ **         new nodes, which inherit their parent's drainage area, and
+ **         the flagged nodes within two spokes of another, whose Voronoi
+ **         area the insertion reduces (tMesh::DeferNearbyCentres)
  **
  \*****************************************************************************/
 void tStreamNet::DensifyMeshDrArea( double time )
 {
   tMesh< tLNode >::nodeListIter_t niter( meshPtr->getNodeList() );  // node list iter.
   tLNode *cn;              // Current node being checked
+  tPtrList< tLNode > checkList;  // Nodes to check in this pass
+  tPtrList< tLNode > denseList;  // Nodes to densify around
   
-  // Check all active nodes
+  // Check all active nodes, then the nodes added around them
   for( cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
+    checkList.insertAtBack( cn );
+  while( checkList.getSize() > 0 )
   {
-    // If drainage area and Voronoi area exceed thresholds, add new nodes
-    if( cn->getDrArea()>mdMeshAdaptMinArea
-       && cn->getVArea() > mdMeshAdaptMaxVArea )
+    tPtrListIter< tLNode > checkIter( checkList );
+    for( cn=checkIter.FirstP(); !(checkIter.AtEnd()); cn=checkIter.NextP() )
+    {
+      // If drainage area and Voronoi area exceed thresholds, add new nodes
+      if( cn->getDrArea()>mdMeshAdaptMinArea
+         && cn->getVArea() > mdMeshAdaptMaxVArea )
+        denseList.insertAtBack( cn );
+    }
+    checkList.Flush();
+    if( denseList.getSize() > 0 )
     {
-      meshPtr->AddNodesAround( cn, time );
+      // Nodes near another one being densified are checked again, with
+      // the area they are left with, along with the nodes just added
+      meshPtr->DeferNearbyCentres( denseList, checkList );
+      meshPtr->AddNodesAround( denseList, time, &checkList );
+      denseList.Flush();
     }
   }
   
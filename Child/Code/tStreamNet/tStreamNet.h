@@ -201,6 +201,10 @@ inline tParkerChannels::tParkerChannels( const tParkerChannels &orig )
 **     Reference: Finnegan, N. J., Roe, G., Montgomery, D. R., and Hallet, B.,
 **     2005, Controls on the channel width of rivers:  Implications for
 **     modelling fluvial incision of bedrock, Geology, v. 33, p229-232.
+**   - revived DrainAreaVoronoiMFD on a cached multiple-flow-direction
+**     routing (BuildMFDRouting), also used by RouteFlowKinWave
+**   - added LabelBasins, which groups the active nodes by outlet basin
+**     for basin-parallel fluvial erosion (OPT_BASIN_PARALLEL)
 **
 */
 /**************************************************************************/
@@ -218,6 +222,13 @@ public:
       kHydrographPeakMethod = 5,  // Option for hydrograph peak method
       kSubSurf2DKinematicWave = 6 // Option for kinematic wave with Darcy's Law
     } kFlowGen_t;
+    typedef enum {
+      kMFDNone = 0,      // Single flow direction (DrainAreaVoronoi)
+      kMFDSteepest = 1,  // D8-like: all flow along the flow edge
+      kMFDQuinn = 2,     // Slope x Voronoi edge width (Quinn et al., 1991)
+      kMFDFreeman = 3,   // Slope^p x Voronoi edge width (after Freeman, 1991)
+      kMFDKinWave = 4    // Slope^0.5 x Voronoi edge width (kinematic wave)
+    } kMFDWeight_t;
 
     tStreamNet( tMesh< tLNode > &, tStorm &, const tInputFile & );
   tStreamNet( const tStreamNet&, tStorm *, tMesh<tLNode>* );
@@ -261,7 +272,7 @@ public:
     void ReInitFlowDirs();
     void FlowDirs();
     void DrainAreaVoronoi();
-//   void DrainAreaVoronoiMFD();
+    void DrainAreaVoronoiMFD();
     void FlowPathLength();
     void RouteFlowHydrographPeak();
     void MakeFlow( double tm );
@@ -284,6 +295,16 @@ public:
     void ShowMeanderNeighbours(int) const;
   // find streamlines from points specified in input file:
   void FindStreamLines( const tInputFile &, tPtrList< tLNode > &, bool lvFEs = false );
+  // outlet-basin decomposition (see LabelBasins):
+  void LabelBasins();
+  bool getBasinParallelOpt() const;
+  // drainage-area densification thresholds (both zero if option is off):
+  double getMeshAdaptMinArea() const;
+  double getMeshAdaptMaxVArea() const;
+  int getNumBasins() const;
+  int getBasinByRank( int ) const;   // rank 0 is the largest basin
+  int getBasinSize( int ) const;
+  tLNode * const *getBasinNodes( int ) const;  // upstream first
 
 protected:
     tLNode *BuildLakeList( tPtrList< tLNode > &, tLNode *);
@@ -291,8 +312,11 @@ protected:
     inline static void RouteFlowArea( tLNode *, double );
     inline static void RouteRunoff( tLNode *, double, double );
     static void RouteError( tLNode * ) ATTRIBUTE_NORETURN;
-//   void RouteFlowAreaMultipleDirections( tLNode*, double );
+    void BuildMFDRouting( kMFDWeight_t, bool );
+    static kMFDWeight_t IntToMFDWeight( int );
         bool FlowDirBreaksMeanderChannel( tLNode *, tEdge * ) const;
+    void BuildEdgePairIndex();
+    void BuildActiveNodeIndex();
 
     typedef enum {
       kRegimeChannels = 1,
@@ -330,7 +354,27 @@ protected:
     double mdHydrgrphShapeFac;  // "Fhs" for hydrograph peak method
     double mdFlowVelocity;      // Runoff velocity for computing travel time
   bool optVariableTransmissivity; // option for soil depth-dependent transmissivity
-//   bool optMultipleFlowDirections; // option for flow routing via MFD algorithm
+  kMFDWeight_t miMFDWeights; // option for flow routing via MFD algorithm
+  double mdMFDExponent;       // slope exponent for Freeman MFD weights
+  bool mbBasinParallel;       // option for basin-parallel fluvial erosion
+  int miNumBasins;            // number of outlet basins found by LabelBasins
+  // Cached MFD routing, rebuilt by BuildMFDRouting:
+  tArray< tLNode * > mMFDNodes;    // active nodes, in list order
+  tArray< int > mMFDOrder;         // positions in mMFDNodes, upstream first
+  tArray< int > mMFDFirst;         // offset of each node's first link
+  tArray< tLNode * > mMFDRecv;     // receiving node of each link
+  tArray< double > mMFDFrac;       // fraction of outflow sent along link
+  tArray< double > mMFDSum;        // unnormalized weight sum at each node
+  tArray< double > mMFDLevel;      // elevation, or water level of lakes
+  tArray< int > mMFDInDegree;      // scratch for the topological sort
+  tArray< int > mMFDIndexByID;     // node ID -> position (-1 if boundary)
+  // Outlet basins, rebuilt by LabelBasins:
+  tArray< int > mBasinOfNode;      // basin of each position in mMFDNodes
+  tArray< int > mBasinFirst;       // offset of each basin's first node
+  tArray< tLNode * > mBasinNodes;  // active nodes grouped by basin
+  tArray< int > mBasinRank;        // basins in order of decreasing size
+  tArray< tEdge * > mEdgePairIndex;     // first edge of each pair (CalcSlopes)
+  tArray< tLNode * > mActiveNodeIndex;  // active nodes in list order (FlowDirs)
 
   void DebugShowNbrs( tLNode * theNode ) const;  // debugging function shows neighbor nodes
 };
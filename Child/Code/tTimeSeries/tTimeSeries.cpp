@@ -1129,13 +1129,17 @@ void tInlineTimeSeriesImp::TellAll() const
 \*********************************************************************/
 
 tTimeSeries::tTimeSeries() :
-  ts(0)
+  ts(0),
+  tagImp(-1)
 {}
 
 // copy constructor (SL, 10/10)
 tTimeSeries::tTimeSeries(tTimeSeries const &orig) 
-  : tagImp(orig.tagImp)
+  : ts(0),
+    tagImp(orig.tagImp)
 {
+  if( orig.ts == 0 )  // not configured: nothing to copy
+    return;
   if( tagImp == 0 )
     ts = new tConstantTimeSeriesImp();
   else if( tagImp == 1 )
@@ -69,7 +69,9 @@ tUplift::tUplift_t tUplift::DecodeType(int type){
 }
 
 tUplift::tUplift( const tInputFile &infile ) :
-duration(0.)
+duration(0.),
+cumulativeSlip(0.), warpElapsedTime(0.), foldNose(0.),
+fbfElapsedTime(-1.), fbf2ElapsedTime(-1.)
 {
   int typeCode_;
   
@@ -431,12 +433,11 @@ void tUplift::StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime )
   tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
   slipRate = slipRate_ts.calc( currentTime );
   double slip = slipRate*delt;
-  static double cumulative_displacement = 0;
   
-  cumulative_displacement += slip;
+  cumulativeSlip += slip;
   
   if(1) std::cout << "StrikeSlip by " << slip << "; cum displacement is " 
-    << cumulative_displacement << std::endl;
+    << cumulativeSlip << std::endl;
   
   if ( 1 )
   {
@@ -469,7 +470,7 @@ void tUplift::StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime )
     // If we're not wrapping, we'll convert any nodes "exposed to the edge" by
     // strike-slip motion to open boundaries
     if( !opt_wrap_boundaries_ 
-       && (cn->getX()+slip) > (positionParam1 + cumulative_displacement)
+       && (cn->getX()+slip) > (positionParam1 + cumulativeSlip)
        && cn->getY() > (faultPosition-buffer_width_) 
        && cn->getY() < (faultPosition+buffer_width_) 
        && cn->getBoundaryFlag()==kNonBoundary )
@@ -657,6 +658,10 @@ void tUplift::StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime )
         std::cout << " flow status for edge " << ce->getID() << " changing from " << ce->getBoundaryFlag() << std::endl;
       ce->setFlowAllowed( ce->getOriginPtr(), ce->getDestinationPtr() );    
     }
+
+    // Nodes have been moved and re-flagged behind the mesh's back, so the
+    // next UpdateMesh must recompute the geometry everywhere.
+    mp->InvalidateGeometry();
     
   }
   
@@ -732,7 +737,6 @@ void tUplift::CosineWarp2D( tMesh<tLNode> *mp, double delt )
    tLNode *cn;
    tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
    double uprate;
-   static double elapsedTime = 0;
 
    // For each node, the uplift rate is the uplift rate constant ("rate") times
    // the cosine function in the y- and (if lateral y-directed tightening has
@@ -742,7 +746,7 @@ void tUplift::CosineWarp2D( tMesh<tLNode> *mp, double delt )
    // by the parameter "foldParam2"; if uplift is positive, the rate is
    // multiplied by this factor. "positionParam1" is used to store the
    // x-location of the anticline.
-   if( elapsedTime >= deformStartTime1 )
+   if( warpElapsedTime >= deformStartTime1 )
    {
       for( cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
       {
@@ -763,7 +767,7 @@ void tUplift::CosineWarp2D( tMesh<tLNode> *mp, double delt )
          cn->ChangeZ( uprate*delt );
       }
    }
-   elapsedTime += delt;
+   warpElapsedTime += delt;
 
    // The "tightening" of the folds through time is simulated by
    // progressively decreasing the fold wavelength. (Here the variable
@@ -801,7 +805,7 @@ void tUplift::CosineWarp2D( tMesh<tLNode> *mp, double delt )
 **           delt -- duration of uplift
 **
 \************************************************************************/
-void tUplift::PropagatingFold( tMesh<tLNode> *mp, double delt ) const
+void tUplift::PropagatingFold( tMesh<tLNode> *mp, double delt )
 {
    assert( mp!=0 );
    tLNode *cn;
@@ -809,7 +813,6 @@ void tUplift::PropagatingFold( tMesh<tLNode> *mp, double delt ) const
    double uprate;
    const double northEdge = foldParam2 + 0.5*foldParam;
    const double southEdge = northEdge - foldParam;
-   static double foldNose = 0.0;
    const double twoPiLam = TWOPI/foldParam;
 
    // Advance the fold nose
@@ -909,13 +912,14 @@ void tUplift::TwoSideDifferential( tMesh<tLNode> *mp, double delt ) const
 **           delt -- duration of uplift
 **
 \************************************************************************/
-void tUplift::FaultBendFold( tMesh<tLNode> *mp, double delt ) const
+void tUplift::FaultBendFold( tMesh<tLNode> *mp, double delt )
 {
    assert( mp!=0 );
    tLNode *cn;
    tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
    double slip = slipRate*delt;
-   static double elapsedTime = delt;
+   if( fbfElapsedTime<0.0 ) fbfElapsedTime = delt;
+   const double elapsedTime = fbfElapsedTime;
 
 
    for( cn=ni.FirstP(); !(ni.AtEnd()); cn=ni.NextP() )
@@ -1035,13 +1039,14 @@ void tUplift::FaultBendFold( tMesh<tLNode> *mp, double delt ) const
 **           delt -- duration of uplift
 **
 \************************************************************************/
-void tUplift::FaultBendFold2( tMesh<tLNode> *mp, double delt ) const
+void tUplift::FaultBendFold2( tMesh<tLNode> *mp, double delt )
 {
    assert( mp!=0 );
    tLNode *cn;
    tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
    double slip = slipRate*delt;
-   static double elapsedTime = delt;
+   if( fbf2ElapsedTime<0.0 ) fbf2ElapsedTime = delt;
+   const double elapsedTime = fbf2ElapsedTime;
    /* Redefinitions so faultPosition and flatDepth are measured with respect
    to where fault intersects z=0 (faultPosition) and depth below z=0. */
    //double faultPosition = faultPosition - meanElevation/tan(rampDip);
@@ -1078,7 +1083,7 @@ void tUplift::FaultBendFold2( tMesh<tLNode> *mp, double delt ) const
       }
    }
 
-   elapsedTime += delt;
+   fbf2ElapsedTime += delt;
 }
 
 
@@ -1415,9 +1420,9 @@ void tUplift::MovingBlock( tMesh<tLNode> *mp, double delt, double currentTime )
  \************************************************************************/
 void tUplift::MovingSinusoid( tMesh<tLNode> *mp, double delt, double currentTime )
 {
-  static double two_pi_over_lamx = 2.0*3.14159265/blockWidth_x;
-  static double two_pi_over_lamy = 2.0*3.14159265/blockWidth_y;
-  static double three_halves_pi = 1.5*3.14159265;
+  const double two_pi_over_lamx = 2.0*3.14159265/blockWidth_x;
+  const double two_pi_over_lamy = 2.0*3.14159265/blockWidth_y;
+  const double three_halves_pi = 1.5*3.14159265;
 	assert( mp!=0 );
 	tLNode *cn;
 	tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
@@ -1570,3 +1575,22 @@ double tUplift::getRate() const
    return rate;
 }
 
+/************************************************************************\
+**
+**  tUplift::setRate
+**
+**  Replaces the uplift rate UPRATE by a constant value. Only the rate
+**  itself changes: quantities that the constructor derived from it for
+**  some uplift types (e.g. the second rate of type 9) are not redone.
+**
+**  Created: 10/2026
+**
+\************************************************************************/
+void tUplift::setRate( double val )
+{
+   std::stringstream ss;
+   ss << val;
+   rate_ts.reconfigure( ss.str().c_str() );
+   rate = val;
+}
+
@@ -49,16 +49,17 @@ public:
   void DoUplift( tMesh<tLNode> *mp, double delt, double current_time );
   double getDuration() const;
   double getRate() const;
+  void setRate( double );
 private:
   void UpliftUniform( tMesh<tLNode> *mp, double delt, double currentTime );
   void BlockUplift( tMesh<tLNode> *mp, double delt, double currentTime );
   void StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime );
   void FoldPropErf( tMesh<tLNode> *mp, double delt );
   void CosineWarp2D( tMesh<tLNode> *mp, double delt );
-  void PropagatingFold( tMesh<tLNode> *mp, double delt ) const;
+  void PropagatingFold( tMesh<tLNode> *mp, double delt );
   void TwoSideDifferential( tMesh<tLNode> *mp, double delt ) const;
-  void FaultBendFold( tMesh<tLNode> *mp, double delt ) const;
-  void FaultBendFold2( tMesh<tLNode> *mp, double delt ) const;
+  void FaultBendFold( tMesh<tLNode> *mp, double delt );
+  void FaultBendFold2( tMesh<tLNode> *mp, double delt );
   void NormalFaultTiltAccel( tMesh<tLNode> *mp, double delt, double currentTime ) const;
   void LinearUplift( tMesh<tLNode> *mp, double delt );
   void PowerLawUplift( tMesh<tLNode> *mp, double delt );
@@ -143,6 +144,12 @@ private:
   double bump_amplitude_;  // Max amplitude of Gaussian bump (m)
   double bump_wavelength_squared_; // Square of wavelength of Gaussian bump (m)
   bool create_initial_bump_;  // Option to create an initial bump in topo
+  // State carried from one call to the next by some uplift functions
+  double cumulativeSlip;     // StrikeSlip: total displacement so far
+  double warpElapsedTime;    // CosineWarp2D: time since first call
+  double foldNose;           // PropagatingFold: x position of fold nose
+  double fbfElapsedTime;     // FaultBendFold: set to delt at first call
+  double fbf2ElapsedTime;    // FaultBendFold2: delt + time since 1st call
   
 private:
   tUplift();
@@ -151,16 +158,31 @@ private:
 inline tUplift::tUplift( const tUplift& orig )
 : typeCode(orig.typeCode), duration(orig.duration), rate(orig.rate), rate2(orig.rate2), 
 rate_ts(orig.rate_ts), faultPosition(orig.faultPosition), 
-positionParam1(orig.positionParam1), slipRate(orig.slipRate), foldParam(orig.foldParam), 
+faultPosition_ts(orig.faultPosition_ts),
+positionParam1(orig.positionParam1), slipRate(orig.slipRate), 
+opt_wrap_boundaries_(orig.opt_wrap_boundaries_), buffer_width_(orig.buffer_width_),
+slipRate_ts(orig.slipRate_ts), blockMoveRate(orig.blockMoveRate),
+blockEdge_x(orig.blockEdge_x), blockWidth_x(orig.blockWidth_x),
+blockEdge_y(orig.blockEdge_y), blockWidth_y(orig.blockWidth_y),
+foldParam(orig.foldParam), foldParam2(orig.foldParam2),
 deformStartTime1(orig.deformStartTime1), flatDepth(orig.flatDepth), rampDip(orig.rampDip), 
 kinkDip(orig.kinkDip), upperKinkDip(orig.upperKinkDip), meanElevation(orig.meanElevation), 
 decayParam(orig.decayParam), timeParam1(orig.timeParam1), width(orig.width), 
 dupdy(orig.dupdy), optincrease(orig.optincrease), miNumUpliftMaps(orig.miNumUpliftMaps), 
 mUpliftMapTimes(orig.mUpliftMapTimes), miCurUpliftMapNum(orig.miCurUpliftMapNum), 
 mdNextUpliftMapTime(orig.mdNextUpliftMapTime), 
-mdUpliftFrontGradient(orig.mdUpliftFrontGradient)
+mdUpliftFrontGradient(orig.mdUpliftFrontGradient),
+tilt_rate_x_(orig.tilt_rate_x_), tilt_rate_y_(orig.tilt_rate_y_),
+bump_migration_rate_(orig.bump_migration_rate_),
+bump_initial_position_(orig.bump_initial_position_),
+bump_amplitude_(orig.bump_amplitude_),
+bump_wavelength_squared_(orig.bump_wavelength_squared_),
+create_initial_bump_(orig.create_initial_bump_),
+cumulativeSlip(orig.cumulativeSlip), warpElapsedTime(orig.warpElapsedTime),
+foldNose(orig.foldNose), fbfElapsedTime(orig.fbfElapsedTime),
+fbf2ElapsedTime(orig.fbf2ElapsedTime)
 {
-  strcat( mUpliftMapFilename, orig.mUpliftMapFilename );
+  strcpy( mUpliftMapFilename, orig.mUpliftMapFilename );
 }
 #endif
 
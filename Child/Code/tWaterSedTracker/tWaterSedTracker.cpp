@@ -46,7 +46,8 @@ using namespace std;
 /**************************************************************************/
 tWaterSedTracker::
 tWaterSedTracker()
-  : active(false)
+  : active(false), output_format_(kFilePerNode), flush_interval_(1),
+    number_of_records_(0)
 {
   if(0) cout << "tWaterSedTracker constructor" << endl;
 }
@@ -54,7 +55,9 @@ tWaterSedTracker()
 // copy constructor for copying to new mesh:
 tWaterSedTracker::tWaterSedTracker( const tWaterSedTracker& orig,
 				    tMesh<tLNode>* nPtr )
-  : tracking_node_list_( orig.tracking_node_list_.size() )
+  : tracking_node_list_( orig.tracking_node_list_.size() ),
+    active( orig.active ), output_format_( orig.output_format_ ),
+    flush_interval_( orig.flush_interval_ ), number_of_records_( 0 )
 {
   output_file_base_name_ = orig.output_file_base_name_;
   const int number_of_nodes_to_track = tracking_node_list_.size();
@@ -69,7 +72,8 @@ tWaterSedTracker::tWaterSedTracker( const tWaterSedTracker& orig,
 /**
 **  Destructor
 **
-**  Closes and deletes any remaining ofstream objects.
+**  Writes any buffered records, and closes and deletes any remaining
+**  ofstream objects.
 */
 /**************************************************************************/
 tWaterSedTracker::
@@ -77,11 +81,7 @@ tWaterSedTracker::
 {
   if(0) cout << "tWaterSedTracker destructor" << endl;
   
-  for( unsigned i=0; i<output_file_list_.size(); i++ )
-  {
-    output_file_list_[i]->close();
-    delete output_file_list_[i];
-  }
+  CloseOutputFiles();
 }
   
 
@@ -111,6 +111,12 @@ InitializeFromInputFile( tInputFile &inputFile, tMesh<tLNode> *mesh /*, tErosion
   vector<double> x( number_of_nodes_to_track );   // List of tracking node x-coords
   vector<double> y( number_of_nodes_to_track );   // List of tracking node y-coords
   input_string = inputFile.ReadString( "COORDS_OF_NODES_TO_TRACK" );
+  output_format_ = inputFile.ReadInt( "WATER_SED_OUTPUT_FORMAT", false );
+  if( output_format_ < kFilePerNode || output_format_ > kBinaryTable )
+    ReportFatalError( "WATER_SED_OUTPUT_FORMAT must be 0 (a file per node), "
+                      "1 (CSV table) or 2 (binary table)." );
+  flush_interval_ = inputFile.ReadInt( "WATER_SED_FLUSH_INTERVAL", false );
+  if( flush_interval_ < 1 ) flush_interval_ = 1;
   input_stringstream.str( input_string );   // use the stringstream to get #s from the input line
   for( int i=0; i<number_of_nodes_to_track; i++ )
   {
@@ -142,6 +148,10 @@ InitializeFromInputFile( tInputFile &inputFile, tMesh<tLNode> *mesh /*, tErosion
     }
   }
   
+  // Start the first period from zero at each tracked node
+  for( int i=0; i<number_of_nodes_to_track; i++ )
+    tracking_node_list_[i]->ResetCumulativeSedXportVolume();
+  
   // Remember the base name for the sed/water flux output files
   output_file_base_name_ = inputFile.ReadString( "OUTFILENAME" );
   
@@ -170,18 +180,15 @@ ResetListOfNodesToTrack( vector<tLNode *> list_of_nodes_to_track,
 {
   if(1) cout << "tWaterSedTracker::ResetListOfNodesToTrack" << endl;
   
+  // Write what was buffered for the old list, and release memory used to
+  // store ofstreams
+  CloseOutputFiles();
+  
   // Store a copy of the tracking list (uses vector's overloaded assignment operator)
   tracking_node_list_ = list_of_nodes_to_track;
-  
-  // Release memory used to store ofstreams
-  for( unsigned i=0; i<output_file_list_.size(); i++ )
-  {
-    output_file_list_[i]->close();
-    delete output_file_list_[i];
-  }
-    
-  // Reset output file list
-  output_file_base_name_.resize( 0 );
+  active = true;
+  for( unsigned i=0; i<tracking_node_list_.size(); i++ )
+    tracking_node_list_[i]->ResetCumulativeSedXportVolume();
   
   // Create and open output files
   CreateAndOpenWaterAndSedimentOutputFiles( list_of_nodes_to_track.size(),
@@ -192,25 +199,87 @@ ResetListOfNodesToTrack( vector<tLNode *> list_of_nodes_to_track,
 
 /**************************************************************************/
 /**
+**  WriteAndResetWaterSedTimeseriesData
+**
+**  Adds the record of a storm to the buffer, writing the buffer when it
+**  is full, and zeroes the cumulative sediment volumes.
 */
 /**************************************************************************/
 void tWaterSedTracker::
 WriteAndResetWaterSedTimeseriesData( double period_starting_time, 
                                      double period_duration )
 {
-  if(1) cout << "tWaterSedTracker::WriteAndResetWaterSedTimeseriesData" << endl;
+  if(0) cout << "tWaterSedTracker::WriteAndResetWaterSedTimeseriesData" << endl;
   
+  const size_t record_size = 2 + 2*tracking_node_list_.size();
+  records_.resize( ( number_of_records_ + 1 ) * record_size );
+  double *record = &records_[number_of_records_ * record_size];
+  record[0] = period_starting_time;
+  record[1] = period_duration;
   for( unsigned i=0; i<tracking_node_list_.size(); i++ )
   {
     assert( tracking_node_list_[i] != NULL );
-    assert( output_file_list_[i]->good() );
     tLNode * cn = tracking_node_list_[i];
-    *output_file_list_[i] << period_starting_time << " " << period_duration
-        << " " << cn->getQ()
-        << " " << cn->getCumulativeSedXportVolume()/period_duration << endl;
+    record[2+2*i] = cn->getQ();
+    record[3+2*i] = cn->getCumulativeSedXportVolume()/period_duration;
     cn->ResetCumulativeSedXportVolume();
   }
+  if( ++number_of_records_ >= flush_interval_ )
+    FlushRecords();
+}
 
+/**************************************************************************/
+/**
+**  FlushRecords
+**
+**  Writes the buffered records in the chosen format, and empties the
+**  buffer (keeping its memory).
+*/
+/**************************************************************************/
+void tWaterSedTracker::
+FlushRecords()
+{
+  if( number_of_records_ == 0 || output_file_list_.empty() ) return;
+  
+  const size_t number_of_nodes = tracking_node_list_.size();
+  const size_t record_size = 2 + 2*number_of_nodes;
+  switch( output_format_ )
+  {
+    case kFilePerNode:
+      for( unsigned i=0; i<number_of_nodes; i++ )
+      {
+        assert( output_file_list_[i]->good() );
+        ofstream &file = *output_file_list_[i];
+        for( int r=0; r<number_of_records_; r++ )
+        {
+          const double *record = &records_[r * record_size];
+          file << record[0] << " " << record[1] << " " << record[2+2*i]
+               << " " << record[3+2*i] << '\n';
+        }
+        file.flush();
+      }
+      break;
+    case kCSVTable:
+    {
+      ofstream &file = *output_file_list_[0];
+      for( int r=0; r<number_of_records_; r++ )
+      {
+        const double *record = &records_[r * record_size];
+        file << record[0];
+        for( size_t c=1; c<record_size; c++ )
+          file << ',' << record[c];
+        file << '\n';
+      }
+      file.flush();
+      break;
+    }
+    case kBinaryTable:
+      output_file_list_[0]->write( reinterpret_cast<const char *>( &records_[0] ),
+                                   number_of_records_ * record_size * sizeof(double) );
+      output_file_list_[0]->flush();
+      break;
+  }
+  number_of_records_ = 0;
 }
 
 /**************************************************************************/
@@ -220,7 +289,7 @@ WriteAndResetWaterSedTimeseriesData( double period_starting_time,
 void tWaterSedTracker::
 AddSedVolumesAtTrackingNodes( double flux_duration )
 {
-  if(1) cout << "tWaterSedTracker::AddSedVolumesAtTrackingNodes" << endl;
+  if(0) cout << "tWaterSedTracker::AddSedVolumesAtTrackingNodes" << endl;
 
   for( unsigned i=0; i<tracking_node_list_.size(); i++ )
   {
@@ -236,6 +305,61 @@ void tWaterSedTracker::
 CreateAndOpenWaterAndSedimentOutputFiles( int number_of_nodes_to_track,
                                           double current_time )
 {
+  if( output_format_ != kFilePerNode )
+  {
+    stringstream ss;
+    ss << output_file_base_name_ << "_t" << current_time << ".water_sed"
+       << ( output_format_ == kCSVTable ? ".csv" : ".bin" );
+    ofstream *table = new ofstream( ss.str().c_str(),
+                                    output_format_ == kCSVTable ? ios::out :
+                                    ios::out | ios::binary );
+    output_file_list_.push_back( table );
+    if( !table->good() )
+    {
+      cout << "When trying to create output file '" << ss.str() << endl;
+      ReportFatalError( "Unable to create file." );
+    }
+    if( output_format_ == kCSVTable )
+    {
+      table->precision( 12 );
+      for( int i=0; i<number_of_nodes_to_track; i++ )
+        *table << "# NODE " << tracking_node_list_[i]->getPermID()
+               << " X " << tracking_node_list_[i]->getX()
+               << " Y " << tracking_node_list_[i]->getY() << '\n';
+      *table << "Time_start,Duration";
+      for( int i=0; i<number_of_nodes_to_track; i++ )
+        *table << ",Discharge_" << tracking_node_list_[i]->getPermID()
+               << "(m3/yr),Sedflux_" << tracking_node_list_[i]->getPermID()
+               << "(m3/yr)";
+      *table << endl;
+    }
+    else
+    {
+      const int version = 1;
+      table->write( "CHWATSED", 8 );
+      table->write( reinterpret_cast<const char *>( &version ), sizeof(int) );
+      table->write( reinterpret_cast<const char *>( &number_of_nodes_to_track ),
+                    sizeof(int) );
+      for( int i=0; i<number_of_nodes_to_track; i++ )
+      {
+        const int id = tracking_node_list_[i]->getPermID();
+        table->write( reinterpret_cast<const char *>( &id ), sizeof(int) );
+      }
+      for( int i=0; i<number_of_nodes_to_track; i++ )
+      {
+        const double x = tracking_node_list_[i]->getX();
+        table->write( reinterpret_cast<const char *>( &x ), sizeof(double) );
+      }
+      for( int i=0; i<number_of_nodes_to_track; i++ )
+      {
+        const double y = tracking_node_list_[i]->getY();
+        table->write( reinterpret_cast<const char *>( &y ), sizeof(double) );
+      }
+      table->flush();
+    }
+    return;
+  }
+  
   for( int i=0; i<number_of_nodes_to_track; i++ )
   {
     stringstream ss;
@@ -257,3 +381,22 @@ CreateAndOpenWaterAndSedimentOutputFiles( int number_of_nodes_to_track,
   }
 }
 
+/**************************************************************************/
+/**
+**  CloseOutputFiles
+**
+**  Writes any buffered records, then closes and deletes the ofstreams.
+*/
+/**************************************************************************/
+void tWaterSedTracker::
+CloseOutputFiles()
+{
+  FlushRecords();
+  number_of_records_ = 0;
+  for( unsigned i=0; i<output_file_list_.size(); i++ )
+  {
+    output_file_list_[i]->close();
+    delete output_file_list_[i];
+  }
+  output_file_list_.clear();
+}
@@ -21,6 +21,26 @@
 **  along the shoreline, and tell CHILD to keep track of water and sediment
 **  discharge at those nodes.
 **
+**  Each storm gives one record: its start time and duration, then the
+**  discharge and mean sediment flux at each tracked node, in the order
+**  of the tracking list. Records are kept in a buffer of
+**  WATER_SED_FLUSH_INTERVAL records (default 1) and written together
+**  when it is full, when the list of nodes changes, and when the tracker
+**  is destroyed (or when FlushRecords is called). WATER_SED_OUTPUT_FORMAT
+**  says how they are written:
+**    0 (default): one text file per node, <name>_node<id>_t<t>.water_sed,
+**       as before;
+**    1: one comma-separated table, <name>_t<t>.water_sed.csv, with a
+**       comment line per node ("# NODE id X x Y y"), a header line and
+**       a line per record;
+**    2: one binary table, <name>_t<t>.water_sed.bin (native byte order):
+**       char[8] "CHWATSED", int version (1), int nNodes, int id[nNodes],
+**       double x[nNodes], double y[nNodes], then each record as
+**       2+2*nNodes doubles, to the end of the file.
+**  With a table, tracking many nodes costs one line or one write per
+**  record, rather than a write to each of as many open files.
+**  (Table output and buffering added 10/2026.)
+**
 **  For information regarding this program, please contact Greg Tucker at:
 **
 **     Cooperative Institute for Research in Environmental Sciences (CIRES)
@@ -69,17 +89,28 @@ public:
   // Add to the total cumulative volume at each node
   void AddSedVolumesAtTrackingNodes( double flux_duration );
   
+  // Write the records kept in the buffer
+  void FlushRecords();
+  
   inline bool& IsActive() {return active;}
 
+  // Ways of writing the records (WATER_SED_OUTPUT_FORMAT)
+  enum { kFilePerNode = 0, kCSVTable = 1, kBinaryTable = 2 };
+
 private:
 
   void CreateAndOpenWaterAndSedimentOutputFiles( int number_of_nodes_to_track,
                                                  double current_time );
+  void CloseOutputFiles();
 
   std::vector<tLNode *> tracking_node_list_;  // List of ptrs to nodes to track
   std::vector<ofstream *> output_file_list_;  // List of ptrs to file I/O
   std::string output_file_base_name_;         // Base name for output files
   bool active;
+  int output_format_;              // kFilePerNode, kCSVTable or kBinaryTable
+  int flush_interval_;             // records kept before they are written
+  std::vector<double> records_;    // buffered records, 2+2*nodes each
+  int number_of_records_;          // records now in records_
 };
 
 
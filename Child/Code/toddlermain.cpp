@@ -251,7 +251,7 @@ OptTSOutput." );
       if( time.CheckOutputTime() )
           output.WriteOutput( time.getCurrentTime() );
 
-      if( output.OptTSOutput() ) output.WriteTSOutput();
+      if( output.OptTSOutput() ) output.WriteTSOutput( time.getCurrentTime() );
 
       /* IN PROGRESS
       switch( optTSOutput ){
@@ -20,7 +20,15 @@ OBJECTS = \
  tStratGrid.$(OBJEXT) tOption.$(OBJEXT) \
  tTimeSeries.$(OBJEXT) ParamMesh_t.$(OBJEXT) TipperTriangulator.$(OBJEXT) \
  TipperTriangulatorError.$(OBJEXT) tWaterSedTracker.$(OBJEXT) \
- tLithologyManager.$(OBJEXT)
+ tLithologyManager.$(OBJEXT) \
+ tBasinFarm.$(OBJEXT) \
+ tMemoryFootprint.$(OBJEXT) \
+ tInSituAnalysis.$(OBJEXT) \
+ tEnsemble.$(OBJEXT) \
+ tStratBinary.$(OBJEXT) \
+ tFieldCodec.$(OBJEXT) \
+ tOutputSelection.$(OBJEXT) \
+ tStateHash.$(OBJEXT)
 
 all : $(EXENAME)
 .PHONY : all clean
@@ -37,12 +45,24 @@ meshElements.$(OBJEXT): $(PT)/MeshElements/meshElements.cpp
 mathutil.$(OBJEXT): $(PT)/Mathutil/mathutil.cpp
 	$(CXX) $(CFLAGS) $(PT)/Mathutil/mathutil.cpp
 
+tBasinFarm.$(OBJEXT): $(PT)/tBasinFarm/tBasinFarm.cpp
+	$(CXX) $(CFLAGS) $(PT)/tBasinFarm/tBasinFarm.cpp
+
+tEnsemble.$(OBJEXT): $(PT)/tEnsemble/tEnsemble.cpp
+	$(CXX) $(CFLAGS) $(PT)/tEnsemble/tEnsemble.cpp
+
+tFieldCodec.$(OBJEXT): $(PT)/tFieldCodec/tFieldCodec.cpp
+	$(CXX) $(CFLAGS) $(PT)/tFieldCodec/tFieldCodec.cpp
+
 tIDGenerator.$(OBJEXT): $(PT)/tIDGenerator/tIDGenerator.cpp
 	$(CXX) $(CFLAGS) $(PT)/tIDGenerator/tIDGenerator.cpp
 
 tInputFile.$(OBJEXT): $(PT)/tInputFile/tInputFile.cpp
 	$(CXX) $(CFLAGS) $(PT)/tInputFile/tInputFile.cpp
 
+tInSituAnalysis.$(OBJEXT): $(PT)/tInSituAnalysis/tInSituAnalysis.cpp
+	$(CXX) $(CFLAGS) $(PT)/tInSituAnalysis/tInSituAnalysis.cpp
+
 tLNode.$(OBJEXT): $(PT)/tLNode/tLNode.cpp
 	$(CXX) $(CFLAGS) $(PT)/tLNode/tLNode.cpp
 
@@ -52,18 +72,30 @@ tListInputData.$(OBJEXT): $(PT)/tListInputData/tListInputData.cpp
 tLithologyManager.$(OBJEXT): $(PT)/tLithologyManager/tLithologyManager.cpp
 	$(CXX) $(CFLAGS) $(PT)/tLithologyManager/tLithologyManager.cpp
 
+tMemoryFootprint.$(OBJEXT): $(PT)/tMemoryFootprint/tMemoryFootprint.cpp
+	$(CXX) $(CFLAGS) $(PT)/tMemoryFootprint/tMemoryFootprint.cpp
+
 tOption.$(OBJEXT): $(PT)/tOption/tOption.cpp
 	$(CXX) $(CFLAGS) $(PT)/tOption/tOption.cpp
 
+tOutputSelection.$(OBJEXT): $(PT)/tOutputSelection/tOutputSelection.cpp
+	$(CXX) $(CFLAGS) $(PT)/tOutputSelection/tOutputSelection.cpp
+
 tRunTimer.$(OBJEXT): $(PT)/tRunTimer/tRunTimer.cpp
 	$(CXX) $(CFLAGS) $(PT)/tRunTimer/tRunTimer.cpp
 
+tStateHash.$(OBJEXT): $(PT)/tStateHash/tStateHash.cpp
+	$(CXX) $(CFLAGS) $(PT)/tStateHash/tStateHash.cpp
+
 tStorm.$(OBJEXT): $(PT)/tStorm/tStorm.cpp
 	$(CXX) $(CFLAGS) $(PT)/tStorm/tStorm.cpp
 
 tStratGrid.$(OBJEXT):  $(PT)/tStratGrid/tStratGrid.cpp
 	$(CXX) $(CFLAGS) $(PT)/tStratGrid/tStratGrid.cpp
 
+tStratBinary.$(OBJEXT): $(PT)/tStratBinary/tStratBinary.cpp
+	$(CXX) $(CFLAGS) $(PT)/tStratBinary/tStratBinary.cpp
+
 tTimeSeries.$(OBJEXT): $(PT)/tTimeSeries/tTimeSeries.cpp
 	$(CXX) $(CFLAGS) $(PT)/tTimeSeries/tTimeSeries.cpp
 
@@ -130,6 +162,9 @@ HFILES = \
 	$(PT)/Geometry/geometry.h \
 	$(PT)/Inclusions.h \
 	$(PT)/Mathutil/mathutil.h \
+	$(PT)/tBasinFarm/tBasinFarm.h \
+	$(PT)/tEnsemble/tEnsemble.h \
+	$(PT)/tFieldCodec/tFieldCodec.h \
 	$(PT)/tIDGenerator/tIDGenerator.h \
 	$(PT)/MeshElements/meshElements.h \
 	$(PT)/Predicates/predicates.h \
@@ -142,12 +177,14 @@ HFILES = \
 	$(PT)/tEolian/tEolian.h \
 	$(PT)/tFloodplain/tFloodplain.h \
 	$(PT)/tInputFile/tInputFile.h \
+	$(PT)/tInSituAnalysis/tInSituAnalysis.h \
 	$(PT)/tLNode/tLNode.h \
 	$(PT)/tList/tList.h \
 	$(PT)/tList/tListFwd.h \
 	$(PT)/tListInputData/tListInputData.h \
 	$(PT)/tLithologyManager/tLithologyManager.h \
 	$(PT)/tMatrix/tMatrix.h \
+	$(PT)/tMemoryFootprint/tMemoryFootprint.h \
 	$(PT)/tMesh/ParamMesh_t.h \
 	$(PT)/tMesh/TipperTriangulator.h \
 	$(PT)/tMesh/heapsort.h \
@@ -158,9 +195,12 @@ HFILES = \
 	$(PT)/tOption/tOption.h \
 	$(PT)/tOutput/tOutput.cpp \
 	$(PT)/tOutput/tOutput.h \
+	$(PT)/tOutputSelection/tOutputSelection.h \
 	$(PT)/tPtrList/tPtrList.h \
 	$(PT)/tRunTimer/tRunTimer.h \
+	$(PT)/tStateHash/tStateHash.h \
 	$(PT)/tStorm/tStorm.h \
+	$(PT)/tStratBinary/tStratBinary.h \
 	$(PT)/tStratGrid/tStratGrid.h \
 	$(PT)/tStreamMeander/meander.h \
 	$(PT)/tStreamMeander/tStreamMeander.h \
@@ -172,6 +212,10 @@ HFILES = \
 	$(PT)/trapfpe.h
 
 ParamMesh_t.$(OBJEXT): $(HFILES)
+tBasinFarm.$(OBJEXT): $(HFILES)
+tEnsemble.$(OBJEXT): $(HFILES)
+tFieldCodec.$(OBJEXT): $(HFILES)
+tInSituAnalysis.$(OBJEXT): $(HFILES)
 TipperTriangulator.$(OBJEXT) : $(HFILES)
 TipperTriangulatorError.$(OBJEXT) : $(HFILES)
 childInterface.$(OBJEXT) : $(HFILES)
@@ -189,9 +233,13 @@ tIDGenerator.$(OBJEXT): $(HFILES)
 tInputFile.$(OBJEXT): $(HFILES)
 tLNode.$(OBJEXT): $(HFILES)
 tListInputData.$(OBJEXT): $(HFILES)
+tMemoryFootprint.$(OBJEXT): $(HFILES)
 tOption.$(OBJEXT): $(HFILES)
+tOutputSelection.$(OBJEXT): $(HFILES)
 tRunTimer.$(OBJEXT): $(HFILES)
+tStateHash.$(OBJEXT): $(HFILES)
 tStorm.$(OBJEXT) : $(HFILES)
+tStratBinary.$(OBJEXT): $(HFILES)
 tStratGrid.$(OBJEXT) : $(HFILES)
 tStreamMeander.$(OBJEXT): $(HFILES)
 tStreamNet.$(OBJEXT): $(HFILES)